@@ -88,6 +88,11 @@ Json Json::make_array()
     return result;
 }
 
+bool Json::is_array() const
+{
+    return impl->is_array();
+}
+
 size_t Json::size() const 
 {
     return impl->size();
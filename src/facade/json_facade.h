@@ -146,6 +146,12 @@ public:
      */
     static Json make_array();
 
+    /**
+     * @brief Checks whether this value is a JSON array.
+     * @return true if the value is an array; otherwise false.
+     */
+    bool is_array() const;
+
     /**
      * @brief Gets the size of a JSON array.
      * @return The number of elements in the array.
@@ -34,6 +34,64 @@ HMM_Vec3 MathFacade::transform_vec3(const HMM_Mat4& matrix, const HMM_Vec3& vec)
     return HMM_V3(temp.X, temp.Y, temp.Z);
 }
 
+DualQuaternion MathFacade::to_dual_quaternion(const HMM_Mat4& matrix)
+{
+    // Strip scale from the rotation columns so the conversion sees an orthonormal basis
+    HMM_Mat4 rotation = matrix;
+    for (int c = 0; c < 3; c++)
+    {
+        const float length = HMM_LenV3(rotation.Columns[c].XYZ);
+        if (length > 0.f)
+        {
+            rotation.Columns[c] = HMM_DivV4F(rotation.Columns[c], length);
+        }
+    }
+
+    DualQuaternion result;
+    result.real = HMM_NormQ(HMM_M4ToQ_RH(rotation));
+
+    // dual = 0.5 * (t, 0) * real
+    const HMM_Vec3 translation = matrix.Columns[3].XYZ;
+    const HMM_Quat pure_translation = HMM_Q(translation.X, translation.Y, translation.Z, 0.f);
+    result.dual = HMM_MulQF(HMM_MulQ(pure_translation, result.real), .5f);
+
+    return result;
+}
+
+AffineMatrix MathFacade::to_affine(const HMM_Mat4& matrix)
+{
+    // HMM_Mat4 is column-major: Elements[c][r] is row r of column c
+    AffineMatrix result;
+    for (int r = 0; r < 3; r++)
+    {
+        for (int c = 0; c < 4; c++)
+        {
+            result.rows[r][c] = matrix.Elements[c][r];
+        }
+    }
+    return result;
+}
+
+HMM_Vec3 MathFacade::transform_vec3(const DualQuaternion& dual_quat, const HMM_Vec3& vec)
+{
+    const HMM_Vec3 real_xyz = dual_quat.real.XYZ;
+    const HMM_Vec3 dual_xyz = dual_quat.dual.XYZ;
+    const float real_w = dual_quat.real.W;
+    const float dual_w = dual_quat.dual.W;
+
+    // Rotate: p + 2 * r x (r x p + w * p)
+    const HMM_Vec3 inner = HMM_AddV3(HMM_Cross(real_xyz, vec), HMM_MulV3F(vec, real_w));
+    const HMM_Vec3 rotated = HMM_AddV3(vec, HMM_MulV3F(HMM_Cross(real_xyz, inner), 2.f));
+
+    // Translate: 2 * (w_r * d - w_d * r + r x d)
+    const HMM_Vec3 translation = HMM_MulV3F(
+        HMM_AddV3(HMM_SubV3(HMM_MulV3F(dual_xyz, real_w), HMM_MulV3F(real_xyz, dual_w)),
+                  HMM_Cross(real_xyz, dual_xyz)),
+        2.f);
+
+    return HMM_AddV3(rotated, translation);
+}
+
 HMM_Mat4 MathFacade::rotateX(float radians)
 {
     return HMM_Rotate_RH(radians, HMM_V3(1.f, 0.f, 0.f));
@@ -59,6 +117,45 @@ HMM_Mat4 MathFacade::translate(float x, float y, float z)
     return HMM_Translate(HMM_V3(x, y, z));
 }
 
+HMM_Mat4 MathFacade::compose(const HMM_Vec3& translation, const HMM_Quat& rotation,
+                             const HMM_Vec3& scale)
+{
+    // Scaling the rotation's columns is R * S; the translation column completes T * R * S
+    HMM_Mat4 result = HMM_QToM4(rotation);
+    for (int c = 0; c < 3; c++)
+    {
+        result.Columns[c] = HMM_MulV4F(result.Columns[c], scale.Elements[c]);
+    }
+    result.Columns[3] = HMM_V4(translation.X, translation.Y, translation.Z, 1.f);
+    return result;
+}
+
+void MathFacade::decompose(const HMM_Mat4& matrix, HMM_Vec3& translation, HMM_Quat& rotation,
+                           HMM_Vec3& scale)
+{
+    translation = matrix.Columns[3].XYZ;
+
+    // The column lengths are the scale; what remains of the columns is the rotation
+    HMM_Mat4 basis = HMM_M4D(1.f);
+    for (int c = 0; c < 3; c++)
+    {
+        scale.Elements[c] = HMM_LenV3(matrix.Columns[c].XYZ);
+        if (scale.Elements[c] > 0.f)
+        {
+            basis.Columns[c].XYZ = HMM_DivV3F(matrix.Columns[c].XYZ, scale.Elements[c]);
+        }
+    }
+
+    // A mirrored basis isn't a rotation; fold the reflection into the X scale
+    if (HMM_DotV3(HMM_Cross(basis.Columns[0].XYZ, basis.Columns[1].XYZ), basis.Columns[2].XYZ) < 0.f)
+    {
+        scale.X = -scale.X;
+        basis.Columns[0].XYZ = HMM_MulV3F(basis.Columns[0].XYZ, -1.f);
+    }
+
+    rotation = HMM_NormQ(HMM_M4ToQ_RH(basis));
+}
+
 float MathFacade::to_radians(float degrees)
 {
     // HandmadeMath might have a function for this, but if not:
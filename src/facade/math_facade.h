@@ -4,6 +4,39 @@
 #include "handmade_math/handmade_math.h"
 
 
+/**
+ * @brief A unit dual quaternion encoding a rigid transform (rotation + translation).
+ *
+ * Laid out as 8 consecutive floats (real x, y, z, w, then dual x, y, z, w), which is
+ * half the footprint of a 4x4 matrix and what the dual quaternion skinning kernels read.
+ */
+struct DualQuaternion
+{
+    /**
+     * @brief The rotation part.
+     */
+    HMM_Quat real;
+
+    /**
+     * @brief The translation part, equal to 0.5 * (t, 0) * real.
+     */
+    HMM_Quat dual;
+};
+
+/**
+ * @brief An affine transform stored as the top three rows of a 4x4 matrix, row-major.
+ *
+ * The implicit bottom row is (0, 0, 0, 1), so each matrix is 48 bytes instead of 64,
+ * and each row is a contiguous (x, y, z, translation) vector.
+ */
+struct AffineMatrix
+{
+    /**
+     * @brief rows[r][c] is element (row r, column c) of the full matrix.
+     */
+    float rows[3][4];
+};
+
 /**
  * @brief A Facade class to simplify interactions with the HandmadeMath library.
  */
@@ -53,6 +86,29 @@ public:
      */
     static HMM_Vec3 transform_vec3(const HMM_Mat4& matrix, const HMM_Vec3& vec);
 
+    /**
+     * @brief Converts the rigid part of a 4x4 matrix to a unit dual quaternion.
+     * @param matrix The transformation matrix. Scale is removed from the rotation
+     *               columns and shear is ignored, as dual quaternions cannot encode them.
+     * @return The equivalent unit dual quaternion.
+     */
+    static DualQuaternion to_dual_quaternion(const HMM_Mat4& matrix);
+
+    /**
+     * @brief Converts the top three rows of a 4x4 matrix to a row-major affine matrix.
+     * @param matrix The transformation matrix (its bottom row is dropped).
+     * @return The equivalent affine matrix.
+     */
+    static AffineMatrix to_affine(const HMM_Mat4& matrix);
+
+    /**
+     * @brief Transforms a 3D point using a unit dual quaternion.
+     * @param dual_quat The rigid transformation (must be normalized).
+     * @param vec       The 3D point to transform.
+     * @return The transformed point.
+     */
+    static HMM_Vec3 transform_vec3(const DualQuaternion& dual_quat, const HMM_Vec3& vec);
+
     /**
      * @brief Creates a rotation around the X axis.
      * @param radians Angle in radians.
@@ -92,6 +148,27 @@ public:
      */
     static HMM_Mat4 translate(float x, float y, float z);
 
+    /**
+     * @brief Builds the matrix T * R * S of a translation, rotation and scale.
+     * @param translation The translation.
+     * @param rotation The rotation (normalized before use).
+     * @param scale The scale along each axis, applied first.
+     * @return The composed transformation matrix.
+     */
+    static HMM_Mat4 compose(const HMM_Vec3& translation, const HMM_Quat& rotation,
+                            const HMM_Vec3& scale);
+
+    /**
+     * @brief Splits an affine matrix into the translation, rotation and scale compose() takes.
+     * @param matrix The transformation matrix. Shear and the bottom row are ignored, and a
+     *               mirroring matrix gets a negative X scale.
+     * @param translation Receives the translation.
+     * @param rotation Receives the normalized rotation.
+     * @param scale Receives the scale along each axis.
+     */
+    static void decompose(const HMM_Mat4& matrix, HMM_Vec3& translation, HMM_Quat& rotation,
+                          HMM_Vec3& scale);
+
     /**
      * @brief Converts an angle from degrees to radians.
      * @param degrees Angle in degrees.
@@ -0,0 +1,116 @@
+#pragma once
+
+// Local application imports
+#include "kernel/skinning_kernels.h"
+
+
+/**
+ * @brief Per-instruction-set kernel implementations, each defined in its own translation unit.
+ *
+ * Only the dispatcher should include this header: calling into a variant the CPU
+ * does not support is undefined behaviour, so everyone else goes through
+ * SkinningKernels::get_kernels().
+ *
+ * Each translation unit instantiates its kernel templates (per influence encoding and
+ * influence count) with internal linkage and publishes them through a constant-initialized
+ * KernelTable, so no code compiled for a newer CPU runs during static initialization.
+ */
+namespace SkinningKernels {
+
+/**
+ * @brief Number of floats in one AffineMatrix (3 rows of 4, row-major).
+ */
+constexpr int FLOATS_PER_AFFINE_MATRIX = 12;
+
+/**
+ * @brief Number of floats in one DualQuaternion (real x, y, z, w, then dual x, y, z, w).
+ */
+constexpr int FLOATS_PER_DUAL_QUATERNION = 8;
+
+/**
+ * @brief The stream element types of an influence encoding, as the kernels read them.
+ *
+ * A stored weight times WEIGHT_SCALE is the float weight (float weights are used as-is).
+ */
+template <InfluenceEncoding ENCODING>
+struct EncodingTraits;
+
+template <>
+struct EncodingTraits<InfluenceEncoding::Float32>
+{
+    using JointId = int32_t;
+    using Weight = float;
+    static constexpr float WEIGHT_SCALE = 1.f;
+};
+
+template <>
+struct EncodingTraits<InfluenceEncoding::Joint16Unorm16>
+{
+    using JointId = uint16_t;
+    using Weight = uint16_t;
+    static constexpr float WEIGHT_SCALE = InfluenceStreams::UNORM16_SCALE;
+};
+
+template <>
+struct EncodingTraits<InfluenceEncoding::Joint16Unorm8>
+{
+    using JointId = uint16_t;
+    using Weight = uint8_t;
+    static constexpr float WEIGHT_SCALE = InfluenceStreams::UNORM8_SCALE;
+};
+
+template <>
+struct EncodingTraits<InfluenceEncoding::Joint8Unorm16>
+{
+    using JointId = uint8_t;
+    using Weight = uint16_t;
+    static constexpr float WEIGHT_SCALE = InfluenceStreams::UNORM16_SCALE;
+};
+
+template <>
+struct EncodingTraits<InfluenceEncoding::Joint8Unorm8>
+{
+    using JointId = uint8_t;
+    using Weight = uint8_t;
+    static constexpr float WEIGHT_SCALE = InfluenceStreams::UNORM8_SCALE;
+};
+
+/**
+ * @brief Influence count template argument selecting the loop over each chunk's own count.
+ */
+constexpr size_t VARIABLE_INFLUENCES = 0;
+
+// Asks the compiler to fully unroll influence loops whose trip count is a template argument
+#if defined(__clang__)
+#define SKINNING_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__)
+#define SKINNING_UNROLL _Pragma("GCC unroll 8")
+#else
+#define SKINNING_UNROLL
+#endif
+
+// Portable C++ kernels (always available)
+namespace Scalar {
+extern const KernelTable KERNELS;
+} // namespace Scalar
+
+#if defined(MESHSKINNER_X86_KERNELS)
+
+// Kernels compiled with SSE4.1 enabled
+namespace SSE4 {
+extern const KernelTable KERNELS;
+} // namespace SSE4
+
+// Kernels compiled with AVX2 and FMA enabled
+namespace AVX2 {
+extern const KernelTable KERNELS;
+} // namespace AVX2
+
+// Kernels compiled with AVX-512F enabled
+namespace AVX512 {
+extern const KernelTable KERNELS;
+} // namespace AVX512
+
+#endif
+
+} // namespace SkinningKernels
@@ -0,0 +1,265 @@
+#include "kernel/kernel_variants.h"
+
+// Standard library imports
+#include <type_traits>
+
+// Platform-specific includes
+#include <immintrin.h>
+
+
+namespace SkinningKernels {
+namespace AVX512 {
+
+namespace {
+
+// Gathers one palette float for 16 lanes at once (offsets are pre-scaled by the entry size)
+inline __m512 gather_element(const float* palette, __m512i entry_offsets, int element)
+{
+    return _mm512_i32gather_ps(entry_offsets, palette + element, sizeof(float));
+}
+
+// Loads the joint IDs of 16 lanes, widening compact ones to 32 bits
+template <InfluenceEncoding ENCODING>
+inline __m512i load_joint_ids(const void* joint_ids, size_t index)
+{
+    using JointId = typename EncodingTraits<ENCODING>::JointId;
+    const JointId* source = static_cast<const JointId*>(joint_ids) + index;
+    if constexpr (sizeof(JointId) == 1)
+        return _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+    else if constexpr (sizeof(JointId) == 2)
+        return _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)));
+    else
+        return _mm512_load_si512(source);
+}
+
+// Loads the weights of 16 lanes, widening and dequantizing unorm weights
+template <InfluenceEncoding ENCODING>
+inline __m512 load_weights(const void* weights, size_t index)
+{
+    using Weight = typename EncodingTraits<ENCODING>::Weight;
+    const Weight* source = static_cast<const Weight*>(weights) + index;
+    if constexpr (std::is_same_v<Weight, float>)
+    {
+        return _mm512_load_ps(source);
+    }
+    else
+    {
+        const __m512i widened = sizeof(Weight) == 1 ?
+            _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source))) :
+            _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)));
+        return _mm512_mul_ps(_mm512_cvtepi32_ps(widened),
+                             _mm512_set1_ps(EncodingTraits<ENCODING>::WEIGHT_SCALE));
+    }
+}
+
+template <InfluenceEncoding ENCODING, size_t INFLUENCES>
+void skin_linear_blend(const SkinningJob& job, size_t begin, size_t end)
+{
+    const float* palette = reinterpret_cast<const float*>(job.affine_palette);
+
+    // Offsets of the x, y and z rows, and of columns 1-3, within a row-major 3x4 entry
+    constexpr int X = 0;
+    constexpr int Y = 4;
+    constexpr int Z = 8;
+    constexpr int C1 = 1;
+    constexpr int C2 = 2;
+    constexpr int C3 = 3;
+    const __m512i entry_size = _mm512_set1_epi32(FLOATS_PER_AFFINE_MATRIX);
+
+    for (size_t i = begin; i < end; i += 16)
+    {
+        const __m512 px = _mm512_load_ps(job.rest_x + i);
+        const __m512 py = _mm512_load_ps(job.rest_y + i);
+        const __m512 pz = _mm512_load_ps(job.rest_z + i);
+
+        __m512 acc_x = _mm512_setzero_ps();
+        __m512 acc_y = _mm512_setzero_ps();
+        __m512 acc_z = _mm512_setzero_ps();
+
+        // Influences are stored per chunk of vertices, one slot after another
+        const size_t chunk = i / InfluenceStreams::CHUNK_SIZE;
+        const size_t influence_count =
+            INFLUENCES == VARIABLE_INFLUENCES ? job.chunk_influences[chunk] : INFLUENCES;
+        const size_t influence_base = job.chunk_offsets[chunk] + i % InfluenceStreams::CHUNK_SIZE;
+
+        SKINNING_UNROLL
+        for (size_t slot = 0; slot < influence_count; slot++)
+        {
+            const size_t stream_index = influence_base + slot * InfluenceStreams::CHUNK_SIZE;
+            const __m512i joint_ids = load_joint_ids<ENCODING>(job.joint_ids, stream_index);
+            const __m512 weight = load_weights<ENCODING>(job.weights, stream_index);
+            const __m512i offsets = _mm512_mullo_epi32(joint_ids, entry_size);
+
+            // Transform the rest position by each lane's own skinning matrix
+            const __m512 tx = _mm512_fmadd_ps(gather_element(palette, offsets, X), px,
+                              _mm512_fmadd_ps(gather_element(palette, offsets, X + C1), py,
+                              _mm512_fmadd_ps(gather_element(palette, offsets, X + C2), pz,
+                                              gather_element(palette, offsets, X + C3))));
+            const __m512 ty = _mm512_fmadd_ps(gather_element(palette, offsets, Y), px,
+                              _mm512_fmadd_ps(gather_element(palette, offsets, Y + C1), py,
+                              _mm512_fmadd_ps(gather_element(palette, offsets, Y + C2), pz,
+                                              gather_element(palette, offsets, Y + C3))));
+            const __m512 tz = _mm512_fmadd_ps(gather_element(palette, offsets, Z), px,
+                              _mm512_fmadd_ps(gather_element(palette, offsets, Z + C1), py,
+                              _mm512_fmadd_ps(gather_element(palette, offsets, Z + C2), pz,
+                                              gather_element(palette, offsets, Z + C3))));
+
+            // Weighted sum
+            acc_x = _mm512_fmadd_ps(weight, tx, acc_x);
+            acc_y = _mm512_fmadd_ps(weight, ty, acc_y);
+            acc_z = _mm512_fmadd_ps(weight, tz, acc_z);
+        }
+
+        _mm512_store_ps(job.skinned_x + i, acc_x);
+        _mm512_store_ps(job.skinned_y + i, acc_y);
+        _mm512_store_ps(job.skinned_z + i, acc_z);
+    }
+}
+
+template <InfluenceEncoding ENCODING, size_t INFLUENCES>
+void skin_dual_quaternion(const SkinningJob& job, size_t begin, size_t end)
+{
+    const float* palette = reinterpret_cast<const float*>(job.dual_quaternion_palette);
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 two = _mm512_set1_ps(2.f);
+
+    for (size_t i = begin; i < end; i += 16)
+    {
+        const __m512 px = _mm512_load_ps(job.rest_x + i);
+        const __m512 py = _mm512_load_ps(job.rest_y + i);
+        const __m512 pz = _mm512_load_ps(job.rest_z + i);
+
+        __m512 rx = zero, ry = zero, rz = zero, rw = zero;
+        __m512 dx = zero, dy = zero, dz = zero, dw = zero;
+
+        // Influences are stored per chunk of vertices, one slot after another
+        const size_t chunk = i / InfluenceStreams::CHUNK_SIZE;
+        const size_t influence_count =
+            INFLUENCES == VARIABLE_INFLUENCES ? job.chunk_influences[chunk] : INFLUENCES;
+        const size_t influence_base = job.chunk_offsets[chunk] + i % InfluenceStreams::CHUNK_SIZE;
+
+        SKINNING_UNROLL
+        for (size_t slot = 0; slot < influence_count; slot++)
+        {
+            const size_t stream_index = influence_base + slot * InfluenceStreams::CHUNK_SIZE;
+            const __m512i joint_ids = load_joint_ids<ENCODING>(job.joint_ids, stream_index);
+            __m512 weight = load_weights<ENCODING>(job.weights, stream_index);
+            const __m512i offsets = _mm512_slli_epi32(joint_ids, 3);
+
+            // 8 floats per influence, versus 12 for the matrix kernel
+            const __m512 qrx = gather_element(palette, offsets, 0);
+            const __m512 qry = gather_element(palette, offsets, 1);
+            const __m512 qrz = gather_element(palette, offsets, 2);
+            const __m512 qrw = gather_element(palette, offsets, 3);
+            const __m512 qdx = gather_element(palette, offsets, 4);
+            const __m512 qdy = gather_element(palette, offsets, 5);
+            const __m512 qdz = gather_element(palette, offsets, 6);
+            const __m512 qdw = gather_element(palette, offsets, 7);
+
+            // Antipodality: flip quaternions lying in the opposite hemisphere of the blend
+            const __m512 dot = _mm512_fmadd_ps(rx, qrx, _mm512_fmadd_ps(ry, qry,
+                              _mm512_fmadd_ps(rz, qrz, _mm512_mul_ps(rw, qrw))));
+            weight = _mm512_mask_sub_ps(weight, _mm512_cmp_ps_mask(dot, zero, _CMP_LT_OQ),
+                                        zero, weight);
+
+            rx = _mm512_fmadd_ps(weight, qrx, rx);
+            ry = _mm512_fmadd_ps(weight, qry, ry);
+            rz = _mm512_fmadd_ps(weight, qrz, rz);
+            rw = _mm512_fmadd_ps(weight, qrw, rw);
+            dx = _mm512_fmadd_ps(weight, qdx, dx);
+            dy = _mm512_fmadd_ps(weight, qdy, dy);
+            dz = _mm512_fmadd_ps(weight, qdz, dz);
+            dw = _mm512_fmadd_ps(weight, qdw, dw);
+        }
+
+        // Normalize by the length of the real part (guarding vertices with no influences)
+        const __m512 length_sq = _mm512_fmadd_ps(rx, rx, _mm512_fmadd_ps(ry, ry,
+                                _mm512_fmadd_ps(rz, rz, _mm512_mul_ps(rw, rw))));
+        const __m512 inv_length = _mm512_div_ps(_mm512_set1_ps(1.f),
+            _mm512_sqrt_ps(_mm512_max_ps(length_sq, _mm512_set1_ps(1e-12f))));
+        rx = _mm512_mul_ps(rx, inv_length); ry = _mm512_mul_ps(ry, inv_length);
+        rz = _mm512_mul_ps(rz, inv_length); rw = _mm512_mul_ps(rw, inv_length);
+        dx = _mm512_mul_ps(dx, inv_length); dy = _mm512_mul_ps(dy, inv_length);
+        dz = _mm512_mul_ps(dz, inv_length); dw = _mm512_mul_ps(dw, inv_length);
+
+        // Rotation: p + 2 * r x (r x p + w * p)
+        const __m512 ix = _mm512_fmadd_ps(rw, px, _mm512_fmsub_ps(ry, pz, _mm512_mul_ps(rz, py)));
+        const __m512 iy = _mm512_fmadd_ps(rw, py, _mm512_fmsub_ps(rz, px, _mm512_mul_ps(rx, pz)));
+        const __m512 iz = _mm512_fmadd_ps(rw, pz, _mm512_fmsub_ps(rx, py, _mm512_mul_ps(ry, px)));
+        const __m512 cx = _mm512_fmsub_ps(ry, iz, _mm512_mul_ps(rz, iy));
+        const __m512 cy = _mm512_fmsub_ps(rz, ix, _mm512_mul_ps(rx, iz));
+        const __m512 cz = _mm512_fmsub_ps(rx, iy, _mm512_mul_ps(ry, ix));
+
+        // Translation: 2 * (w_r * d - w_d * r + r x d)
+        const __m512 tx = _mm512_add_ps(_mm512_fmsub_ps(rw, dx, _mm512_mul_ps(dw, rx)),
+                                        _mm512_fmsub_ps(ry, dz, _mm512_mul_ps(rz, dy)));
+        const __m512 ty = _mm512_add_ps(_mm512_fmsub_ps(rw, dy, _mm512_mul_ps(dw, ry)),
+                                        _mm512_fmsub_ps(rz, dx, _mm512_mul_ps(rx, dz)));
+        const __m512 tz = _mm512_add_ps(_mm512_fmsub_ps(rw, dz, _mm512_mul_ps(dw, rz)),
+                                        _mm512_fmsub_ps(rx, dy, _mm512_mul_ps(ry, dx)));
+
+        _mm512_store_ps(job.skinned_x + i, _mm512_fmadd_ps(two, _mm512_add_ps(cx, tx), px));
+        _mm512_store_ps(job.skinned_y + i, _mm512_fmadd_ps(two, _mm512_add_ps(cy, ty), py));
+        _mm512_store_ps(job.skinned_z + i, _mm512_fmadd_ps(two, _mm512_add_ps(cz, tz), pz));
+    }
+}
+
+void multiply_matrices(const HMM_Mat4* lhs, const HMM_Mat4* rhs, HMM_Mat4* result, size_t count)
+{
+    for (size_t m = 0; m < count; m++)
+    {
+        // Each lhs column is replicated into all four 128-bit lanes
+        const __m512 l0 = _mm512_broadcast_f32x4(_mm_loadu_ps(lhs[m].Elements[0]));
+        const __m512 l1 = _mm512_broadcast_f32x4(_mm_loadu_ps(lhs[m].Elements[1]));
+        const __m512 l2 = _mm512_broadcast_f32x4(_mm_loadu_ps(lhs[m].Elements[2]));
+        const __m512 l3 = _mm512_broadcast_f32x4(_mm_loadu_ps(lhs[m].Elements[3]));
+
+        // The whole product in one register: lane c splats the elements of rhs column c
+        const __m512 columns = _mm512_loadu_ps(rhs[m].Elements[0]);
+        const __m512 product =
+            _mm512_fmadd_ps(l0, _mm512_permute_ps(columns, 0x00),
+            _mm512_fmadd_ps(l1, _mm512_permute_ps(columns, 0x55),
+            _mm512_fmadd_ps(l2, _mm512_permute_ps(columns, 0xAA),
+                            _mm512_mul_ps(l3, _mm512_permute_ps(columns, 0xFF)))));
+        _mm512_storeu_ps(result[m].Elements[0], product);
+    }
+}
+
+// Every kernel instantiation reading one influence encoding, in dispatch table order
+template <InfluenceEncoding ENCODING>
+constexpr KernelTable::InfluenceKernels influence_kernels()
+{
+    return {
+        {
+            &skin_linear_blend<ENCODING, VARIABLE_INFLUENCES>,
+            &skin_linear_blend<ENCODING, 1>,
+            &skin_linear_blend<ENCODING, 2>,
+            &skin_linear_blend<ENCODING, 3>,
+            &skin_linear_blend<ENCODING, 4>
+        },
+        {
+            &skin_dual_quaternion<ENCODING, VARIABLE_INFLUENCES>,
+            &skin_dual_quaternion<ENCODING, 1>,
+            &skin_dual_quaternion<ENCODING, 2>,
+            &skin_dual_quaternion<ENCODING, 3>,
+            &skin_dual_quaternion<ENCODING, 4>
+        }
+    };
+}
+
+} // namespace
+
+const KernelTable KERNELS = {
+    InstructionSet::AVX512,
+    {
+        influence_kernels<InfluenceEncoding::Float32>(),
+        influence_kernels<InfluenceEncoding::Joint16Unorm16>(),
+        influence_kernels<InfluenceEncoding::Joint16Unorm8>(),
+        influence_kernels<InfluenceEncoding::Joint8Unorm16>(),
+        influence_kernels<InfluenceEncoding::Joint8Unorm8>()
+    },
+    &multiply_matrices
+};
+
+} // namespace AVX512
+} // namespace SkinningKernels
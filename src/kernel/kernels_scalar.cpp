@@ -0,0 +1,187 @@
+#include "kernel/kernel_variants.h"
+
+// Standard library imports
+#include <algorithm>
+#include <cmath>
+
+
+namespace SkinningKernels {
+namespace Scalar {
+
+namespace {
+
+template <InfluenceEncoding ENCODING, size_t INFLUENCES>
+void skin_linear_blend(const SkinningJob& job, size_t begin, size_t end)
+{
+    using Encoding = EncodingTraits<ENCODING>;
+    const float* palette = reinterpret_cast<const float*>(job.affine_palette);
+    const auto* joint_ids = static_cast<const typename Encoding::JointId*>(job.joint_ids);
+    const auto* weights = static_cast<const typename Encoding::Weight*>(job.weights);
+
+    for (size_t i = begin; i < end; i++)
+    {
+        const float px = job.rest_x[i];
+        const float py = job.rest_y[i];
+        const float pz = job.rest_z[i];
+
+        float acc_x = 0.f;
+        float acc_y = 0.f;
+        float acc_z = 0.f;
+
+        // Influences are stored per chunk of vertices, one slot after another
+        const size_t chunk = i / InfluenceStreams::CHUNK_SIZE;
+        const size_t influence_count =
+            INFLUENCES == VARIABLE_INFLUENCES ? job.chunk_influences[chunk] : INFLUENCES;
+        const size_t influence_base = job.chunk_offsets[chunk] + i % InfluenceStreams::CHUNK_SIZE;
+
+        SKINNING_UNROLL
+        for (size_t slot = 0; slot < influence_count; slot++)
+        {
+            const size_t stream_index = influence_base + slot * InfluenceStreams::CHUNK_SIZE;
+            const float* m = palette + joint_ids[stream_index] * FLOATS_PER_AFFINE_MATRIX;
+            const float weight = static_cast<float>(weights[stream_index]) * Encoding::WEIGHT_SCALE;
+
+            // Weighted sum of the transformed rest position, one matrix row per component
+            float transformed[3];
+            for (int r = 0; r < 3; r++)
+            {
+                const float* row = m + r * 4;
+                transformed[r] = row[0] * px + row[1] * py + row[2] * pz + row[3];
+            }
+
+            acc_x += weight * transformed[0];
+            acc_y += weight * transformed[1];
+            acc_z += weight * transformed[2];
+        }
+
+        job.skinned_x[i] = acc_x;
+        job.skinned_y[i] = acc_y;
+        job.skinned_z[i] = acc_z;
+    }
+}
+
+template <InfluenceEncoding ENCODING, size_t INFLUENCES>
+void skin_dual_quaternion(const SkinningJob& job, size_t begin, size_t end)
+{
+    using Encoding = EncodingTraits<ENCODING>;
+    const float* palette = reinterpret_cast<const float*>(job.dual_quaternion_palette);
+    const auto* joint_ids = static_cast<const typename Encoding::JointId*>(job.joint_ids);
+    const auto* weights = static_cast<const typename Encoding::Weight*>(job.weights);
+
+    for (size_t i = begin; i < end; i++)
+    {
+        const float px = job.rest_x[i];
+        const float py = job.rest_y[i];
+        const float pz = job.rest_z[i];
+
+        // Blended dual quaternion: real x, y, z, w, then dual x, y, z, w
+        float blend[FLOATS_PER_DUAL_QUATERNION] = {};
+
+        // Influences are stored per chunk of vertices, one slot after another
+        const size_t chunk = i / InfluenceStreams::CHUNK_SIZE;
+        const size_t influence_count =
+            INFLUENCES == VARIABLE_INFLUENCES ? job.chunk_influences[chunk] : INFLUENCES;
+        const size_t influence_base = job.chunk_offsets[chunk] + i % InfluenceStreams::CHUNK_SIZE;
+
+        SKINNING_UNROLL
+        for (size_t slot = 0; slot < influence_count; slot++)
+        {
+            const size_t stream_index = influence_base + slot * InfluenceStreams::CHUNK_SIZE;
+            const float* q = palette + joint_ids[stream_index] * FLOATS_PER_DUAL_QUATERNION;
+            float weight = static_cast<float>(weights[stream_index]) * Encoding::WEIGHT_SCALE;
+
+            // Antipodality: flip quaternions lying in the opposite hemisphere of the blend
+            if (blend[0] * q[0] + blend[1] * q[1] + blend[2] * q[2] + blend[3] * q[3] < 0.f)
+                weight = -weight;
+
+            for (int e = 0; e < FLOATS_PER_DUAL_QUATERNION; e++)
+            {
+                blend[e] += weight * q[e];
+            }
+        }
+
+        // Normalize by the length of the real part (guarding vertices with no influences)
+        const float length_sq = blend[0] * blend[0] + blend[1] * blend[1] +
+                                blend[2] * blend[2] + blend[3] * blend[3];
+        const float inv_length = 1.f / std::sqrt(std::max(length_sq, 1e-12f));
+
+        const float rx = blend[0] * inv_length, ry = blend[1] * inv_length;
+        const float rz = blend[2] * inv_length, rw = blend[3] * inv_length;
+        const float dx = blend[4] * inv_length, dy = blend[5] * inv_length;
+        const float dz = blend[6] * inv_length, dw = blend[7] * inv_length;
+
+        // Rotation: p + 2 * r x (r x p + w * p)
+        const float ix = ry * pz - rz * py + rw * px;
+        const float iy = rz * px - rx * pz + rw * py;
+        const float iz = rx * py - ry * px + rw * pz;
+        const float cx = ry * iz - rz * iy;
+        const float cy = rz * ix - rx * iz;
+        const float cz = rx * iy - ry * ix;
+
+        // Translation: 2 * (w_r * d - w_d * r + r x d)
+        const float tx = rw * dx - dw * rx + ry * dz - rz * dy;
+        const float ty = rw * dy - dw * ry + rz * dx - rx * dz;
+        const float tz = rw * dz - dw * rz + rx * dy - ry * dx;
+
+        job.skinned_x[i] = px + 2.f * (cx + tx);
+        job.skinned_y[i] = py + 2.f * (cy + ty);
+        job.skinned_z[i] = pz + 2.f * (cz + tz);
+    }
+}
+
+void multiply_matrices(const HMM_Mat4* lhs, const HMM_Mat4* rhs, HMM_Mat4* result, size_t count)
+{
+    for (size_t m = 0; m < count; m++)
+    {
+        // Column c of the product is lhs * (column c of rhs)
+        for (int c = 0; c < 4; c++)
+        {
+            for (int r = 0; r < 4; r++)
+            {
+                result[m].Elements[c][r] = lhs[m].Elements[0][r] * rhs[m].Elements[c][0] +
+                                           lhs[m].Elements[1][r] * rhs[m].Elements[c][1] +
+                                           lhs[m].Elements[2][r] * rhs[m].Elements[c][2] +
+                                           lhs[m].Elements[3][r] * rhs[m].Elements[c][3];
+            }
+        }
+    }
+}
+
+// Every kernel instantiation reading one influence encoding, in dispatch table order
+template <InfluenceEncoding ENCODING>
+constexpr KernelTable::InfluenceKernels influence_kernels()
+{
+    return {
+        {
+            &skin_linear_blend<ENCODING, VARIABLE_INFLUENCES>,
+            &skin_linear_blend<ENCODING, 1>,
+            &skin_linear_blend<ENCODING, 2>,
+            &skin_linear_blend<ENCODING, 3>,
+            &skin_linear_blend<ENCODING, 4>
+        },
+        {
+            &skin_dual_quaternion<ENCODING, VARIABLE_INFLUENCES>,
+            &skin_dual_quaternion<ENCODING, 1>,
+            &skin_dual_quaternion<ENCODING, 2>,
+            &skin_dual_quaternion<ENCODING, 3>,
+            &skin_dual_quaternion<ENCODING, 4>
+        }
+    };
+}
+
+} // namespace
+
+const KernelTable KERNELS = {
+    InstructionSet::Scalar,
+    {
+        influence_kernels<InfluenceEncoding::Float32>(),
+        influence_kernels<InfluenceEncoding::Joint16Unorm16>(),
+        influence_kernels<InfluenceEncoding::Joint16Unorm8>(),
+        influence_kernels<InfluenceEncoding::Joint8Unorm16>(),
+        influence_kernels<InfluenceEncoding::Joint8Unorm8>()
+    },
+    &multiply_matrices
+};
+
+} // namespace Scalar
+} // namespace SkinningKernels
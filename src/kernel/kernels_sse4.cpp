@@ -0,0 +1,267 @@
+#include "kernel/kernel_variants.h"
+
+// Standard library imports
+#include <cstring>
+#include <type_traits>
+
+// Platform-specific includes
+#include <smmintrin.h>
+
+
+namespace SkinningKernels {
+namespace SSE4 {
+
+namespace {
+
+// Loads the weights of 4 lanes, widening and dequantizing unorm weights
+template <InfluenceEncoding ENCODING>
+inline __m128 load_weights(const void* weights, size_t index)
+{
+    using Weight = typename EncodingTraits<ENCODING>::Weight;
+    const Weight* source = static_cast<const Weight*>(weights) + index;
+    if constexpr (std::is_same_v<Weight, float>)
+    {
+        return _mm_load_ps(source);
+    }
+    else
+    {
+        __m128i widened;
+        if constexpr (sizeof(Weight) == 1)
+        {
+            int32_t packed;
+            std::memcpy(&packed, source, sizeof(packed));
+            widened = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed));
+        }
+        else
+        {
+            widened = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source)));
+        }
+        return _mm_mul_ps(_mm_cvtepi32_ps(widened), _mm_set1_ps(EncodingTraits<ENCODING>::WEIGHT_SCALE));
+    }
+}
+
+template <InfluenceEncoding ENCODING, size_t INFLUENCES>
+void skin_linear_blend(const SkinningJob& job, size_t begin, size_t end)
+{
+    using JointId = typename EncodingTraits<ENCODING>::JointId;
+    const float* palette = reinterpret_cast<const float*>(job.affine_palette);
+
+    for (size_t i = begin; i < end; i += 4)
+    {
+        const __m128 px = _mm_load_ps(job.rest_x + i);
+        const __m128 py = _mm_load_ps(job.rest_y + i);
+        const __m128 pz = _mm_load_ps(job.rest_z + i);
+
+        __m128 acc_x = _mm_setzero_ps();
+        __m128 acc_y = _mm_setzero_ps();
+        __m128 acc_z = _mm_setzero_ps();
+
+        // Influences are stored per chunk of vertices, one slot after another
+        const size_t chunk = i / InfluenceStreams::CHUNK_SIZE;
+        const size_t influence_count =
+            INFLUENCES == VARIABLE_INFLUENCES ? job.chunk_influences[chunk] : INFLUENCES;
+        const size_t influence_base = job.chunk_offsets[chunk] + i % InfluenceStreams::CHUNK_SIZE;
+
+        SKINNING_UNROLL
+        for (size_t slot = 0; slot < influence_count; slot++)
+        {
+            const size_t stream_index = influence_base + slot * InfluenceStreams::CHUNK_SIZE;
+            const JointId* joint_ids = static_cast<const JointId*>(job.joint_ids) + stream_index;
+            const __m128 weight = load_weights<ENCODING>(job.weights, stream_index);
+
+            const float* m0 = palette + joint_ids[0] * FLOATS_PER_AFFINE_MATRIX;
+            const float* m1 = palette + joint_ids[1] * FLOATS_PER_AFFINE_MATRIX;
+            const float* m2 = palette + joint_ids[2] * FLOATS_PER_AFFINE_MATRIX;
+            const float* m3 = palette + joint_ids[3] * FLOATS_PER_AFFINE_MATRIX;
+
+            // Transpose each of the 3 rows of the 4 matrices so that element k holds that
+            // entry for all 4 lanes
+            __m128 lanes[3][4];
+            for (int r = 0; r < 3; r++)
+            {
+                __m128 r0 = _mm_loadu_ps(m0 + r * 4);
+                __m128 r1 = _mm_loadu_ps(m1 + r * 4);
+                __m128 r2 = _mm_loadu_ps(m2 + r * 4);
+                __m128 r3 = _mm_loadu_ps(m3 + r * 4);
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                lanes[r][0] = r0;
+                lanes[r][1] = r1;
+                lanes[r][2] = r2;
+                lanes[r][3] = r3;
+            }
+
+            // Transform the rest position by each lane's own skinning matrix
+            __m128 transformed[3];
+            for (int r = 0; r < 3; r++)
+            {
+                transformed[r] = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(lanes[r][0], px), _mm_mul_ps(lanes[r][1], py)),
+                    _mm_add_ps(_mm_mul_ps(lanes[r][2], pz), lanes[r][3]));
+            }
+
+            // Weighted sum
+            acc_x = _mm_add_ps(acc_x, _mm_mul_ps(weight, transformed[0]));
+            acc_y = _mm_add_ps(acc_y, _mm_mul_ps(weight, transformed[1]));
+            acc_z = _mm_add_ps(acc_z, _mm_mul_ps(weight, transformed[2]));
+        }
+
+        _mm_store_ps(job.skinned_x + i, acc_x);
+        _mm_store_ps(job.skinned_y + i, acc_y);
+        _mm_store_ps(job.skinned_z + i, acc_z);
+    }
+}
+
+template <InfluenceEncoding ENCODING, size_t INFLUENCES>
+void skin_dual_quaternion(const SkinningJob& job, size_t begin, size_t end)
+{
+    using JointId = typename EncodingTraits<ENCODING>::JointId;
+    const float* palette = reinterpret_cast<const float*>(job.dual_quaternion_palette);
+    const __m128 sign_mask = _mm_set1_ps(-0.f);
+    const __m128 two = _mm_set1_ps(2.f);
+
+    for (size_t i = begin; i < end; i += 4)
+    {
+        const __m128 px = _mm_load_ps(job.rest_x + i);
+        const __m128 py = _mm_load_ps(job.rest_y + i);
+        const __m128 pz = _mm_load_ps(job.rest_z + i);
+
+        __m128 rx = _mm_setzero_ps(), ry = _mm_setzero_ps();
+        __m128 rz = _mm_setzero_ps(), rw = _mm_setzero_ps();
+        __m128 dx = _mm_setzero_ps(), dy = _mm_setzero_ps();
+        __m128 dz = _mm_setzero_ps(), dw = _mm_setzero_ps();
+
+        // Influences are stored per chunk of vertices, one slot after another
+        const size_t chunk = i / InfluenceStreams::CHUNK_SIZE;
+        const size_t influence_count =
+            INFLUENCES == VARIABLE_INFLUENCES ? job.chunk_influences[chunk] : INFLUENCES;
+        const size_t influence_base = job.chunk_offsets[chunk] + i % InfluenceStreams::CHUNK_SIZE;
+
+        SKINNING_UNROLL
+        for (size_t slot = 0; slot < influence_count; slot++)
+        {
+            const size_t stream_index = influence_base + slot * InfluenceStreams::CHUNK_SIZE;
+            const JointId* joint_ids = static_cast<const JointId*>(job.joint_ids) + stream_index;
+            __m128 weight = load_weights<ENCODING>(job.weights, stream_index);
+
+            const float* q0 = palette + joint_ids[0] * FLOATS_PER_DUAL_QUATERNION;
+            const float* q1 = palette + joint_ids[1] * FLOATS_PER_DUAL_QUATERNION;
+            const float* q2 = palette + joint_ids[2] * FLOATS_PER_DUAL_QUATERNION;
+            const float* q3 = palette + joint_ids[3] * FLOATS_PER_DUAL_QUATERNION;
+
+            // Transpose the real and dual halves so each register holds one component
+            __m128 qrx = _mm_loadu_ps(q0), qry = _mm_loadu_ps(q1);
+            __m128 qrz = _mm_loadu_ps(q2), qrw = _mm_loadu_ps(q3);
+            _MM_TRANSPOSE4_PS(qrx, qry, qrz, qrw);
+            __m128 qdx = _mm_loadu_ps(q0 + 4), qdy = _mm_loadu_ps(q1 + 4);
+            __m128 qdz = _mm_loadu_ps(q2 + 4), qdw = _mm_loadu_ps(q3 + 4);
+            _MM_TRANSPOSE4_PS(qdx, qdy, qdz, qdw);
+
+            // Antipodality: flip quaternions lying in the opposite hemisphere of the blend
+            const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, qrx), _mm_mul_ps(ry, qry)),
+                                          _mm_add_ps(_mm_mul_ps(rz, qrz), _mm_mul_ps(rw, qrw)));
+            weight = _mm_xor_ps(weight,
+                                _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), sign_mask));
+
+            rx = _mm_add_ps(rx, _mm_mul_ps(weight, qrx));
+            ry = _mm_add_ps(ry, _mm_mul_ps(weight, qry));
+            rz = _mm_add_ps(rz, _mm_mul_ps(weight, qrz));
+            rw = _mm_add_ps(rw, _mm_mul_ps(weight, qrw));
+            dx = _mm_add_ps(dx, _mm_mul_ps(weight, qdx));
+            dy = _mm_add_ps(dy, _mm_mul_ps(weight, qdy));
+            dz = _mm_add_ps(dz, _mm_mul_ps(weight, qdz));
+            dw = _mm_add_ps(dw, _mm_mul_ps(weight, qdw));
+        }
+
+        // Normalize by the length of the real part (guarding vertices with no influences)
+        const __m128 length_sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)),
+                                            _mm_add_ps(_mm_mul_ps(rz, rz), _mm_mul_ps(rw, rw)));
+        const __m128 inv_length = _mm_div_ps(_mm_set1_ps(1.f),
+            _mm_sqrt_ps(_mm_max_ps(length_sq, _mm_set1_ps(1e-12f))));
+        rx = _mm_mul_ps(rx, inv_length); ry = _mm_mul_ps(ry, inv_length);
+        rz = _mm_mul_ps(rz, inv_length); rw = _mm_mul_ps(rw, inv_length);
+        dx = _mm_mul_ps(dx, inv_length); dy = _mm_mul_ps(dy, inv_length);
+        dz = _mm_mul_ps(dz, inv_length); dw = _mm_mul_ps(dw, inv_length);
+
+        // Rotation: p + 2 * r x (r x p + w * p)
+        const __m128 ix = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(ry, pz), _mm_mul_ps(rz, py)), _mm_mul_ps(rw, px));
+        const __m128 iy = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rz, px), _mm_mul_ps(rx, pz)), _mm_mul_ps(rw, py));
+        const __m128 iz = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rx, py), _mm_mul_ps(ry, px)), _mm_mul_ps(rw, pz));
+        const __m128 cx = _mm_sub_ps(_mm_mul_ps(ry, iz), _mm_mul_ps(rz, iy));
+        const __m128 cy = _mm_sub_ps(_mm_mul_ps(rz, ix), _mm_mul_ps(rx, iz));
+        const __m128 cz = _mm_sub_ps(_mm_mul_ps(rx, iy), _mm_mul_ps(ry, ix));
+
+        // Translation: 2 * (w_r * d - w_d * r + r x d)
+        const __m128 tx = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, dx), _mm_mul_ps(dw, rx)),
+                                     _mm_sub_ps(_mm_mul_ps(ry, dz), _mm_mul_ps(rz, dy)));
+        const __m128 ty = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, dy), _mm_mul_ps(dw, ry)),
+                                     _mm_sub_ps(_mm_mul_ps(rz, dx), _mm_mul_ps(rx, dz)));
+        const __m128 tz = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, dz), _mm_mul_ps(dw, rz)),
+                                     _mm_sub_ps(_mm_mul_ps(rx, dy), _mm_mul_ps(ry, dx)));
+
+        _mm_store_ps(job.skinned_x + i, _mm_add_ps(px, _mm_mul_ps(two, _mm_add_ps(cx, tx))));
+        _mm_store_ps(job.skinned_y + i, _mm_add_ps(py, _mm_mul_ps(two, _mm_add_ps(cy, ty))));
+        _mm_store_ps(job.skinned_z + i, _mm_add_ps(pz, _mm_mul_ps(two, _mm_add_ps(cz, tz))));
+    }
+}
+
+void multiply_matrices(const HMM_Mat4* lhs, const HMM_Mat4* rhs, HMM_Mat4* result, size_t count)
+{
+    for (size_t m = 0; m < count; m++)
+    {
+        const __m128 l0 = _mm_loadu_ps(lhs[m].Elements[0]);
+        const __m128 l1 = _mm_loadu_ps(lhs[m].Elements[1]);
+        const __m128 l2 = _mm_loadu_ps(lhs[m].Elements[2]);
+        const __m128 l3 = _mm_loadu_ps(lhs[m].Elements[3]);
+
+        // Column c of the product is a linear combination of the lhs columns
+        for (int c = 0; c < 4; c++)
+        {
+            const __m128 column = _mm_loadu_ps(rhs[m].Elements[c]);
+            const __m128 product = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(l0, _mm_shuffle_ps(column, column, 0x00)),
+                           _mm_mul_ps(l1, _mm_shuffle_ps(column, column, 0x55))),
+                _mm_add_ps(_mm_mul_ps(l2, _mm_shuffle_ps(column, column, 0xAA)),
+                           _mm_mul_ps(l3, _mm_shuffle_ps(column, column, 0xFF))));
+            _mm_storeu_ps(result[m].Elements[c], product);
+        }
+    }
+}
+
+// Every kernel instantiation reading one influence encoding, in dispatch table order
+template <InfluenceEncoding ENCODING>
+constexpr KernelTable::InfluenceKernels influence_kernels()
+{
+    return {
+        {
+            &skin_linear_blend<ENCODING, VARIABLE_INFLUENCES>,
+            &skin_linear_blend<ENCODING, 1>,
+            &skin_linear_blend<ENCODING, 2>,
+            &skin_linear_blend<ENCODING, 3>,
+            &skin_linear_blend<ENCODING, 4>
+        },
+        {
+            &skin_dual_quaternion<ENCODING, VARIABLE_INFLUENCES>,
+            &skin_dual_quaternion<ENCODING, 1>,
+            &skin_dual_quaternion<ENCODING, 2>,
+            &skin_dual_quaternion<ENCODING, 3>,
+            &skin_dual_quaternion<ENCODING, 4>
+        }
+    };
+}
+
+} // namespace
+
+const KernelTable KERNELS = {
+    InstructionSet::SSE4,
+    {
+        influence_kernels<InfluenceEncoding::Float32>(),
+        influence_kernels<InfluenceEncoding::Joint16Unorm16>(),
+        influence_kernels<InfluenceEncoding::Joint16Unorm8>(),
+        influence_kernels<InfluenceEncoding::Joint8Unorm16>(),
+        influence_kernels<InfluenceEncoding::Joint8Unorm8>()
+    },
+    &multiply_matrices
+};
+
+} // namespace SSE4
+} // namespace SkinningKernels
@@ -0,0 +1,220 @@
+#include "skinning_kernels.h"
+
+// Standard library imports
+#include <cctype>
+#include <stdexcept>
+
+// Local application imports
+#include "kernel/kernel_variants.h"
+
+// Platform-specific includes
+#if defined(MESHSKINNER_X86_KERNELS) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+
+namespace SkinningKernels {
+
+namespace {
+
+#if defined(MESHSKINNER_X86_KERNELS)
+
+// Asks the CPU (and the OS, for the wider register files) whether an ISA is usable
+bool cpu_supports(InstructionSet instruction_set)
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+
+    __cpuidex(info, 1, 0);
+    const bool sse41 = (info[2] & (1 << 19)) != 0;
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+
+    bool avx2 = false;
+    bool avx512f = false;
+    if (max_leaf >= 7)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+        avx512f = (info[1] & (1 << 16)) != 0;
+    }
+
+    // The OS must save the YMM (and for AVX-512, the ZMM/opmask) state on context switches
+    const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    const bool os_avx = (xcr0 & 0x6) == 0x6;
+    const bool os_avx512 = (xcr0 & 0xE6) == 0xE6;
+
+    switch (instruction_set)
+    {
+        case InstructionSet::SSE4:   return sse41;
+        case InstructionSet::AVX2:   return avx && avx2 && fma && os_avx;
+        case InstructionSet::AVX512: return avx512f && os_avx512;
+        case InstructionSet::Scalar:
+        default:                     return true;
+    }
+#else
+    // libgcc's cpuid wrapper also checks that the OS enabled the extended register state
+    __builtin_cpu_init();
+    switch (instruction_set)
+    {
+        case InstructionSet::SSE4:
+            return __builtin_cpu_supports("sse4.1");
+        case InstructionSet::AVX2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case InstructionSet::AVX512:
+            return __builtin_cpu_supports("avx512f");
+        case InstructionSet::Scalar:
+        default:
+            return true;
+    }
+#endif
+}
+
+#endif
+
+} // namespace
+
+SkinningJob make_skinning_job(const VertexStreams& rest, const InfluenceStreams& influences,
+                              VertexStreams& skinned)
+{
+    SkinningJob job;
+    job.rest_x = rest.x.data();
+    job.rest_y = rest.y.data();
+    job.rest_z = rest.z.data();
+    job.chunk_offsets = influences.chunk_offsets.data();
+    job.chunk_influences = influences.chunk_influences.data();
+    switch (influences.encoding)
+    {
+        case InfluenceEncoding::Joint16Unorm16:
+            job.joint_ids = influences.joint_ids_16.data();
+            job.weights = influences.weights_unorm16.data();
+            break;
+        case InfluenceEncoding::Joint16Unorm8:
+            job.joint_ids = influences.joint_ids_16.data();
+            job.weights = influences.weights_unorm8.data();
+            break;
+        case InfluenceEncoding::Joint8Unorm16:
+            job.joint_ids = influences.joint_ids_8.data();
+            job.weights = influences.weights_unorm16.data();
+            break;
+        case InfluenceEncoding::Joint8Unorm8:
+            job.joint_ids = influences.joint_ids_8.data();
+            job.weights = influences.weights_unorm8.data();
+            break;
+        case InfluenceEncoding::Float32:
+        default:
+            job.joint_ids = influences.joint_ids.data();
+            job.weights = influences.weights.data();
+            break;
+    }
+    job.skinned_x = skinned.x.data();
+    job.skinned_y = skinned.y.data();
+    job.skinned_z = skinned.z.data();
+    job.affine_palette = nullptr;
+    job.dual_quaternion_palette = nullptr;
+    return job;
+}
+
+SkinVerticesFn select_linear_blend(const KernelTable& kernels, size_t influence_count,
+                                   InfluenceEncoding encoding)
+{
+    // Counts without an unrolled instantiation fall back to the generic loop
+    const size_t entry = influence_count <= MAX_SPECIALIZED_INFLUENCES ? influence_count : 0;
+    return kernels.influence_kernels[static_cast<size_t>(encoding)].skin_linear_blend[entry];
+}
+
+SkinVerticesFn select_dual_quaternion(const KernelTable& kernels, size_t influence_count,
+                                      InfluenceEncoding encoding)
+{
+    const size_t entry = influence_count <= MAX_SPECIALIZED_INFLUENCES ? influence_count : 0;
+    return kernels.influence_kernels[static_cast<size_t>(encoding)].skin_dual_quaternion[entry];
+}
+
+InstructionSet detect_instruction_set()
+{
+    // cpuid is only queried once per process
+    static const InstructionSet detected = []()
+    {
+        for (const InstructionSet candidate : { InstructionSet::AVX512,
+                                                InstructionSet::AVX2,
+                                                InstructionSet::SSE4 })
+        {
+            if (is_supported(candidate))
+                return candidate;
+        }
+        return InstructionSet::Scalar;
+    }();
+
+    return detected;
+}
+
+bool is_supported(InstructionSet instruction_set)
+{
+#if defined(MESHSKINNER_X86_KERNELS)
+    return cpu_supports(instruction_set);
+#else
+    return instruction_set == InstructionSet::Scalar;
+#endif
+}
+
+const KernelTable& get_kernels(InstructionSet instruction_set)
+{
+    if (!is_supported(instruction_set))
+    {
+        throw std::invalid_argument(std::string("Instruction set not supported on this CPU: ")
+                                    + instruction_set_name(instruction_set));
+    }
+
+    switch (instruction_set)
+    {
+#if defined(MESHSKINNER_X86_KERNELS)
+        case InstructionSet::SSE4:   return SSE4::KERNELS;
+        case InstructionSet::AVX2:   return AVX2::KERNELS;
+        case InstructionSet::AVX512: return AVX512::KERNELS;
+#endif
+        case InstructionSet::Scalar:
+        default:                     return Scalar::KERNELS;
+    }
+}
+
+const char* instruction_set_name(InstructionSet instruction_set)
+{
+    switch (instruction_set)
+    {
+        case InstructionSet::SSE4:   return "SSE4";
+        case InstructionSet::AVX2:   return "AVX2";
+        case InstructionSet::AVX512: return "AVX-512";
+        case InstructionSet::Scalar:
+        default:                     return "Scalar";
+    }
+}
+
+bool parse_instruction_set(const std::string& name, InstructionSet& instruction_set)
+{
+    // Normalize to lowercase without separators, so "AVX-512" and "avx512" both match
+    std::string key;
+    for (const char c : name)
+    {
+        if (c != '-' && c != '_' && c != '.')
+            key.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+    }
+
+    if (key == "scalar")
+        instruction_set = InstructionSet::Scalar;
+    else if (key == "sse4" || key == "sse41")
+        instruction_set = InstructionSet::SSE4;
+    else if (key == "avx2")
+        instruction_set = InstructionSet::AVX2;
+    else if (key == "avx512")
+        instruction_set = InstructionSet::AVX512;
+    else
+        return false;
+
+    return true;
+}
+
+} // namespace SkinningKernels
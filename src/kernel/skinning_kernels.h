@@ -0,0 +1,220 @@
+#pragma once
+
+// Standard library imports
+#include <string>
+
+// Third-party imports
+#include "handmade_math/handmade_math.h"
+
+// Local application imports
+#include "facade/math_facade.h"
+#include "model/vertex_streams.h"
+
+
+/**
+ * @brief Low-level SIMD kernels operating on structure-of-arrays vertex data.
+ *
+ * Every hot kernel is compiled once per instruction set (each variant lives in its own
+ * translation unit built with matching compiler flags), so a single binary runs on any
+ * x86-64 CPU. The best variant supported by the host is picked at runtime via cpuid and
+ * exposed as a KernelTable of function pointers.
+ */
+namespace SkinningKernels {
+
+/**
+ * @brief The instruction sets a kernel variant can be compiled for, from slowest to fastest.
+ */
+enum class InstructionSet
+{
+    Scalar,
+    SSE4,
+    AVX2,
+    AVX512
+};
+
+/**
+ * @brief Largest influence count with its own unrolled kernel instantiation.
+ *
+ * Buckets with more influences (and the generic entry 0 of each dispatch table) use
+ * a loop over the per-chunk influence count.
+ */
+constexpr size_t MAX_SPECIALIZED_INFLUENCES = 4;
+
+/**
+ * @brief Raw pointers to everything a skinning kernel reads and writes.
+ *
+ * Kernels only see plain pointers: the per-instruction-set translation units must not
+ * instantiate shared inline code (e.g. container accessors), or the linker could pick
+ * a copy compiled for a newer CPU than the one we are running on.
+ */
+struct SkinningJob
+{
+    const float* rest_x;
+    const float* rest_y;
+    const float* rest_z;
+
+    // Influences in the chunked layout of InfluenceStreams; the element types of the joint
+    // ID and weight streams depend on the encoding the kernel was instantiated for
+    const uint32_t* chunk_offsets;
+    const uint32_t* chunk_influences;
+    const void* joint_ids;
+    const void* weights;
+
+    float* skinned_x;
+    float* skinned_y;
+    float* skinned_z;
+
+    // Per-joint 3x4 skinning matrices, read by the linear blend kernels
+    const AffineMatrix* affine_palette;
+    // Per-joint unit dual quaternions, read by the dual quaternion kernel
+    const DualQuaternion* dual_quaternion_palette;
+};
+
+/**
+ * @brief Builds a SkinningJob from the SoA streams (palettes are left null).
+ * @param rest The rest-pose positions.
+ * @param influences The joint IDs and weights for each vertex.
+ * @param skinned The destination positions, already sized like rest.
+ * @return The job describing the streams.
+ */
+SkinningJob make_skinning_job(const VertexStreams& rest, const InfluenceStreams& influences,
+                              VertexStreams& skinned);
+
+/**
+ * @brief Skins a range of vertices.
+ *
+ * Both bounds must be multiples of VertexStreams::LANE_PADDING, and end must not
+ * exceed the padded stream size.
+ *
+ * @param job The input and output streams, plus the palette the kernel reads.
+ * @param begin The first vertex to process.
+ * @param end One past the last vertex to process.
+ */
+using SkinVerticesFn = void (*)(const SkinningJob& job, size_t begin, size_t end);
+
+/**
+ * @brief Multiplies two arrays of matrices element-wise (result[i] = lhs[i] * rhs[i]).
+ *
+ * Used to build the skinning palette from the pose and inverse bind matrices.
+ *
+ * @param lhs The left-hand matrices.
+ * @param rhs The right-hand matrices.
+ * @param result The destination array (may not alias the inputs).
+ * @param count The number of matrices in each array.
+ */
+using MultiplyMatricesFn = void (*)(const HMM_Mat4* lhs, const HMM_Mat4* rhs,
+                                    HMM_Mat4* result, size_t count);
+
+/**
+ * @brief The set of hot kernels compiled for one instruction set.
+ */
+struct KernelTable
+{
+    /**
+     * @brief The skinning kernels reading one InfluenceEncoding.
+     */
+    struct InfluenceKernels
+    {
+        /**
+         * @brief Linear blend skinning of a vertex range (reads job.affine_palette).
+         *
+         * Each rest position is transformed by every influencing joint's matrix and the
+         * results are blended by weight. Like MathFacade::transform_vec3, only the top three
+         * rows of a skinning matrix matter, so palettes are always packed as 3x4 matrices.
+         * Indexed by influence count: entry k is fully unrolled for chunks of exactly k
+         * influences, entry 0 handles any count. Use select_linear_blend() rather than
+         * indexing directly.
+         */
+        SkinVerticesFn skin_linear_blend[MAX_SPECIALIZED_INFLUENCES + 1];
+
+        /**
+         * @brief Dual quaternion skinning of a vertex range (reads job.dual_quaternion_palette).
+         *
+         * The influencing dual quaternions are blended (with antipodality correction),
+         * normalized, and applied to the rest position. This preserves volume around
+         * twisting joints, where linear blending collapses ("candy-wrapper" artifacts).
+         * Indexed by influence count like skin_linear_blend; use select_dual_quaternion().
+         */
+        SkinVerticesFn skin_dual_quaternion[MAX_SPECIALIZED_INFLUENCES + 1];
+    };
+
+    /**
+     * @brief The instruction set these kernels were compiled for.
+     */
+    InstructionSet instruction_set;
+
+    /**
+     * @brief The skinning kernels of each influence encoding, indexed by InfluenceEncoding.
+     *
+     * The compact encodings widen joint IDs and dequantize unorm weights in registers,
+     * right after loading them.
+     */
+    InfluenceKernels influence_kernels[INFLUENCE_ENCODING_COUNT];
+
+    /**
+     * @brief Element-wise matrix multiplication, used for palette precomputation.
+     */
+    MultiplyMatricesFn multiply_matrices;
+};
+
+/**
+ * @brief Picks the linear blend kernel for a range whose chunks all have the same influence count.
+ * @param kernels The kernel table of the active instruction set.
+ * @param influence_count The influence count of the range (0 if it varies between chunks).
+ * @param encoding The encoding of the influence streams the job points to.
+ * @return The unrolled instantiation for that count, or the generic loop.
+ */
+SkinVerticesFn select_linear_blend(const KernelTable& kernels, size_t influence_count,
+                                   InfluenceEncoding encoding = InfluenceEncoding::Float32);
+
+/**
+ * @brief Picks the dual quaternion kernel for a range whose chunks all have the same influence count.
+ * @param kernels The kernel table of the active instruction set.
+ * @param influence_count The influence count of the range (0 if it varies between chunks).
+ * @param encoding The encoding of the influence streams the job points to.
+ * @return The unrolled instantiation for that count, or the generic loop.
+ */
+SkinVerticesFn select_dual_quaternion(const KernelTable& kernels, size_t influence_count,
+                                      InfluenceEncoding encoding = InfluenceEncoding::Float32);
+
+/**
+ * @brief Queries the CPU (via cpuid) for the fastest supported instruction set.
+ *
+ * The result is computed once and cached. Variants that were not compiled into
+ * this binary (e.g. on non-x86 targets) are never reported.
+ *
+ * @return The best instruction set available on this machine.
+ */
+InstructionSet detect_instruction_set();
+
+/**
+ * @brief Checks whether a kernel variant can run on this machine.
+ * @param instruction_set The instruction set to check.
+ * @return true if the variant is compiled in and supported by the CPU; otherwise false.
+ */
+bool is_supported(InstructionSet instruction_set);
+
+/**
+ * @brief Gets the kernel table for a given instruction set.
+ * @param instruction_set The requested instruction set.
+ * @return The matching kernels.
+ * @throws std::invalid_argument if the variant is not supported on this machine.
+ */
+const KernelTable& get_kernels(InstructionSet instruction_set);
+
+/**
+ * @brief Gets the human-readable name of an instruction set.
+ * @param instruction_set The instruction set.
+ * @return "Scalar", "SSE4", "AVX2" or "AVX-512".
+ */
+const char* instruction_set_name(InstructionSet instruction_set);
+
+/**
+ * @brief Parses an instruction set name (case-insensitive, e.g. "avx2", "avx512", "sse4").
+ * @param name The name to parse.
+ * @param instruction_set Receives the parsed value on success.
+ * @return true if the name was recognized; otherwise false.
+ */
+bool parse_instruction_set(const std::string& name, InstructionSet& instruction_set);
+
+} // namespace SkinningKernels
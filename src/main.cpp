@@ -1,5 +1,9 @@
 // Standard library imports
+#include <charconv>
+#include <cstdlib>
+#include <filesystem>
 #include <iostream>
+#include <string>
 
 // Local application imports
 #include "mesh_skinner.h"
@@ -17,11 +21,38 @@ int main(int argc, char* argv[])
                                                                    
     )" << std::endl;
 
+    // Packing poses into a pose track needs neither the mesh nor the weights
+    if (argc == 4 && std::string(argv[1]) == "--pack")
+    {
+        MeshSkinner packer;
+        if (!packer.load_pose_sequence(argv[2])) return 1;
+        if (!packer.save_pose_track(argv[3])) return 1;
+
+        std::cout << "Press Enter to exit...";
+        std::cin.get();
+        return 0;
+    }
+
     // Ensure the num of input params is correct
     if (argc < 6) 
     {
         std::cerr << "Usage: " << argv[0] << " <input_mesh.obj> <bone_weight.json> "
-                  << "<inverse_bind_pose.json> <output_pose.json> <output_mesh.obj>\n";
+                  << "<inverse_bind_pose.json> <output_pose.json> <output_mesh.obj> "
+                  << "[--dqs] [--sequence] [--threads <count>] [--numa] [--meshlets] [--bounds]\n"
+                  << "       [--skeleton <skeleton.json>] [--weights <float|unorm16|unorm8>]\n"
+                  << "       [--morphs <morph_targets.json>] [--clip <fps>] [--frame <index>]\n"
+                  << "   or: " << argv[0] << " --pack <poses> <pose_track.mska>\n"
+                  << "With --sequence, <output_pose.json> may be a directory, a quoted wildcard pattern "
+                  << "(e.g. \"poses/frame_*.json\") or a file holding an array of palettes, and one "
+                  << "numbered OBJ is written per frame (output_mesh_0000.obj, ...).\n"
+                  << "With --skeleton, <output_pose.json> holds local joint transforms "
+                  << "(translation, rotation, scale) that are posed through the joint hierarchy.\n"
+                  << "With --morphs, the weighted morph targets are added to the rest pose while it is skinned.\n"
+                  << "With --clip, <output_pose.json> holds keyframes per joint that are sampled at <fps> "
+                  << "and written as numbered frames like --sequence.\n"
+                  << "--pack compresses poses (any input --sequence takes) into a .mska pose track. A track "
+                  << "given as <output_pose.json> is skinned as a sequence, or only its frame <index> "
+                  << "with --frame.\n";
         
         // Wait for input so the console doesn't close immediately
         std::cout << "Press Enter to exit...";
@@ -32,17 +63,186 @@ int main(int argc, char* argv[])
 
     MeshSkinner skinner;
 
+    // A directory or wildcard pattern of poses implies sequence mode
+    const std::string pose_path = argv[4];
+    bool sequence_mode = std::filesystem::is_directory(pose_path) ||
+                         pose_path.find_first_of("*?") != std::string::npos;
+
+    std::string skeleton_path;
+    std::string morph_targets_path;
+    float clip_frame_rate = 0.f;
+
+    // A pose track is skinned as a sequence unless one of its frames is picked
+    const bool pose_track_input = std::filesystem::path(pose_path).extension() == ".mska";
+    bool track_frame_picked = false;
+    size_t track_frame = 0;
+
+    // Parse optional flags following the positional arguments
+    for (int arg = 6; arg < argc; arg++)
+    {
+        if (std::string(argv[arg]) == "--dqs")
+        {
+            skinner.set_skinning_method(SkinningMethod::DualQuaternion);
+        }
+        else if (std::string(argv[arg]) == "--sequence")
+        {
+            sequence_mode = true;
+        }
+        else if (std::string(argv[arg]) == "--numa")
+        {
+            skinner.set_numa_aware(true);
+        }
+        else if (std::string(argv[arg]) == "--meshlets")
+        {
+            skinner.set_meshlet_tiling(true);
+        }
+        else if (std::string(argv[arg]) == "--bounds")
+        {
+            skinner.set_bounds_tracking(true);
+        }
+        else if (std::string(argv[arg]) == "--skeleton" && arg + 1 < argc)
+        {
+            skeleton_path = argv[++arg];
+        }
+        else if (std::string(argv[arg]) == "--clip" && arg + 1 < argc)
+        {
+            const std::string rate = argv[++arg];
+            char* parse_end = nullptr;
+            const float parsed = std::strtof(rate.c_str(), &parse_end);
+            if (rate.empty() || *parse_end != '\0' || !(parsed > 0.f))
+            {
+                std::cerr << "Ignoring invalid clip frame rate: " << rate << "\n";
+            }
+            else
+            {
+                clip_frame_rate = parsed;
+            }
+        }
+        else if (std::string(argv[arg]) == "--frame" && arg + 1 < argc)
+        {
+            // from_chars rejects signs and reports overflow instead of throwing
+            const std::string frame = argv[++arg];
+            const char* frame_end = frame.data() + frame.size();
+            size_t parsed = 0;
+            const std::from_chars_result result = std::from_chars(frame.data(), frame_end, parsed);
+            if (frame.empty() || result.ec != std::errc() || result.ptr != frame_end)
+            {
+                std::cerr << "Ignoring invalid frame index: " << frame << "\n";
+            }
+            else
+            {
+                track_frame = parsed;
+                track_frame_picked = true;
+            }
+        }
+        else if (std::string(argv[arg]) == "--morphs" && arg + 1 < argc)
+        {
+            morph_targets_path = argv[++arg];
+        }
+        else if (std::string(argv[arg]) == "--weights" && arg + 1 < argc)
+        {
+            const std::string precision = argv[++arg];
+            if (precision == "float")
+                skinner.set_weight_precision(WeightPrecision::Float32);
+            else if (precision == "unorm16")
+                skinner.set_weight_precision(WeightPrecision::Unorm16);
+            else if (precision == "unorm8")
+                skinner.set_weight_precision(WeightPrecision::Unorm8);
+            else
+                std::cerr << "Ignoring unknown weight precision: " << precision << "\n";
+        }
+        else if (std::string(argv[arg]) == "--threads" && arg + 1 < argc)
+        {
+            // from_chars rejects signs and reports overflow instead of throwing
+            const std::string count = argv[++arg];
+            const char* count_end = count.data() + count.size();
+            size_t parsed = 0;
+            const std::from_chars_result result = std::from_chars(count.data(), count_end, parsed);
+            if (count.empty() || result.ec != std::errc() || result.ptr != count_end)
+            {
+                std::cerr << "Ignoring invalid thread count: " << count << "\n";
+            }
+            else
+            {
+                skinner.set_thread_count(parsed);
+            }
+        }
+        else
+        {
+            std::cerr << "Ignoring unknown option: " << argv[arg] << "\n";
+        }
+    }
+
+    if (track_frame_picked && !pose_track_input)
+    {
+        std::cerr << "--frame picks a frame of a .mska pose track\n";
+        return 1;
+    }
+    if (pose_track_input && !track_frame_picked)
+        sequence_mode = true;
+
     // Load input data
     if (!skinner.load_mesh(argv[1])) return 1;
     if (!skinner.load_weights(argv[2])) return 1;
     if (!skinner.load_inverse_bind_matrices(argv[3])) return 1;
-    if (!skinner.load_output_pose_matrices(argv[4])) return 1;
+    if (!morph_targets_path.empty() && !skinner.load_morph_targets(morph_targets_path)) return 1;
 
-    // Perform the skinning operation
-    if (!skinner.perform_skinning()) return 1;
+    if (clip_frame_rate > 0.f && sequence_mode)
+    {
+        std::cerr << "--clip samples its own frames and cannot be combined with --sequence\n";
+        return 1;
+    }
+
+    if (!skeleton_path.empty() && sequence_mode)
+    {
+        std::cerr << "--skeleton poses a single frame and cannot be combined with --sequence\n";
+        return 1;
+    }
+
+    if (clip_frame_rate > 0.f)
+    {
+        // Poses are sampled from the keyframes in-process, then skinned in a single batch
+        if (!skeleton_path.empty() && !skinner.load_skeleton(skeleton_path)) return 1;
+        if (!skinner.load_animation_clip(pose_path)) return 1;
+        if (!skinner.sample_animation_sequence(clip_frame_rate)) return 1;
+        if (!skinner.perform_sequence_skinning()) return 1;
+        if (!skinner.save_skinned_sequence(argv[5])) return 1;
+    }
+    else if (sequence_mode)
+    {
+        // Static assets are loaded once; every frame is skinned in a single batch
+        if (!skinner.load_pose_sequence(pose_path)) return 1;
+        if (!skinner.perform_sequence_skinning()) return 1;
+        if (!skinner.save_skinned_sequence(argv[5])) return 1;
+    }
+    else
+    {
+        if (!skeleton_path.empty())
+        {
+            // Local transforms are posed through the hierarchy inside the skinner
+            if (!skinner.load_skeleton(skeleton_path)) return 1;
+            if (!skinner.load_local_pose(pose_path)) return 1;
+        }
+        else if (pose_track_input)
+        {
+            // Only the picked frame is read from the mapped track
+            if (!skinner.load_pose_track(pose_path)) return 1;
+            if (!skinner.set_pose_track_frame(track_frame)) return 1;
+        }
+        else if (!skinner.load_output_pose_matrices(pose_path)) return 1;
+
+        // Perform the skinning operation
+        if (!skinner.perform_skinning()) return 1;
 
-    // Save the result
-    if (!skinner.save_skinned_mesh(argv[5])) return 1;
+        if (skinner.get_influence_encoding() != InfluenceEncoding::Float32)
+        {
+            std::cout << "Quantized weights move vertices by at most " << std::defaultfloat
+                      << skinner.measure_quantization_error() << " under this pose\n";
+        }
+
+        // Save the result
+        if (!skinner.save_skinned_mesh(argv[5])) return 1;
+    }
     
     // Wait for input so the console doesn't close immediately
     std::cout << "Press Enter to exit...";
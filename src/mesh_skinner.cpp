@@ -3,103 +3,2136 @@
 // Standard library imports
 #include <algorithm>
 #include <chrono>
-#include <execution>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 
 // Local application imports
 #include "facade/json_facade.h"
 #include "facade/math_facade.h"
 #include "facade/obj_facade.h"
+#include "kernel/skinning_kernels.h"
 
 
+namespace {
+
+// Describes how an encoding stores joint IDs and weights, for log messages
+const char* encoding_description(InfluenceEncoding encoding)
+{
+    switch (encoding)
+    {
+        case InfluenceEncoding::Joint16Unorm16: return "16-bit joint IDs and unorm16 weights";
+        case InfluenceEncoding::Joint16Unorm8:  return "16-bit joint IDs and unorm8 weights";
+        case InfluenceEncoding::Joint8Unorm16:  return "8-bit joint IDs and unorm16 weights";
+        case InfluenceEncoding::Joint8Unorm8:   return "8-bit joint IDs and unorm8 weights";
+        case InfluenceEncoding::Float32:
+        default:                                return "32-bit joint IDs and float weights";
+    }
+}
+
+// Moves the skinned positions in [begin, end) by an affine transform, in place
+void place_positions(const AffineMatrix& transform, VertexStreams& positions, size_t begin, size_t end)
+{
+    const float (*m)[4] = transform.rows;
+    for (size_t i = begin; i < end; i++)
+    {
+        const float x = positions.x[i];
+        const float y = positions.y[i];
+        const float z = positions.z[i];
+        positions.x[i] = m[0][0] * x + m[0][1] * y + m[0][2] * z + m[0][3];
+        positions.y[i] = m[1][0] * x + m[1][1] * y + m[1][2] * z + m[1][3];
+        positions.z[i] = m[2][0] * x + m[2][1] * y + m[2][2] * z + m[2][3];
+    }
+}
+
+// Matches a file name against a pattern where '*' is any run of characters and '?' any one
+bool matches_wildcard(const std::string& name, const std::string& pattern)
+{
+    size_t n = 0;
+    size_t p = 0;
+    size_t star = std::string::npos;
+    size_t star_match = 0;
+
+    while (n < name.size())
+    {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n]))
+        {
+            n++;
+            p++;
+        }
+        else if (p < pattern.size() && pattern[p] == '*')
+        {
+            // Remember the star and first try matching it against nothing
+            star = p++;
+            star_match = n;
+        }
+        else if (star != std::string::npos)
+        {
+            // Backtrack: let the last star swallow one more character
+            p = star + 1;
+            n = ++star_match;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    while (p < pattern.size() && pattern[p] == '*')
+    {
+        p++;
+    }
+    return p == pattern.size();
+}
+
+// Orders names the way people number files: runs of digits compare by value, so
+// "pose_2" comes before "pose_10" (ties fall back to plain character order)
+bool natural_less(const std::string& a, const std::string& b)
+{
+    const auto is_digit = [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; };
+
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.size() && j < b.size())
+    {
+        if (is_digit(a[i]) && is_digit(b[j]))
+        {
+            // Skip leading zeros; then the longer run is the larger number
+            while (i < a.size() && a[i] == '0') i++;
+            while (j < b.size() && b[j] == '0') j++;
+            size_t a_end = i;
+            size_t b_end = j;
+            while (a_end < a.size() && is_digit(a[a_end])) a_end++;
+            while (b_end < b.size() && is_digit(b[b_end])) b_end++;
+
+            if (a_end - i != b_end - j)
+                return a_end - i < b_end - j;
+            const int order = a.compare(i, a_end - i, b, j, b_end - j);
+            if (order != 0)
+                return order < 0;
+
+            i = a_end;
+            j = b_end;
+        }
+        else
+        {
+            if (a[i] != b[j])
+                return a[i] < b[j];
+            i++;
+            j++;
+        }
+    }
+
+    if (i < a.size() || j < b.size())
+        return j < b.size();
+    return a < b;
+}
+
+// The output slots of submit_skinning(), shared with the frames handed out so that they can
+// outlive the skinner
+struct OutputSlots
+{
+    std::mutex mutex;
+    std::condition_variable slot_released;
+    std::vector<std::vector<Vertex>> buffers;
+    std::vector<bool> in_use;
+    size_t next_slot = 0;
+};
+
+std::shared_ptr<OutputSlots> make_output_slots(size_t slot_count)
+{
+    std::shared_ptr<OutputSlots> slots = std::make_shared<OutputSlots>();
+    slots->buffers.resize(std::max<size_t>(1, slot_count));
+    slots->in_use.assign(slots->buffers.size(), false);
+    return slots;
+}
+
+// Finds the first free slot from next_slot on, so frames rotate through the slots
+bool find_free_slot(const OutputSlots& slots, size_t& slot)
+{
+    for (size_t offset = 0; offset < slots.in_use.size(); offset++)
+    {
+        const size_t candidate = (slots.next_slot + offset) % slots.in_use.size();
+        if (!slots.in_use[candidate])
+        {
+            slot = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+struct MeshSkinner::AsyncSkinning
+{
+    // A pose waiting to be skinned, with the slots it will be skinned into
+    struct Submission
+    {
+        std::vector<HMM_Mat4> pose_matrices;
+        std::promise<SkinnedFrame> frame;
+        std::shared_ptr<OutputSlots> slots;
+    };
+
+    std::mutex mutex;
+    std::condition_variable submitted;
+    std::condition_variable finished;
+    std::deque<Submission> queue;
+    size_t pending = 0;
+    std::atomic<bool> stopping{ false };
+    std::shared_ptr<OutputSlots> slots;
+};
+
 // Threshold below which joint weights are considered negligible.
 const float MeshSkinner::WEIGHT_THRESHOLD = .0001f;
 
-bool MeshSkinner::load_mesh(const std::string& mesh_path)
-{
-    try
+// Default number of vertices handed to the SIMD kernel per parallel task.
+const size_t MeshSkinner::SKINNING_BLOCK_SIZE = 1024;
+
+// Number of vertices per tile when skinning a batch of poses (sized to stay in L1).
+const size_t MeshSkinner::BATCH_BLOCK_SIZE = 256;
+
+// Number of poses skinned against one tile before moving on to the next.
+const size_t MeshSkinner::BATCH_POSE_GROUP_SIZE = 16;
+
+// Number of output slots submit_skinning() rotates through by default (double buffering).
+const size_t MeshSkinner::DEFAULT_OUTPUT_SLOT_COUNT = 2;
+
+// Number of joints per parallel task when evaluating the skeleton.
+const size_t MeshSkinner::SKELETON_BLOCK_SIZE = 64;
+
+// Number of frames per parallel task when decoding a whole pose track.
+const size_t MeshSkinner::TRACK_DECODE_BLOCK_SIZE = 16;
+
+// Largest thread pool the skinner creates; larger requests are clamped to it.
+const size_t MeshSkinner::MAX_THREAD_COUNT = 1024;
+
+MeshSkinner::MeshSkinner()
+    : kernels(&SkinningKernels::get_kernels(SkinningKernels::detect_instruction_set()))
+    , skinning_method(SkinningMethod::LinearBlend)
+    , grain_size(SKINNING_BLOCK_SIZE)
+    , numa_aware(false)
+    , weight_precision(WeightPrecision::Float32)
+    , meshlet_tiling(false)
+    , bounds_tracking(false)
+    , referenced_joint_count(0)
+    , async_skinning(std::make_unique<AsyncSkinning>())
+{
+    async_skinning->slots = make_output_slots(DEFAULT_OUTPUT_SLOT_COUNT);
+
+    // Allow sizing the thread pool from the environment (one thread per core by default)
+    size_t thread_count = 0;
+    const char* forced_threads = std::getenv("MESHSKINNER_THREADS");
+    if (forced_threads != nullptr && *forced_threads != '\0')
+    {
+        char* parse_end = nullptr;
+        const unsigned long parsed = std::strtoul(forced_threads, &parse_end, 10);
+        if (*parse_end != '\0' || parsed == 0)
+        {
+            std::cerr << "Ignoring invalid MESHSKINNER_THREADS value '" << forced_threads << "'\n";
+        }
+        else
+        {
+            thread_count = std::min<size_t>(parsed, MAX_THREAD_COUNT);
+        }
+    }
+
+    const char* forced_numa = std::getenv("MESHSKINNER_NUMA");
+    numa_aware = forced_numa != nullptr && std::string(forced_numa) == "1";
+
+    thread_pool = std::make_unique<ThreadPool>(thread_count, numa_aware);
+
+    // Allow forcing a kernel variant from the environment (for A/B benchmarking)
+    const char* forced_isa = std::getenv("MESHSKINNER_ISA");
+    if (forced_isa != nullptr && *forced_isa != '\0')
+    {
+        SkinningKernels::InstructionSet instruction_set;
+        if (!SkinningKernels::parse_instruction_set(forced_isa, instruction_set))
+        {
+            std::cerr << "Unknown MESHSKINNER_ISA value '" << forced_isa
+                      << "', using " << SkinningKernels::instruction_set_name(
+                             kernels->instruction_set) << "\n";
+        }
+        else if (!set_instruction_set(instruction_set))
+        {
+            std::cerr << "MESHSKINNER_ISA=" << forced_isa << " is not supported on this CPU, using "
+                      << SkinningKernels::instruction_set_name(kernels->instruction_set) << "\n";
+        }
+    }
+}
+
+MeshSkinner::~MeshSkinner()
+{
+    if (!async_thread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(async_skinning->mutex);
+        async_skinning->stopping = true;
+    }
+    async_skinning->submitted.notify_all();
+
+    // The thread may also be waiting for a frame to release its slot
+    {
+        std::lock_guard<std::mutex> lock(async_skinning->slots->mutex);
+    }
+    async_skinning->slots->slot_released.notify_all();
+
+    async_thread.join();
+}
+
+bool MeshSkinner::set_instruction_set(SkinningKernels::InstructionSet instruction_set)
+{
+    if (!SkinningKernels::is_supported(instruction_set))
+    {
+        return false;
+    }
+
+    kernels = &SkinningKernels::get_kernels(instruction_set);
+    // Variants round differently, so the next pose must be skinned in full
+    skinned_palette.clear();
+    return true;
+}
+
+void MeshSkinner::set_thread_count(size_t thread_count)
+{
+    if (thread_count == 0)
+    {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    thread_count = std::min(thread_count, MAX_THREAD_COUNT);
+
+    if (thread_count != thread_pool->get_thread_count())
+    {
+        thread_pool = std::make_unique<ThreadPool>(thread_count, numa_aware);
+        place_streams_on_nodes();
+    }
+}
+
+void MeshSkinner::set_numa_aware(bool enabled)
+{
+    if (enabled == numa_aware)
+    {
+        return;
+    }
+
+    numa_aware = enabled;
+    thread_pool = std::make_unique<ThreadPool>(thread_pool->get_thread_count(), numa_aware);
+    place_streams_on_nodes();
+}
+
+bool MeshSkinner::is_numa_aware() const
+{
+    return numa_aware;
+}
+
+void MeshSkinner::set_meshlet_tiling(bool enabled)
+{
+    if (enabled != meshlet_tiling)
+    {
+        meshlet_tiling = enabled;
+        build_skinning_streams();
+    }
+}
+
+bool MeshSkinner::is_meshlet_tiling() const
+{
+    return meshlet_tiling;
+}
+
+size_t MeshSkinner::get_meshlet_count() const
+{
+    return meshlets.meshlets.size();
+}
+
+bool MeshSkinner::compute_pose_bounds(const std::vector<HMM_Mat4>& pose_matrices,
+                                      const HMM_Mat4& world_transform, PositionBounds& bounds) const
+{
+    if (!validate_skinning_data() || !validate_pose_matrices(pose_matrices))
+    {
+        return false;
+    }
+
+    std::fill_n(bounds.min, 3, std::numeric_limits<float>::max());
+    std::fill_n(bounds.max, 3, std::numeric_limits<float>::lowest());
+    const auto include = [&bounds](const float point[3])
+    {
+        for (int axis = 0; axis < 3; axis++)
+        {
+            bounds.min[axis] = std::min(bounds.min[axis], point[axis]);
+            bounds.max[axis] = std::max(bounds.max[axis], point[axis]);
+        }
+    };
+
+    // The kernels leave vertices without influences at the origin
+    if (!vertex_buckets.buckets.empty() && vertex_buckets.buckets.front().influence_count == 0)
+    {
+        const float origin[3] = { 0.f, 0.f, 0.f };
+        include(origin);
+    }
+
+    // Morph targets can move a vertex past its joints' rest boxes by at most their weighted extents
+    HMM_Vec3 morph_reach = HMM_V3(0.f, 0.f, 0.f);
+    for (size_t target = 0; target < morph_streams.target_count(); target++)
+    {
+        morph_reach = HMM_AddV3(morph_reach, HMM_MulV3F(morph_streams.target_extents[target],
+                                                        std::abs(skin_data.morph_weights[target])));
+    }
+
+    for (size_t joint_id = 0; joint_id < skin_data.joint_rest_bounds.size(); joint_id++)
+    {
+        if (skin_data.joint_rest_bounds[joint_id].empty())
+            continue;
+
+        JointBounds rest = skin_data.joint_rest_bounds[joint_id];
+        rest.min = HMM_SubV3(rest.min, morph_reach);
+        rest.max = HMM_AddV3(rest.max, morph_reach);
+
+        const HMM_Mat4 matrix = MathFacade::multiply(world_transform,
+            MathFacade::multiply(pose_matrices[joint_id], skin_data.inverse_bind_matrices[joint_id]));
+
+        // The kernels drop w, so even projective matrices move the box's center and grow its
+        // half extents by the |M| of their top three rows (Arvo's method)
+        const float center[3] = { (rest.min.X + rest.max.X) * .5f, (rest.min.Y + rest.max.Y) * .5f,
+                                  (rest.min.Z + rest.max.Z) * .5f };
+        const float extent[3] = { (rest.max.X - rest.min.X) * .5f, (rest.max.Y - rest.min.Y) * .5f,
+                                  (rest.max.Z - rest.min.Z) * .5f };
+        float low[3];
+        float high[3];
+        for (int row = 0; row < 3; row++)
+        {
+            float moved_center = matrix.Elements[3][row];
+            float moved_extent = 0.f;
+            for (int column = 0; column < 3; column++)
+            {
+                moved_center += matrix.Elements[column][row] * center[column];
+                moved_extent += std::abs(matrix.Elements[column][row]) * extent[column];
+            }
+            low[row] = moved_center - moved_extent;
+            high[row] = moved_center + moved_extent;
+        }
+        include(low);
+        include(high);
+    }
+    return true;
+}
+
+void MeshSkinner::set_bounds_tracking(bool enabled)
+{
+    bounds_tracking = enabled;
+}
+
+bool MeshSkinner::is_bounds_tracking() const
+{
+    return bounds_tracking;
+}
+
+size_t MeshSkinner::get_thread_count() const
+{
+    return thread_pool->get_thread_count();
+}
+
+void MeshSkinner::set_grain_size(size_t vertex_count)
+{
+    // Tasks must cover whole influence chunks
+    constexpr size_t CHUNK_SIZE = InfluenceStreams::CHUNK_SIZE;
+    grain_size = std::max<size_t>(1, (vertex_count + CHUNK_SIZE - 1) / CHUNK_SIZE) * CHUNK_SIZE;
+
+    skinning_blocks = split_buckets(grain_size);
+
+    // The blocks changed shape, so they may now be skinned by other nodes
+    place_streams_on_nodes();
+}
+
+size_t MeshSkinner::get_grain_size() const
+{
+    return grain_size;
+}
+
+SkinningKernels::InstructionSet MeshSkinner::get_instruction_set() const
+{
+    return kernels->instruction_set;
+}
+
+void MeshSkinner::set_skinning_method(SkinningMethod method)
+{
+    if (method != skinning_method)
+    {
+        skinned_palette.clear();
+    }
+    skinning_method = method;
+}
+
+SkinningMethod MeshSkinner::get_skinning_method() const
+{
+    return skinning_method;
+}
+
+bool MeshSkinner::set_weight_precision(WeightPrecision precision)
+{
+    try
+    {
+        // Fails up front on rigs too large for compact joint IDs
+        InfluenceStreams::select_encoding(precision, referenced_joint_count);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Cannot change the weight precision: " << e.what() << std::endl;
+        return false;
+    }
+
+    if (precision != weight_precision)
+    {
+        weight_precision = precision;
+        build_skinning_streams();
+    }
+    return true;
+}
+
+WeightPrecision MeshSkinner::get_weight_precision() const
+{
+    return weight_precision;
+}
+
+InfluenceEncoding MeshSkinner::get_influence_encoding() const
+{
+    return influence_streams.encoding;
+}
+
+float MeshSkinner::measure_quantization_error() const
+{
+    const SparseWeights& weights = skin_data.sparse_weights;
+    if (influence_streams.encoding == InfluenceEncoding::Float32 ||
+        influence_streams.count != weights.vertex_count() ||
+        skin_data.pose_matrices.size() < referenced_joint_count ||
+        skin_data.inverse_bind_matrices.size() < referenced_joint_count)
+    {
+        return 0.f;
+    }
+
+    std::vector<HMM_Mat4> skinning_matrices;
+    compute_skinning_matrices(skin_data.pose_matrices, skinning_matrices);
+
+    // Skin the difference between the quantized and float weights, tracking the largest per task
+    constexpr size_t CHUNK_SIZE = InfluenceStreams::CHUNK_SIZE;
+    const size_t entry_count = vertex_buckets.padded_count();
+    std::vector<float> max_errors((entry_count + grain_size - 1) / grain_size, 0.f);
+    thread_pool->parallel_for(0, entry_count, grain_size, [&](size_t begin, size_t end)
+    {
+        float max_error_sq = 0.f;
+        for (size_t i = begin; i < end; i++)
+        {
+            const uint32_t vertex = vertex_buckets.order[i];
+            if (vertex == VertexBuckets::PADDING)
+                continue;
+
+            const HMM_Vec4 position =
+                HMM_V4(rest_positions.x[i], rest_positions.y[i], rest_positions.z[i], 1.f);
+            const size_t base = influence_streams.chunk_offsets[i / CHUNK_SIZE] + i % CHUNK_SIZE;
+
+            // The vertex's slots hold its real influences in order
+            HMM_Vec4 difference = HMM_V4(0.f, 0.f, 0.f, 0.f);
+            size_t slot = 0;
+            for (size_t entry = weights.offsets[vertex]; entry < weights.offsets[vertex + 1]; entry++)
+            {
+                if (weights.weights[entry] < WEIGHT_THRESHOLD || weights.joint_ids[entry] < 0)
+                    continue;
+
+                const float weight_error =
+                    influence_streams.weight(base + slot++ * CHUNK_SIZE) - weights.weights[entry];
+                difference = HMM_AddV4(difference, HMM_MulV4F(
+                    HMM_MulM4V4(skinning_matrices[weights.joint_ids[entry]], position), weight_error));
+            }
+            max_error_sq = std::max(max_error_sq, HMM_DotV3(difference.XYZ, difference.XYZ));
+        }
+        max_errors[begin / grain_size] = std::sqrt(max_error_sq);
+    });
+
+    float max_error = 0.f;
+    for (const float task_max_error : max_errors)
+    {
+        max_error = std::max(max_error, task_max_error);
+    }
+    return max_error;
+}
+
+bool MeshSkinner::load_mesh(const std::string& mesh_path)
+{
+    try
+    {
+        // Load mesh from OBJ file
+        original_mesh = ObjFacade::load_obj_mesh(mesh_path);
+        // Start with a clean canvas
+        skinned_mesh = original_mesh;
+
+        // Split positions into SIMD-friendly streams once, at load time
+        build_skinning_streams();
+
+        std::cout << "Loaded mesh with " << original_mesh.vertices.size() 
+                  << " vertices from OBJ.\n";
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to load mesh: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool MeshSkinner::load_weights(const std::string& weights_path)
+{
+    try 
+    {
+        // Load JSON weights data
+        const Json json_data = JsonFacade::load_from_file(weights_path);
+        
+        // Parse weights data, keeping every influence of every vertex, then clean it up once
+        skin_data.sparse_weights = bake_weights(SkinningData::parse_sparse_weights_from_json(json_data));
+
+        // Bucket the vertices by influence count and repack into SIMD-friendly streams
+        build_skinning_streams();
+
+        std::cout << "Loaded skinning weights for " << skin_data.sparse_weights.vertex_count()
+                  << " vertices (up to " << skin_data.sparse_weights.max_influences()
+                  << " influences per vertex, " << vertex_buckets.buckets.size()
+                  << " influence buckets).\n";
+        if (influence_streams.encoding != InfluenceEncoding::Float32)
+        {
+            std::cout << "Packed weights into " << encoding_description(influence_streams.encoding)
+                      << " (" << InfluenceStreams::bytes_per_influence(influence_streams.encoding)
+                      << " bytes per influence instead of "
+                      << InfluenceStreams::bytes_per_influence(InfluenceEncoding::Float32) << ").\n";
+        }
+        if (meshlet_tiling)
+        {
+            std::cout << "Tiled the vertices into " << meshlets.meshlets.size() << " meshlets (up to "
+                      << meshlets.max_joint_count() << " joints each).\n";
+        }
+        return true;
+    } 
+    catch (const std::exception& e) 
+    {
+        std::cerr << "Failed to load weights: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool MeshSkinner::load_inverse_bind_matrices(const std::string& inv_bind_path)
+{
+    try
+    {
+        // Load JSON from file
+        const Json json_data = JsonFacade::load_from_file(inv_bind_path);
+        
+        // Parse matrices
+        skin_data.inverse_bind_matrices = SkinningData::parse_matrices_from_json(json_data);
+
+        std::cout << "Loaded " << skin_data.inverse_bind_matrices.size() 
+                  << " inverse bind matrices.\n";
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to load inverse bind matrices: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool MeshSkinner::load_output_pose_matrices(const std::string& pose_path)
+{
+    try
+    {
+        // Load JSON from file
+        const Json json_data = JsonFacade::load_from_file(pose_path);
+        
+        // Parse matrices
+        skin_data.pose_matrices = SkinningData::parse_matrices_from_json(json_data);
+
+        std::cout << "Loaded " << skin_data.pose_matrices.size() 
+                  << " pose matrices.\n";
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to load pose matrices: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void MeshSkinner::set_output_pose_matrices(const std::vector<HMM_Mat4>& pose_matrices)
+{
+    skin_data.pose_matrices = pose_matrices;
+}
+
+bool MeshSkinner::load_skeleton(const std::string& skeleton_path)
+{
+    try
+    {
+        skin_data.skeleton = SkinningData::parse_skeleton_from_json(
+            JsonFacade::load_from_file(skeleton_path));
+
+        std::cout << "Loaded skeleton with " << skin_data.skeleton.joint_count() << " joints in "
+                  << skin_data.skeleton.level_count() << " hierarchy levels.\n";
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to load skeleton: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool MeshSkinner::set_skeleton(const std::vector<int32_t>& parents)
+{
+    try
+    {
+        skin_data.skeleton = Skeleton::from_parents(parents);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Invalid skeleton: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool MeshSkinner::load_local_pose(const std::string& pose_path)
+{
+    try
+    {
+        const std::vector<JointTransform> local_transforms =
+            SkinningData::parse_joint_transforms_from_json(JsonFacade::load_from_file(pose_path));
+        if (!set_local_pose(local_transforms))
+        {
+            return false;
+        }
+
+        std::cout << "Loaded local transforms for " << local_transforms.size() << " joints.\n";
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to load local pose: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool MeshSkinner::set_local_pose(const std::vector<JointTransform>& local_transforms)
+{
+    if (skin_data.skeleton.joint_count() == 0)
+    {
+        std::cerr << "No skeleton loaded\n";
+        return false;
+    }
+
+    if (local_transforms.size() != skin_data.skeleton.joint_count())
+    {
+        std::cerr << "Local transform count (" << local_transforms.size()
+                  << ") doesn't match joint count (" << skin_data.skeleton.joint_count() << ")\n";
+        return false;
+    }
+
+    evaluate_skeleton(local_transforms, skin_data.pose_matrices);
+    return true;
+}
+
+bool MeshSkinner::load_animation_clip(const std::string& clip_path)
+{
+    try
+    {
+        skin_data.animation_clip = SkinningData::parse_animation_clip_from_json(
+            JsonFacade::load_from_file(clip_path));
+
+        std::cout << "Loaded animation clip with " << skin_data.animation_clip.key_times.size()
+                  << " keys for " << skin_data.animation_clip.joint_count() << " joints ("
+                  << skin_data.animation_clip.duration() << " seconds).\n";
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to load animation clip: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void MeshSkinner::set_animation_clip(const AnimationClip& clip)
+{
+    skin_data.animation_clip = clip;
+}
+
+float MeshSkinner::get_animation_duration() const
+{
+    return skin_data.animation_clip.duration();
+}
+
+bool MeshSkinner::sample_animation_clip(float time)
+{
+    return sample_clip_pose(time, skin_data.pose_matrices);
+}
+
+bool MeshSkinner::sample_animation_sequence(float frame_rate)
+{
+    if (!(frame_rate > 0.f) || !std::isfinite(frame_rate))
+    {
+        std::cerr << "Invalid frame rate: " << frame_rate << "\n";
+        return false;
+    }
+
+    const auto sampling_start = std::chrono::high_resolution_clock::now();
+
+    // One frame per period up to the last key; the tolerance keeps a key that falls exactly
+    // on the final frame from being lost to rounding
+    const float duration = skin_data.animation_clip.duration();
+    const size_t frame_count = static_cast<size_t>(std::floor(duration * frame_rate + .001f)) + 1;
+
+    std::vector<std::vector<HMM_Mat4>> frames(frame_count);
+    for (size_t frame = 0; frame < frame_count; frame++)
+    {
+        if (!sample_clip_pose(static_cast<float>(frame) / frame_rate, frames[frame]))
+        {
+            return false;
+        }
+    }
+    pose_sequence = std::move(frames);
+
+    const auto sampling_end = std::chrono::high_resolution_clock::now();
+    const std::chrono::duration<double, std::milli> sampling_duration = sampling_end - sampling_start;
+    record_timing("Clip Sampling", sampling_duration.count());
+    record_timing("Clip Sampling (per frame)", sampling_duration.count() / frame_count);
+
+    std::cout << "Sampled " << frame_count << " frames at " << frame_rate << " fps from the animation clip.\n";
+    return true;
+}
+
+bool MeshSkinner::load_morph_targets(const std::string& morph_targets_path)
+{
+    try
+    {
+        const Json json_data = JsonFacade::load_from_file(morph_targets_path);
+        if (!set_morph_targets(SkinningData::parse_morph_targets_from_json(json_data)) ||
+            !set_morph_weights(SkinningData::parse_morph_weights_from_json(json_data)))
+        {
+            return false;
+        }
+
+        std::cout << "Loaded " << skin_data.morph_targets.target_count() << " morph targets ("
+                  << skin_data.morph_targets.delta_count() << " vertex deltas).\n";
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to load morph targets: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool MeshSkinner::set_morph_targets(const MorphTargets& targets)
+{
+    // Targets set before the mesh is loaded are checked once the streams are built
+    if (!original_mesh.vertices.empty())
+    {
+        for (const uint32_t vertex : targets.vertex_indices)
+        {
+            if (vertex >= original_mesh.vertices.size())
+            {
+                std::cerr << "Morph targets move vertex " << vertex << " but the mesh has "
+                          << original_mesh.vertices.size() << " vertices\n";
+                return false;
+            }
+        }
+    }
+
+    skin_data.morph_targets = targets;
+    skin_data.morph_weights.assign(targets.target_count(), 0.f);
+    build_morph_streams();
+    place_streams_on_nodes();
+    return true;
+}
+
+bool MeshSkinner::set_morph_weights(const std::vector<float>& weights)
+{
+    if (weights.size() != skin_data.morph_targets.target_count())
+    {
+        std::cerr << "Morph weight count (" << weights.size() << ") doesn't match target count ("
+                  << skin_data.morph_targets.target_count() << ")\n";
+        return false;
+    }
+
+    for (const float weight : weights)
+    {
+        if (!std::isfinite(weight))
+        {
+            std::cerr << "Morph weights must be finite\n";
+            return false;
+        }
+    }
+
+    skin_data.morph_weights = weights;
+    return true;
+}
+
+size_t MeshSkinner::get_morph_target_count() const
+{
+    return skin_data.morph_targets.target_count();
+}
+
+bool MeshSkinner::load_pose_sequence(const std::string& sequence_path)
+{
+    namespace fs = std::filesystem;
+
+    try
+    {
+        // Resolve the path into an ordered list of pose files
+        std::vector<fs::path> pose_files;
+        const fs::path path(sequence_path);
+        const std::string file_pattern = path.filename().string();
+
+        if (fs::is_directory(path))
+        {
+            for (const fs::directory_entry& entry : fs::directory_iterator(path))
+            {
+                if (entry.is_regular_file() && entry.path().extension() == ".json")
+                    pose_files.push_back(entry.path());
+            }
+        }
+        else if (file_pattern.find_first_of("*?") != std::string::npos)
+        {
+            const fs::path directory = path.has_parent_path() ? path.parent_path() : fs::path(".");
+            for (const fs::directory_entry& entry : fs::directory_iterator(directory))
+            {
+                if (entry.is_regular_file() &&
+                    matches_wildcard(entry.path().filename().string(), file_pattern))
+                    pose_files.push_back(entry.path());
+            }
+        }
+        else
+        {
+            pose_files.push_back(path);
+        }
+
+        std::sort(pose_files.begin(), pose_files.end(), [](const fs::path& a, const fs::path& b)
+        {
+            return natural_less(a.string(), b.string());
+        });
+
+        // A pose track is decoded frame by frame straight from the mapping
+        if (pose_files.size() == 1 && pose_files[0].extension() == ".mska")
+        {
+            PoseTrack track;
+            track.open(pose_files[0].string());
+            std::vector<std::vector<HMM_Mat4>> frames(track.frame_count());
+            thread_pool->parallel_for(0, frames.size(), TRACK_DECODE_BLOCK_SIZE, [&](size_t first, size_t last)
+            {
+                for (size_t frame = first; frame < last; frame++)
+                    track.decode_frame(frame, frames[frame]);
+            });
+
+            if (frames.empty())
+            {
+                std::cerr << "No poses found in: " << sequence_path << std::endl;
+                return false;
+            }
+
+            pose_sequence = std::move(frames);
+            std::cout << "Decoded " << pose_sequence.size() << " poses from pose track.\n";
+            return true;
+        }
+
+        // Each file holds one palette or an array of palettes; files are parsed concurrently
+        std::vector<std::vector<std::vector<HMM_Mat4>>> file_poses(pose_files.size());
+        thread_pool->parallel_for(0, pose_files.size(), 1, [&](size_t first, size_t last)
+        {
+            for (size_t file = first; file < last; file++)
+            {
+                const Json json_data = JsonFacade::load_from_file(pose_files[file].string());
+                file_poses[file] = SkinningData::parse_pose_sequence_from_json(json_data);
+            }
+        });
+
+        // Frames follow file order
+        pose_sequence.clear();
+        for (std::vector<std::vector<HMM_Mat4>>& poses : file_poses)
+        {
+            pose_sequence.insert(pose_sequence.end(),
+                                 std::make_move_iterator(poses.begin()),
+                                 std::make_move_iterator(poses.end()));
+        }
+
+        if (pose_sequence.empty())
+        {
+            std::cerr << "No poses found in: " << sequence_path << std::endl;
+            return false;
+        }
+
+        std::cout << "Loaded " << pose_sequence.size() << " poses from "
+                  << pose_files.size() << " file(s).\n";
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to load pose sequence: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+size_t MeshSkinner::get_pose_sequence_length() const
+{
+    return pose_sequence.size();
+}
+
+bool MeshSkinner::save_pose_track(const std::string& track_path) const
+{
+    if (pose_sequence.empty())
+    {
+        std::cerr << "No pose sequence loaded\n";
+        return false;
+    }
+
+    try
+    {
+        const size_t track_size = PoseTrack::save(track_path, pose_sequence);
+        const size_t raw_size = pose_sequence.size() * pose_sequence[0].size() * sizeof(HMM_Mat4);
+        std::cout << "Packed " << pose_sequence.size() << " poses into " << track_path << " ("
+                  << track_size << " bytes, " << (100.0 * track_size / raw_size)
+                  << "% of the float matrices).\n";
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to save pose track: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool MeshSkinner::load_pose_track(const std::string& track_path)
+{
+    try
+    {
+        pose_track.open(track_path);
+
+        std::cout << "Mapped pose track with " << pose_track.frame_count() << " frames of "
+                  << pose_track.joint_count() << " joints.\n";
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to load pose track: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+size_t MeshSkinner::get_pose_track_length() const
+{
+    return pose_track.frame_count();
+}
+
+bool MeshSkinner::set_pose_track_frame(size_t frame)
+{
+    if (!pose_track.is_open())
+    {
+        std::cerr << "No pose track loaded\n";
+        return false;
+    }
+
+    try
+    {
+        pose_track.decode_frame(frame, skin_data.pose_matrices);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to decode pose track frame: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool MeshSkinner::perform_sequence_skinning()
+{
+    if (pose_sequence.empty())
+    {
+        std::cerr << "No pose sequence loaded\n";
+        return false;
+    }
+
+    return perform_batch_skinning(pose_sequence);
+}
+
+bool MeshSkinner::save_skinned_sequence(const std::string& output_path)
+{
+    if (batch_positions.empty())
+    {
+        std::cerr << "No skinned frames to save\n";
+        return false;
+    }
+
+    const auto save_start = std::chrono::high_resolution_clock::now();
+
+    const size_t frame_count = batch_positions.size();
+
+    // Formatting OBJ text dominates, so frames are written concurrently
+    std::atomic<size_t> failures(0);
+    thread_pool->parallel_for(0, frame_count, 1, [&](size_t first, size_t last)
+    {
+        for (size_t frame = first; frame < last; frame++)
+        {
+            try
+            {
+                Mesh frame_mesh = original_mesh;
+                batch_positions[frame].to_vertices(frame_mesh.vertices, vertex_buckets);
+
+                if (!ObjFacade::save_obj_mesh(get_frame_path(output_path, frame), frame_mesh))
+                    failures++;
+            }
+            catch (const std::exception&)
+            {
+                failures++;
+            }
+        }
+    });
+
+    const auto save_end = std::chrono::high_resolution_clock::now();
+    const std::chrono::duration<double, std::milli> save_duration = save_end - save_start;
+    record_timing("Save Sequence", save_duration.count());
+
+    if (failures > 0)
+    {
+        std::cerr << "Failed to save " << failures << " of " << frame_count << " frames.\n";
+        return false;
+    }
+
+    std::cout << "Saved " << frame_count << " frames to: " << get_frame_path(output_path, 0)
+              << " .. " << get_frame_path(output_path, frame_count - 1) << std::endl;
+    return true;
+}
+
+std::string MeshSkinner::get_frame_path(const std::string& output_path, size_t frame_index)
+{
+    const std::filesystem::path path(output_path);
+
+    char frame_suffix[32];
+    std::snprintf(frame_suffix, sizeof(frame_suffix), "_%04zu", frame_index);
+
+    std::filesystem::path frame_path = path.parent_path();
+    frame_path /= path.stem().string() + frame_suffix + path.extension().string();
+    return frame_path.string();
+}
+
+bool MeshSkinner::perform_skinning()
+{
+    if (!validate_skinning_data())
+    {
+        return false;
+    }
+
+    if (!validate_pose_matrices(skin_data.pose_matrices))
+    {
+        return false;
+    }
+
+    // Precompute skinning matrices for each joint (pose * inverse bind)
+    compute_skinning_matrices(skin_data.pose_matrices, pose_skinning_matrices);
+
+    std::cout << "Applying vertex transformations ("
+              << (skinning_method == SkinningMethod::DualQuaternion ? "dual quaternion" : "linear blend")
+              << ", " << SkinningKernels::instruction_set_name(kernels->instruction_set) << ")...\n";
+
+    // Apply transformations using the precomputed matrices (with timing)
+    const auto apply_start = std::chrono::high_resolution_clock::now();
+    const size_t reskinned = apply_vertex_transformations(
+        pose_skinning_matrices, PositionBuffer::from_vertices(skinned_mesh.vertices));
+    const auto apply_end = std::chrono::high_resolution_clock::now();
+
+    if (reskinned < vertex_buckets.padded_count())
+    {
+        std::cout << "Only re-skinned the " << reskinned << " of " << vertex_buckets.padded_count()
+                  << " entries moved by joints changed since the last pose\n";
+    }
+
+    const std::chrono::duration<double, std::milli> apply_duration = apply_end - apply_start;
+    record_timing("Apply Transformations", apply_duration.count());
+
+    if (bounds_tracking)
+    {
+        std::cout << std::defaultfloat << "Skinned bounds: box (" << skinned_box.min[0] << ", "
+                  << skinned_box.min[1] << ", " << skinned_box.min[2] << ") to ("
+                  << skinned_box.max[0] << ", " << skinned_box.max[1] << ", " << skinned_box.max[2]
+                  << "), sphere of radius " << skinned_sphere.radius << "\n";
+    }
+
+    std::cout << "Skinning completed successfully\n";
+    return true;
+}
+
+bool MeshSkinner::perform_skinning(const PositionBuffer& output)
+{
+    return skin_pose(skin_data.pose_matrices, output);
+}
+
+void MeshSkinner::set_output_slot_count(size_t slot_count)
+{
+    // In-flight submissions keep writing to the slots they were queued with
+    wait_for_submissions();
+    async_skinning->slots = make_output_slots(slot_count);
+}
+
+size_t MeshSkinner::get_output_slot_count() const
+{
+    return async_skinning->slots->buffers.size();
+}
+
+std::future<MeshSkinner::SkinnedFrame> MeshSkinner::submit_skinning(std::vector<HMM_Mat4> pose_matrices)
+{
+    AsyncSkinning::Submission submission;
+    submission.pose_matrices = std::move(pose_matrices);
+    submission.slots = async_skinning->slots;
+    std::future<SkinnedFrame> frame = submission.frame.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(async_skinning->mutex);
+        async_skinning->queue.push_back(std::move(submission));
+        async_skinning->pending++;
+    }
+
+    // Start the skinning thread with the first submission
+    if (!async_thread.joinable())
+    {
+        async_thread = std::thread(&MeshSkinner::run_submissions, this);
+    }
+    async_skinning->submitted.notify_one();
+
+    return frame;
+}
+
+void MeshSkinner::wait_for_submissions()
+{
+    std::unique_lock<std::mutex> lock(async_skinning->mutex);
+    async_skinning->finished.wait(lock, [this]() { return async_skinning->pending == 0; });
+}
+
+void MeshSkinner::run_submissions()
+{
+    AsyncSkinning& async = *async_skinning;
+
+    while (true)
+    {
+        AsyncSkinning::Submission submission;
+        {
+            std::unique_lock<std::mutex> lock(async.mutex);
+            async.submitted.wait(lock, [&async]() { return async.stopping || !async.queue.empty(); });
+            if (async.stopping)
+            {
+                return;
+            }
+            submission = std::move(async.queue.front());
+            async.queue.pop_front();
+        }
+
+        // Wait until the caller releases a frame if every slot is still held
+        const std::shared_ptr<OutputSlots> slots = submission.slots;
+        size_t slot = 0;
+        {
+            std::unique_lock<std::mutex> lock(slots->mutex);
+            slots->slot_released.wait(lock, [&]() { return async.stopping || find_free_slot(*slots, slot); });
+            if (async.stopping)
+            {
+                return;
+            }
+            slots->in_use[slot] = true;
+            slots->next_slot = (slot + 1) % slots->in_use.size();
+        }
+
+        // The slot is released when the last copy of the frame handle goes away
+        std::vector<Vertex>& buffer = slots->buffers[slot];
+        SkinnedFrame frame(&buffer, [slots, slot](const std::vector<Vertex>*)
+        {
+            {
+                std::lock_guard<std::mutex> lock(slots->mutex);
+                slots->in_use[slot] = false;
+            }
+            slots->slot_released.notify_all();
+        });
+
+        try
+        {
+            // Only positions are skinned; the rest of each vertex is seeded once per slot
+            if (buffer.size() != original_mesh.vertices.size())
+            {
+                buffer = original_mesh.vertices;
+            }
+
+            if (!skin_pose(submission.pose_matrices, PositionBuffer::from_vertices(buffer)))
+            {
+                throw std::runtime_error("Failed to skin the submitted pose");
+            }
+            submission.frame.set_value(std::move(frame));
+        }
+        catch (...)
+        {
+            submission.frame.set_exception(std::current_exception());
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(async.mutex);
+            async.pending--;
+        }
+        async.finished.notify_all();
+    }
+}
+
+bool MeshSkinner::perform_batch_skinning(const std::vector<std::vector<HMM_Mat4>>& pose_palettes)
+{
+    if (!validate_skinning_data())
+    {
+        return false;
+    }
+
+    if (pose_palettes.empty())
+    {
+        std::cerr << "No pose palettes given for batch skinning\n";
+        return false;
+    }
+
+    for (const std::vector<HMM_Mat4>& pose_matrices : pose_palettes)
+    {
+        if (!validate_pose_matrices(pose_matrices))
+        {
+            return false;
+        }
+    }
+
+    std::cout << "Skinning " << pose_palettes.size() << " poses ("
+              << (skinning_method == SkinningMethod::DualQuaternion ? "dual quaternion" : "linear blend")
+              << ", " << SkinningKernels::instruction_set_name(kernels->instruction_set) << ")...\n";
+
+    const auto batch_start = std::chrono::high_resolution_clock::now();
+
+    // Build one palette and one kernel job per pose, each writing its own output streams
+    const size_t pose_count = pose_palettes.size();
+    std::vector<std::vector<HMM_Mat4>> precomputed_matrices(pose_count);
+    std::vector<ConvertedPalette> converted_palettes(pose_count);
+    std::vector<ConvertedPalette> meshlet_palettes(meshlet_tiling ? pose_count : 0);
+    std::vector<SkinningKernels::SkinningJob> jobs(pose_count);
+
+    // Every pose of a block reads the same morphed rest positions, so they are morphed up front
+    const VertexStreams& morphed_rest = sync_morphed_positions();
+
+    batch_positions.resize(pose_count);
+    for (size_t pose = 0; pose < pose_count; pose++)
+    {
+        batch_positions[pose].resize(vertex_buckets);
+        compute_skinning_matrices(pose_palettes[pose], precomputed_matrices[pose]);
+
+        jobs[pose] = SkinningKernels::make_skinning_job(
+            morphed_rest, influence_streams, batch_positions[pose]);
+        bind_palette(precomputed_matrices[pose], converted_palettes[pose], jobs[pose]);
+        if (meshlet_tiling)
+            reserve_meshlet_palette(jobs[pose], meshlet_palettes[pose]);
+    }
+
+    // Tile the work as (vertex block x pose group): each task skins one block against
+    // several poses back to back, so its rest positions and weights are read from
+    // memory once and then served from cache
+    const std::vector<VertexBuckets::Bucket> blocks = split_buckets(BATCH_BLOCK_SIZE);
+    const size_t group_count = (pose_count + BATCH_POSE_GROUP_SIZE - 1) / BATCH_POSE_GROUP_SIZE;
+
+    thread_pool->parallel_for(0, blocks.size() * group_count, 1, [&](size_t first, size_t last)
+    {
+        for (size_t tile = first; tile < last; tile++)
+        {
+            const VertexBuckets::Bucket& block = blocks[tile / group_count];
+            const size_t group = tile % group_count;
+
+            const size_t first_pose = group * BATCH_POSE_GROUP_SIZE;
+            const size_t last_pose = std::min(first_pose + BATCH_POSE_GROUP_SIZE, pose_count);
+
+            for (size_t pose = first_pose; pose < last_pose; pose++)
+            {
+                if (meshlet_tiling)
+                {
+                    const Meshlets::Meshlet& meshlet =
+                        meshlets.meshlets[meshlets.meshlet_of(block.begin)];
+                    select_kernel(block.influence_count)(
+                        bind_meshlet_palette(jobs[pose], meshlet, meshlet_palettes[pose]),
+                        block.begin, block.end);
+                }
+                else
+                {
+                    select_kernel(block.influence_count)(
+                        jobs[pose], block.begin, block.end);
+                }
+            }
+        }
+    });
+
+    const auto batch_end = std::chrono::high_resolution_clock::now();
+    const std::chrono::duration<double, std::milli> batch_duration = batch_end - batch_start;
+    record_timing("Batch Skinning", batch_duration.count());
+    record_timing("Batch Skinning (per pose)", batch_duration.count() / pose_count);
+
+    std::cout << "Batch skinning completed successfully\n";
+    return true;
+}
+
+bool MeshSkinner::perform_crowd_skinning(const std::vector<std::vector<HMM_Mat4>>& pose_palettes,
+                                         const std::vector<HMM_Mat4>& world_transforms,
+                                         const std::vector<PositionBuffer>& outputs)
+{
+    if (!validate_skinning_data())
+    {
+        return false;
+    }
+
+    if (world_transforms.size() != pose_palettes.size() || outputs.size() != pose_palettes.size())
+    {
+        std::cerr << "Crowd skinning needs one world transform and one output per pose palette ("
+                  << pose_palettes.size() << " palettes, " << world_transforms.size()
+                  << " transforms, " << outputs.size() << " outputs)\n";
+        return false;
+    }
+
+    for (size_t instance = 0; instance < pose_palettes.size(); instance++)
+    {
+        if (!validate_pose_matrices(pose_palettes[instance]) || !validate_output_buffer(outputs[instance]))
+        {
+            return false;
+        }
+
+        // Instances are scattered block by block, before the whole frame's bounds are known
+        if (outputs[instance].format == PositionFormat::Unorm16)
+        {
+            std::cerr << "Crowd outputs cannot be normalized to the frame's bounds\n";
+            return false;
+        }
+    }
+
+    const size_t instance_count = pose_palettes.size();
+    if (instance_count == 0)
+    {
+        return true;
+    }
+
+    const auto crowd_start = std::chrono::high_resolution_clock::now();
+
+    // Each group of instances skins into its own scratch streams, so there is one copy of the
+    // skinned positions per thread however large the crowd is
+    const size_t group_count = std::min(instance_count, thread_pool->get_thread_count());
+    std::vector<VertexStreams> group_positions(group_count);
+    for (VertexStreams& positions : group_positions)
+    {
+        positions.resize(vertex_buckets);
+    }
+
+    // Every instance shares the morph weights, so the rest positions are morphed once up front
+    const VertexStreams& morphed_rest = sync_morphed_positions();
+
+    // Linear blending commutes with the world transform, so it is folded into each palette:
+    // world * pose * inverse bind. Dual quaternions would strip its scale and shear, so under
+    // dual quaternion skinning it is applied to each block after the kernel instead.
+    const bool placed_after_skinning = skinning_method == SkinningMethod::DualQuaternion;
+    std::vector<std::vector<HMM_Mat4>> skinning_matrices(instance_count);
+    std::vector<ConvertedPalette> converted_palettes(instance_count);
+    std::vector<ConvertedPalette> meshlet_palettes(meshlet_tiling ? instance_count : 0);
+    std::vector<SkinningKernels::SkinningJob> jobs(instance_count);
+    std::vector<AffineMatrix> placements(placed_after_skinning ? instance_count : 0);
+
+    thread_pool->parallel_for(0, instance_count, 1, [&](size_t first, size_t last)
+    {
+        for (size_t instance = first; instance < last; instance++)
+        {
+            compute_skinning_matrices(pose_palettes[instance], skinning_matrices[instance]);
+            if (placed_after_skinning)
+            {
+                placements[instance] = MathFacade::to_affine(world_transforms[instance]);
+            }
+            else
+            {
+                for (HMM_Mat4& matrix : skinning_matrices[instance])
+                {
+                    matrix = MathFacade::multiply(world_transforms[instance], matrix);
+                }
+            }
+
+            jobs[instance] = SkinningKernels::make_skinning_job(
+                morphed_rest, influence_streams, group_positions.front());
+            bind_palette(skinning_matrices[instance], converted_palettes[instance], jobs[instance]);
+            if (meshlet_tiling)
+                reserve_meshlet_palette(jobs[instance], meshlet_palettes[instance]);
+        }
+    });
+
+    // Tile the work as (group x vertex block): each task skins one block for every instance of
+    // its group while the block's rest positions and weights are in cache, and scatters each
+    // instance into its output right away
+    const std::vector<VertexBuckets::Bucket>& blocks = skinning_blocks;
+    thread_pool->parallel_for(0, group_count * blocks.size(), 1, [&](size_t first, size_t last)
+    {
+        for (size_t tile = first; tile < last; tile++)
+        {
+            const size_t group = tile / blocks.size();
+            const VertexBuckets::Bucket& block = blocks[tile % blocks.size()];
+            VertexStreams& positions = group_positions[group];
+
+            const size_t first_instance = group * instance_count / group_count;
+            const size_t last_instance = (group + 1) * instance_count / group_count;
+            for (size_t instance = first_instance; instance < last_instance; instance++)
+            {
+                SkinningKernels::SkinningJob job = jobs[instance];
+                if (meshlet_tiling)
+                {
+                    job = bind_meshlet_palette(job, meshlets.meshlets[meshlets.meshlet_of(block.begin)],
+                                               meshlet_palettes[instance]);
+                }
+                job.skinned_x = positions.x.data();
+                job.skinned_y = positions.y.data();
+                job.skinned_z = positions.z.data();
+
+                select_kernel(block.influence_count)(job, block.begin, block.end);
+                if (placed_after_skinning)
+                {
+                    place_positions(placements[instance], positions, block.begin, block.end);
+                }
+                positions.to_positions(outputs[instance], vertex_buckets, block.begin, block.end);
+            }
+        }
+    });
+
+    const auto crowd_end = std::chrono::high_resolution_clock::now();
+    const std::chrono::duration<double, std::milli> crowd_duration = crowd_end - crowd_start;
+    record_timing("Crowd Skinning", crowd_duration.count());
+    record_timing("Crowd Skinning (per instance)", crowd_duration.count() / instance_count);
+    return true;
+}
+
+size_t MeshSkinner::get_batch_size() const
+{
+    return batch_positions.size();
+}
+
+void MeshSkinner::get_batch_vertices(size_t pose_index, std::vector<Vertex>& vertices) const
+{
+    batch_positions.at(pose_index).to_vertices(vertices, vertex_buckets);
+}
+
+bool MeshSkinner::save_batch_skinned_mesh(size_t pose_index, const std::string& output_path) const
+{
+    try
+    {
+        // Reuse the topology of the original mesh with this pose's positions
+        Mesh pose_mesh = original_mesh;
+        batch_positions.at(pose_index).to_vertices(pose_mesh.vertices, vertex_buckets);
+
+        if (!ObjFacade::save_obj_mesh(output_path, pose_mesh))
+        {
+            std::cerr << "Failed to save skinned mesh to OBJ.\n";
+            return false;
+        }
+        std::cout << "Saved skinned mesh to: " << output_path << std::endl;
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to save skinned mesh: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+const Mesh& MeshSkinner::get_skinned_mesh() const
+{
+    return skinned_mesh;
+}
+
+const PositionBounds& MeshSkinner::get_skinned_box() const
+{
+    return skinned_box;
+}
+
+const BoundingSphere& MeshSkinner::get_skinned_sphere() const
+{
+    return skinned_sphere;
+}
+
+bool MeshSkinner::save_skinned_mesh(const std::string& output_path)
+{
+    try
+    {
+        if (!ObjFacade::save_obj_mesh(output_path, skinned_mesh))
+        {
+            std::cerr << "Failed to save skinned mesh to OBJ.\n";
+            return false;
+        }
+        std::cout << "Saved skinned mesh to: " << output_path << std::endl;
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to save skinned mesh: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void MeshSkinner::print_timing_metrics() const
+{
+    if (timing_metrics.empty())
+    {
+        std::cout << "No timing metrics available." << std::endl;
+        return;
+    }
+    
+    std::cout << "\n===== Performance Timing Metrics =====\n";
+    std::cout << std::left << std::setw(35) << "Operation" 
+              << std::right << std::setw(15) << "Time (ms)" << std::endl;
+    std::cout << std::string(50, '-') << std::endl;
+    
+    for (const auto& metric : timing_metrics)
+    {
+        std::cout << std::left << std::setw(35) << metric.first 
+                  << std::right << std::setw(15) << std::fixed << std::setprecision(3) 
+                  << metric.second << std::endl;
+    }
+    std::cout << std::string(50, '-') << std::endl;
+    std::cout << std::left << std::setw(35) << "Kernel Instruction Set"
+              << std::right << std::setw(15)
+              << SkinningKernels::instruction_set_name(kernels->instruction_set) << std::endl;
+    std::cout << std::left << std::setw(35) << "Worker Threads"
+              << std::right << std::setw(15) << thread_pool->get_thread_count() << std::endl;
+    if (numa_aware)
+    {
+        std::cout << std::left << std::setw(35) << "NUMA Nodes"
+                  << std::right << std::setw(15) << thread_pool->get_node_count() << std::endl;
+    }
+}
+
+bool MeshSkinner::skin_pose(const std::vector<HMM_Mat4>& pose_matrices, const PositionBuffer& output)
+{
+    if (!validate_skinning_data())
+    {
+        return false;
+    }
+
+    if (!validate_pose_matrices(pose_matrices))
+    {
+        return false;
+    }
+
+    if (!validate_output_buffer(output))
+    {
+        return false;
+    }
+
+    compute_skinning_matrices(pose_matrices, pose_skinning_matrices);
+    apply_vertex_transformations(pose_skinning_matrices, output);
+    return true;
+}
+
+size_t MeshSkinner::apply_vertex_transformations(const std::vector<HMM_Mat4>& precomputed_matrices,
+                                                 const PositionBuffer& output)
+{
+    // With morph targets, the kernels read the morphed rest positions, which each block
+    // brings up to date for its own chunks right before skinning them
+    const bool morphing = !morph_streams.empty();
+    SkinningKernels::SkinningJob job = SkinningKernels::make_skinning_job(
+        morphing ? morphed_positions : rest_positions, influence_streams, skinned_positions);
+
+    bind_palette(precomputed_matrices, converted_palette, job);
+
+    // Normalized positions need the frame's bounds before any of them is written, so the
+    // skinning pass records the bounds of every chunk it rewrites; unchanged chunks reuse theirs
+    constexpr size_t CHUNK_SIZE = InfluenceStreams::CHUNK_SIZE;
+    const bool normalized = output.format == PositionFormat::Unorm16;
+    const bool measured = normalized || bounds_tracking;
+    if (measured)
+    {
+        chunk_bounds.resize(influence_streams.chunk_offsets.size());
+        chunk_radii.resize(influence_streams.chunk_offsets.size());
+        if (!chunk_bounds_current)
+            skinned_palette.clear();
+    }
+
+    // Re-skin only the vertices of joints whose matrix changed since the last pose, if any;
+    // otherwise use every influence bucket split into fixed-size blocks (multiples of the SIMD width)
+    size_t changed_joints = 0;
+    const bool incremental =
+        find_changed_blocks(precomputed_matrices, changed_blocks, changed_joints);
+    const std::vector<VertexBuckets::Bucket>& blocks = incremental ? changed_blocks : skinning_blocks;
+
+    if (meshlet_tiling)
+        reserve_meshlet_palette(job, meshlet_palette);
+
+    // Unchanged vertices can only be skipped in the buffer that already holds them
+    const bool scatter_blocks = !normalized && (!incremental || output == synced_output);
+
+    // Parallel transform of each block of vertices, scattered back to original vertex order
+    // while the block is still in cache
+    thread_pool->parallel_for(0, blocks.size(), 1, [&](size_t first, size_t last)
+    {
+        for (size_t b = first; b < last; b++)
+        {
+            // Each block lies in one bucket, so it runs the kernel unrolled for its influence count
+            const VertexBuckets::Bucket& block = blocks[b];
+            if (morphing)
+            {
+                morph_streams.apply(skin_data.morph_weights.data(), rest_positions, morphed_positions,
+                                    block.begin, block.end);
+            }
+
+            if (meshlet_tiling)
+            {
+                const Meshlets::Meshlet& meshlet = meshlets.meshlets[meshlets.meshlet_of(block.begin)];
+                select_kernel(block.influence_count)(
+                    bind_meshlet_palette(job, meshlet, meshlet_palette), block.begin, block.end);
+            }
+            else
+            {
+                select_kernel(block.influence_count)(job, block.begin, block.end);
+            }
+
+            if (scatter_blocks)
+                skinned_positions.to_positions(output, vertex_buckets, block.begin, block.end);
+
+            if (measured)
+            {
+                for (size_t begin = block.begin; begin < block.end; begin += CHUNK_SIZE)
+                {
+                    const size_t end = std::min(begin + CHUNK_SIZE, block.end);
+                    const PositionBounds box = skinned_positions.bounds(vertex_buckets, begin, end);
+                    const float center[3] = { (box.min[0] + box.max[0]) * .5f,
+                                              (box.min[1] + box.max[1]) * .5f,
+                                              (box.min[2] + box.max[2]) * .5f };
+                    chunk_bounds[begin / CHUNK_SIZE] = box;
+                    chunk_radii[begin / CHUNK_SIZE] =
+                        skinned_positions.radius(vertex_buckets, begin, end, center);
+                }
+            }
+        }
+    });
+
+    if (measured)
+    {
+        merge_chunk_bounds();
+    }
+
+    if (normalized)
+    {
+        const PositionBounds& frame_bounds = skinned_box;
+        *output.bounds = frame_bounds;
+
+        // Every vertex moves in the buffer's encoding when the box does
+        const bool same_encoding =
+            incremental && output == synced_output && frame_bounds == synced_bounds;
+        const std::vector<VertexBuckets::Bucket>& scattered = same_encoding ? blocks : skinning_blocks;
+        thread_pool->parallel_for(0, scattered.size(), 1, [&](size_t first, size_t last)
+        {
+            for (size_t b = first; b < last; b++)
+            {
+                skinned_positions.to_positions(output, vertex_buckets,
+                                               scattered[b].begin, scattered[b].end);
+            }
+        });
+        synced_bounds = frame_bounds;
+    }
+    else if (!scatter_blocks)
+    {
+        thread_pool->parallel_for(0, skinning_blocks.size(), 1, [&](size_t first, size_t last)
+        {
+            for (size_t b = first; b < last; b++)
+            {
+                skinned_positions.to_positions(output, vertex_buckets,
+                                               skinning_blocks[b].begin, skinning_blocks[b].end);
+            }
+        });
+    }
+
+    skinned_palette = precomputed_matrices;
+    if (morphing)
+    {
+        morphed_weights = skin_data.morph_weights;
+        skinned_morph_weights = skin_data.morph_weights;
+    }
+    synced_output = output;
+    chunk_bounds_current = measured;
+
+    size_t reskinned = 0;
+    for (const VertexBuckets::Bucket& block : blocks)
+    {
+        reskinned += block.end - block.begin;
+    }
+    return reskinned;
+}
+
+void MeshSkinner::merge_chunk_bounds()
+{
+    skinned_box = chunk_bounds.front();
+    for (const PositionBounds& chunk : chunk_bounds)
+    {
+        for (int axis = 0; axis < 3; axis++)
+        {
+            skinned_box.min[axis] = std::min(skinned_box.min[axis], chunk.min[axis]);
+            skinned_box.max[axis] = std::max(skinned_box.max[axis], chunk.max[axis]);
+        }
+    }
+
+    // Center the sphere on the box and grow it over each chunk's sphere; the box's own
+    // circumscribed sphere caps the radius
+    float diagonal_squared = 0.f;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        skinned_sphere.center[axis] = (skinned_box.min[axis] + skinned_box.max[axis]) * .5f;
+        const float half_extent = (skinned_box.max[axis] - skinned_box.min[axis]) * .5f;
+        diagonal_squared += half_extent * half_extent;
+    }
+
+    float radius = 0.f;
+    for (size_t chunk = 0; chunk < chunk_bounds.size(); chunk++)
+    {
+        const PositionBounds& box = chunk_bounds[chunk];
+        if (box.min[0] > box.max[0])
+            continue;
+
+        float distance_squared = 0.f;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            const float offset = (box.min[axis] + box.max[axis]) * .5f - skinned_sphere.center[axis];
+            distance_squared += offset * offset;
+        }
+        radius = std::max(radius, std::sqrt(distance_squared) + chunk_radii[chunk]);
+    }
+    skinned_sphere.radius = std::min(radius, std::sqrt(diagonal_squared));
+}
+
+bool MeshSkinner::find_changed_blocks(const std::vector<HMM_Mat4>& precomputed_matrices,
+                                      std::vector<VertexBuckets::Bucket>& blocks,
+                                      size_t& changed_joints)
+{
+    // Nothing to diff against (first pose, or the streams, kernels or method changed)
+    if (skinned_palette.size() != precomputed_matrices.size())
+    {
+        return false;
+    }
+
+    // Unchanged chunks are only valid if their morphed rest positions weren't moved since
+    if (!morph_streams.empty() && (skinned_morph_weights.size() != skin_data.morph_weights.size() ||
+                                   morphed_weights != skinned_morph_weights))
+    {
+        return false;
+    }
+
+    // Mark the chunks influenced by every joint whose matrix differs (bitwise, so NaNs count)
+    changed_chunks.assign(influence_streams.chunk_offsets.size(), 0);
+    changed_joints = 0;
+    for (size_t joint_id = 0; joint_id < precomputed_matrices.size(); joint_id++)
+    {
+        if (std::memcmp(&precomputed_matrices[joint_id], &skinned_palette[joint_id],
+                        sizeof(HMM_Mat4)) == 0)
+            continue;
+
+        changed_joints++;
+        if (joint_id >= joint_chunk_index.joint_count())
+            continue;
+
+        for (uint32_t entry = joint_chunk_index.offsets[joint_id];
+             entry < joint_chunk_index.offsets[joint_id + 1]; entry++)
+        {
+            changed_chunks[joint_chunk_index.chunks[entry]] = 1;
+        }
+    }
+
+    // So are the chunks moved by every morph target whose weight differs
+    for (size_t target = 0; target < morph_streams.target_count(); target++)
     {
-        // Load mesh from OBJ file
-        original_mesh = ObjFacade::load_obj_mesh(mesh_path);
-        // Start with a clean canvas
-        skinned_mesh = original_mesh;
+        if (skin_data.morph_weights[target] == skinned_morph_weights[target])
+            continue;
 
-        std::cout << "Loaded mesh with " << original_mesh.vertices.size() 
-                  << " vertices from OBJ.\n";
+        for (uint32_t entry = morph_streams.target_offsets[target];
+             entry < morph_streams.target_offsets[target + 1]; entry++)
+        {
+            changed_chunks[morph_streams.target_chunks[entry]] = 1;
+        }
+    }
+
+    constexpr size_t CHUNK_SIZE = InfluenceStreams::CHUNK_SIZE;
+    blocks.clear();
+
+    // Meshlets are re-skinned whole, so each one binds its sub-palette once
+    if (meshlet_tiling)
+    {
+        for (const Meshlets::Meshlet& meshlet : meshlets.meshlets)
+        {
+            for (size_t begin = meshlet.begin; begin < meshlet.end; begin += CHUNK_SIZE)
+            {
+                if (changed_chunks[begin / CHUNK_SIZE])
+                {
+                    blocks.push_back({ meshlet.influence_count, meshlet.begin, meshlet.end });
+                    break;
+                }
+            }
+        }
         return true;
     }
-    catch (const std::exception& e)
+
+    // Merge runs of changed chunks into blocks that stay within one bucket
+    for (const VertexBuckets::Bucket& bucket : vertex_buckets.buckets)
     {
-        std::cerr << "Failed to load mesh: " << e.what() << std::endl;
-        return false;
+        for (size_t begin = bucket.begin; begin < bucket.end; begin += CHUNK_SIZE)
+        {
+            if (!changed_chunks[begin / CHUNK_SIZE])
+                continue;
+
+            if (!blocks.empty() && blocks.back().end == begin &&
+                blocks.back().influence_count == bucket.influence_count &&
+                blocks.back().end - blocks.back().begin < grain_size)
+            {
+                blocks.back().end += CHUNK_SIZE;
+            }
+            else
+            {
+                blocks.push_back({ bucket.influence_count, begin, begin + CHUNK_SIZE });
+            }
+        }
     }
+    return true;
 }
 
-bool MeshSkinner::load_weights(const std::string& weights_path)
+void MeshSkinner::build_skinning_streams()
 {
-    try 
+    // The skinned streams no longer match any palette
+    skinned_palette.clear();
+    skinning_blocks.clear();
+    skin_data.joint_rest_bounds.clear();
+
+    // The bucketed order depends on both the weights and the mesh
+    if (original_mesh.vertices.empty() ||
+        skin_data.sparse_weights.vertex_count() != original_mesh.vertices.size())
     {
-        // Load JSON weights data
-        const Json json_data = JsonFacade::load_from_file(weights_path);
-        
-        // Parse weights data
-        skin_data.weights = SkinningData::parse_weights_from_json(json_data);
+        build_morph_streams();
+        return;
+    }
 
-        std::cout << "Loaded skinning weights for " << skin_data.weights.size()
-                  << " vertices.\n";
-        return true;
-    } 
-    catch (const std::exception& e) 
+    vertex_buckets = VertexBuckets::from_sparse_weights(skin_data.sparse_weights, WEIGHT_THRESHOLD);
+    skin_data.joint_rest_bounds = SkinningData::compute_joint_rest_bounds(
+        skin_data.sparse_weights, original_mesh.vertices, WEIGHT_THRESHOLD);
+    meshlets = meshlet_tiling ?
+        Meshlets::tile(skin_data.sparse_weights, WEIGHT_THRESHOLD, vertex_buckets) : Meshlets();
+    rest_positions = VertexStreams::from_vertices(original_mesh.vertices, vertex_buckets);
+    skinned_positions.resize(vertex_buckets);
+    influence_streams = InfluenceStreams::from_sparse_weights(skin_data.sparse_weights,
+                                                              WEIGHT_THRESHOLD, vertex_buckets);
+    joint_chunk_index = JointChunkIndex::from_influence_streams(influence_streams);
+
+    // Meshlet-local joint IDs only have to address the largest meshlet's sub-palette
+    size_t indexed_joint_count = referenced_joint_count;
+    if (meshlet_tiling)
     {
-        std::cerr << "Failed to load weights: " << e.what() << std::endl;
-        return false;
+        meshlets.localize(influence_streams);
+        indexed_joint_count = meshlets.max_joint_count();
     }
+    influence_streams = influence_streams.encode(
+        InfluenceStreams::select_encoding(weight_precision, indexed_joint_count));
+    skinning_blocks = split_buckets(grain_size);
+    build_morph_streams();
+
+    place_streams_on_nodes();
 }
 
-bool MeshSkinner::load_inverse_bind_matrices(const std::string& inv_bind_path)
+void MeshSkinner::build_morph_streams()
 {
-    try
+    // The morphed and skinned streams no longer match any weights
+    morph_streams = MorphStreams();
+    morphed_positions = VertexStreams();
+    morphed_weights.clear();
+    skinned_morph_weights.clear();
+    skinned_palette.clear();
+
+    if (skin_data.morph_targets.delta_count() == 0 || original_mesh.vertices.empty() ||
+        skin_data.sparse_weights.vertex_count() != original_mesh.vertices.size())
     {
-        // Load JSON from file
-        const Json json_data = JsonFacade::load_from_file(inv_bind_path);
-        
-        // Parse matrices
-        skin_data.inverse_bind_matrices = SkinningData::parse_matrices_from_json(json_data);
+        return;
+    }
 
-        std::cout << "Loaded " << skin_data.inverse_bind_matrices.size() 
-                  << " inverse bind matrices.\n";
-        return true;
+    try
+    {
+        morph_streams = MorphStreams::from_morph_targets(skin_data.morph_targets, vertex_buckets);
     }
     catch (const std::exception& e)
     {
-        std::cerr << "Failed to load inverse bind matrices: " << e.what() << std::endl;
-        return false;
+        std::cerr << "Morph targets don't fit the mesh: " << e.what() << std::endl;
+        return;
     }
+
+    // Chunks that no target moves are never rewritten, so they keep these rest positions
+    morphed_positions = rest_positions;
 }
 
-bool MeshSkinner::load_output_pose_matrices(const std::string& pose_path)
+const VertexStreams& MeshSkinner::sync_morphed_positions()
 {
-    try
+    if (morph_streams.empty())
     {
-        // Load JSON from file
-        const Json json_data = JsonFacade::load_from_file(pose_path);
-        
-        // Parse matrices
-        skin_data.pose_matrices = SkinningData::parse_matrices_from_json(json_data);
+        return rest_positions;
+    }
 
-        std::cout << "Loaded " << skin_data.pose_matrices.size() 
-                  << " pose matrices.\n";
-        return true;
+    if (morphed_weights != skin_data.morph_weights)
+    {
+        thread_pool->parallel_for(0, skinning_blocks.size(), 1, [&](size_t first, size_t last)
+        {
+            for (size_t b = first; b < last; b++)
+            {
+                morph_streams.apply(skin_data.morph_weights.data(), rest_positions, morphed_positions,
+                                    skinning_blocks[b].begin, skinning_blocks[b].end);
+            }
+        });
+        morphed_weights = skin_data.morph_weights;
     }
-    catch (const std::exception& e)
+    return morphed_positions;
+}
+
+void MeshSkinner::place_streams_on_nodes()
+{
+    if (!numa_aware || vertex_buckets.padded_count() == 0)
     {
-        std::cerr << "Failed to load pose matrices: " << e.what() << std::endl;
+        return;
+    }
+
+    constexpr size_t CHUNK_SIZE = InfluenceStreams::CHUNK_SIZE;
+
+    // Fresh streams whose pages nobody has touched yet (resize() leaves them uninitialized)
+    const bool morphing = !morph_streams.empty();
+    VertexStreams placed_rest;
+    VertexStreams placed_skinned;
+    VertexStreams placed_morphed;
+    InfluenceStreams placed_influences;
+    for (VertexStreams* streams : { &placed_rest, &placed_skinned, &placed_morphed })
+    {
+        if (streams == &placed_morphed && !morphing)
+            continue;
+
+        streams->count = rest_positions.count;
+        streams->x.resize(rest_positions.padded_count());
+        streams->y.resize(rest_positions.padded_count());
+        streams->z.resize(rest_positions.padded_count());
+    }
+    placed_influences.encoding = influence_streams.encoding;
+    placed_influences.count = influence_streams.count;
+    placed_influences.chunk_offsets = influence_streams.chunk_offsets;
+    placed_influences.chunk_influences = influence_streams.chunk_influences;
+
+    // Only the joint ID and weight streams of the active encoding are non-empty
+    const auto for_each_stream = [&](auto&& visit)
+    {
+        visit(influence_streams.joint_ids, placed_influences.joint_ids);
+        visit(influence_streams.weights, placed_influences.weights);
+        visit(influence_streams.joint_ids_16, placed_influences.joint_ids_16);
+        visit(influence_streams.joint_ids_8, placed_influences.joint_ids_8);
+        visit(influence_streams.weights_unorm16, placed_influences.weights_unorm16);
+        visit(influence_streams.weights_unorm8, placed_influences.weights_unorm8);
+    };
+    for_each_stream([](const auto& source, auto& placed) { placed.resize(source.size()); });
+
+    // Copy each block with the same loop shape apply_vertex_transformations() skins it with
+    const std::vector<VertexBuckets::Bucket>& blocks = skinning_blocks;
+    const size_t chunk_count = influence_streams.chunk_offsets.size();
+    thread_pool->parallel_for(0, blocks.size(), 1, [&](size_t first, size_t last)
+    {
+        for (size_t b = first; b < last; b++)
+        {
+            const VertexBuckets::Bucket& block = blocks[b];
+            const size_t count = block.end - block.begin;
+
+            std::copy_n(rest_positions.x.data() + block.begin, count, placed_rest.x.data() + block.begin);
+            std::copy_n(rest_positions.y.data() + block.begin, count, placed_rest.y.data() + block.begin);
+            std::copy_n(rest_positions.z.data() + block.begin, count, placed_rest.z.data() + block.begin);
+            std::copy_n(skinned_positions.x.data() + block.begin, count, placed_skinned.x.data() + block.begin);
+            std::copy_n(skinned_positions.y.data() + block.begin, count, placed_skinned.y.data() + block.begin);
+            std::copy_n(skinned_positions.z.data() + block.begin, count, placed_skinned.z.data() + block.begin);
+            if (morphing)
+            {
+                std::copy_n(morphed_positions.x.data() + block.begin, count, placed_morphed.x.data() + block.begin);
+                std::copy_n(morphed_positions.y.data() + block.begin, count, placed_morphed.y.data() + block.begin);
+                std::copy_n(morphed_positions.z.data() + block.begin, count, placed_morphed.z.data() + block.begin);
+            }
+
+            // The block's chunks are stored back to back in the influence streams
+            const size_t last_chunk = block.end / CHUNK_SIZE;
+            const size_t slots_begin = influence_streams.chunk_offsets[block.begin / CHUNK_SIZE];
+            const size_t slots_end = last_chunk < chunk_count ?
+                influence_streams.chunk_offsets[last_chunk] : influence_streams.entry_count();
+
+            for_each_stream([&](const auto& source, auto& placed)
+            {
+                if (!source.empty())
+                    std::copy(source.begin() + slots_begin, source.begin() + slots_end,
+                              placed.begin() + slots_begin);
+            });
+        }
+    });
+
+    rest_positions = std::move(placed_rest);
+    skinned_positions = std::move(placed_skinned);
+    morphed_positions = std::move(placed_morphed);
+    influence_streams = std::move(placed_influences);
+}
+
+std::vector<VertexBuckets::Bucket> MeshSkinner::split_buckets(size_t block_size) const
+{
+    std::vector<VertexBuckets::Bucket> blocks;
+
+    // Meshlets are skinned whole, each against its own sub-palette
+    if (meshlet_tiling)
+    {
+        for (const Meshlets::Meshlet& meshlet : meshlets.meshlets)
+        {
+            blocks.push_back({ meshlet.influence_count, meshlet.begin, meshlet.end });
+        }
+        return blocks;
+    }
+
+    for (const VertexBuckets::Bucket& bucket : vertex_buckets.buckets)
+    {
+        for (size_t begin = bucket.begin; begin < bucket.end; begin += block_size)
+        {
+            blocks.push_back({ bucket.influence_count, begin, std::min(begin + block_size, bucket.end) });
+        }
+    }
+    return blocks;
+}
+
+bool MeshSkinner::validate_output_buffer(const PositionBuffer& output) const
+{
+    const size_t component_size = PositionBuffer::component_size(output.format);
+    if (output.data == nullptr || output.vertex_count < original_mesh.vertices.size() ||
+        reinterpret_cast<uintptr_t>(output.data) % component_size != 0 ||
+        output.stride < 3 * component_size || output.stride % component_size != 0)
+    {
+        std::cerr << "Output buffer cannot hold the " << original_mesh.vertices.size()
+                  << " skinned vertices\n";
+        return false;
+    }
+
+    if (output.format == PositionFormat::Unorm16 && output.bounds == nullptr)
+    {
+        std::cerr << "Normalized output buffers need somewhere to store the frame's bounds\n";
         return false;
     }
+
+    return true;
 }
 
-bool MeshSkinner::perform_skinning()
+bool MeshSkinner::validate_skinning_data() const
 {
     // Verify all required data is loaded
     if (original_mesh.vertices.empty()) 
@@ -108,146 +2141,326 @@ bool MeshSkinner::perform_skinning()
         return false;
     }
     
-    if (skin_data.weights.empty()) 
+    if (skin_data.sparse_weights.vertex_count() == 0) 
     {
         std::cerr << "No skinning weights loaded\n";
         return false;
     }
     
-    if (skin_data.inverse_bind_matrices.empty() || skin_data.pose_matrices.empty()) 
+    if (skin_data.inverse_bind_matrices.empty()) 
     {
-        std::cerr << "Inverse bind matrices or pose matrices not loaded\n";
+        std::cerr << "No inverse bind matrices loaded\n";
         return false;
     }
 
     // Verify weights count matches vertex count
-    if (skin_data.weights.size() != original_mesh.vertices.size()) 
+    if (skin_data.sparse_weights.vertex_count() != original_mesh.vertices.size()) 
     {
-        std::cerr << "Weight data count (" << skin_data.weights.size() 
+        std::cerr << "Weight data count (" << skin_data.sparse_weights.vertex_count() 
                   << ") doesn't match vertex count (" 
                   << original_mesh.vertices.size() << ")\n";
         return false;
     }
 
-    // Precompute skinning matrices for each joint
-    const size_t joint_count = skin_data.pose_matrices.size();
-    std::vector<HMM_Mat4> precomputed_matrices(joint_count);
-
-    for (size_t joint_id = 0; joint_id < joint_count; joint_id++)
+    // Morph targets that didn't fit the mesh were left out of the streams
+    if (skin_data.morph_targets.delta_count() != 0 && morph_streams.empty())
     {
-        // Combine pose and inverse bind into a single matrix
-        precomputed_matrices[joint_id] = MathFacade::multiply(
-            skin_data.pose_matrices[joint_id],
-            skin_data.inverse_bind_matrices[joint_id]
-        );
+        std::cerr << "Morph targets don't match the mesh\n";
+        return false;
     }
 
-    std::cout << "Applying vertex transformations...\n";
+    return true;
+}
 
-    // Apply transformations using the precomputed matrices (with timing)
-    const auto apply_start = std::chrono::high_resolution_clock::now();
-    apply_vertex_transformations(precomputed_matrices);
-    const auto apply_end = std::chrono::high_resolution_clock::now();
+bool MeshSkinner::validate_pose_matrices(const std::vector<HMM_Mat4>& pose_matrices) const
+{
+    if (pose_matrices.empty())
+    {
+        std::cerr << "No pose matrices loaded\n";
+        return false;
+    }
 
-    const std::chrono::duration<double, std::milli> apply_duration = apply_end - apply_start;
-    record_timing("Apply Transformations", apply_duration.count());
+    // The palette holds one skinning matrix per joint with both a pose and an inverse bind matrix
+    const size_t palette_size = std::min(pose_matrices.size(), skin_data.inverse_bind_matrices.size());
+    if (palette_size < referenced_joint_count)
+    {
+        std::cerr << "Weights reference joint " << referenced_joint_count - 1 << " but only "
+                  << palette_size << " joints have both pose and inverse bind matrices\n";
+        return false;
+    }
 
-    std::cout << "Skinning completed successfully\n";
     return true;
 }
 
-bool MeshSkinner::save_skinned_mesh(const std::string& output_path)
+SparseWeights MeshSkinner::bake_weights(const SparseWeights& weights)
 {
-    try
+    const size_t vertex_count = weights.vertex_count();
+
+    // Real influences: a weight above the threshold (which also rules out NaN) and a joint
+    const auto is_influence = [&weights](size_t entry)
     {
-        if (!ObjFacade::save_obj_mesh(output_path, skinned_mesh))
+        if (!std::isfinite(weights.weights[entry]))
         {
-            std::cerr << "Failed to save skinned mesh to OBJ.\n";
-            return false;
+            throw std::runtime_error("Weight " + std::to_string(entry) + " is not finite");
         }
-        std::cout << "Saved skinned mesh to: " << output_path << std::endl;
-        return true;
+        return weights.weights[entry] >= WEIGHT_THRESHOLD && weights.joint_ids[entry] >= 0;
+    };
+
+    // Count the influences each vertex keeps, then lay them out back to back
+    SparseWeights baked;
+    baked.offsets.assign(vertex_count + 1, 0);
+    thread_pool->parallel_for(0, vertex_count, grain_size, [&](size_t begin, size_t end)
+    {
+        for (size_t vertex = begin; vertex < end; vertex++)
+        {
+            uint32_t kept = 0;
+            for (size_t entry = weights.offsets[vertex]; entry < weights.offsets[vertex + 1]; entry++)
+            {
+                kept += is_influence(entry) ? 1 : 0;
+            }
+            baked.offsets[vertex + 1] = kept;
+        }
+    });
+    for (size_t vertex = 0; vertex < vertex_count; vertex++)
+    {
+        baked.offsets[vertex + 1] += baked.offsets[vertex];
     }
-    catch (const std::exception& e)
+    baked.joint_ids.resize(baked.offsets[vertex_count]);
+    baked.weights.resize(baked.offsets[vertex_count]);
+
+    // Copy, sort and renormalize each vertex's influences, tracking the largest joint ID per task
+    const size_t task_count = (vertex_count + grain_size - 1) / grain_size;
+    std::vector<int32_t> max_joint_ids(task_count, -1);
+    thread_pool->parallel_for(0, vertex_count, grain_size, [&](size_t begin, size_t end)
     {
-        std::cerr << "Failed to save skinned mesh: " << e.what() << std::endl;
-        return false;
+        int32_t max_joint_id = -1;
+        for (size_t vertex = begin; vertex < end; vertex++)
+        {
+            const size_t first = baked.offsets[vertex];
+            size_t last = first;
+            float sum = 0.f;
+            for (size_t entry = weights.offsets[vertex]; entry < weights.offsets[vertex + 1]; entry++)
+            {
+                if (!is_influence(entry))
+                    continue;
+
+                // Insertion sort by decreasing weight (vertices have a handful of influences)
+                size_t slot = last++;
+                for (; slot > first && baked.weights[slot - 1] < weights.weights[entry]; slot--)
+                {
+                    baked.weights[slot] = baked.weights[slot - 1];
+                    baked.joint_ids[slot] = baked.joint_ids[slot - 1];
+                }
+                baked.weights[slot] = weights.weights[entry];
+                baked.joint_ids[slot] = weights.joint_ids[entry];
+
+                sum += weights.weights[entry];
+                max_joint_id = std::max(max_joint_id, weights.joint_ids[entry]);
+            }
+
+            for (size_t slot = first; slot < last; slot++)
+            {
+                baked.weights[slot] /= sum;
+            }
+        }
+        max_joint_ids[begin / grain_size] = max_joint_id;
+    });
+
+    int32_t max_joint_id = -1;
+    for (const int32_t task_max_joint_id : max_joint_ids)
+    {
+        max_joint_id = std::max(max_joint_id, task_max_joint_id);
     }
+    referenced_joint_count = static_cast<size_t>(max_joint_id + 1);
+    return baked;
 }
 
-void MeshSkinner::print_timing_metrics() const
+void MeshSkinner::evaluate_skeleton(const std::vector<JointTransform>& local_transforms,
+                                    std::vector<HMM_Mat4>& world_matrices)
 {
-    if (timing_metrics.empty())
+    const Skeleton& skeleton = skin_data.skeleton;
+    const size_t joint_count = skeleton.joint_count();
+    skeleton_local.resize(joint_count);
+    skeleton_parent.resize(joint_count);
+    skeleton_world.resize(joint_count);
+    world_matrices.resize(joint_count);
+
+    // Compose each joint's local matrix, already in level order
+    thread_pool->parallel_for(0, joint_count, SKELETON_BLOCK_SIZE, [&](size_t begin, size_t end)
     {
-        std::cout << "No timing metrics available." << std::endl;
-        return;
+        for (size_t position = begin; position < end; position++)
+        {
+            const JointTransform& local = local_transforms[skeleton.level_order[position]];
+            skeleton_local[position] = MathFacade::compose(local.translation, local.rotation,
+                                                           local.scale);
+        }
+    });
+
+    // Roots are already in world space
+    std::copy_n(skeleton_local.begin(), skeleton.level_offsets[1], skeleton_world.begin());
+
+    // Every joint of a level only needs the levels above it: gather the parents' world
+    // matrices next to the level's local ones, then multiply the whole level in SIMD batches
+    for (size_t level = 1; level < skeleton.level_count(); level++)
+    {
+        thread_pool->parallel_for(skeleton.level_offsets[level], skeleton.level_offsets[level + 1],
+                                  SKELETON_BLOCK_SIZE, [&](size_t begin, size_t end)
+        {
+            for (size_t position = begin; position < end; position++)
+            {
+                skeleton_parent[position] = skeleton_world[skeleton.level_parents[position]];
+            }
+            kernels->multiply_matrices(&skeleton_parent[begin], &skeleton_local[begin],
+                                       &skeleton_world[begin], end - begin);
+        });
     }
-    
-    std::cout << "\n===== Performance Timing Metrics =====\n";
-    std::cout << std::left << std::setw(35) << "Operation" 
-              << std::right << std::setw(15) << "Time (ms)" << std::endl;
-    std::cout << std::string(50, '-') << std::endl;
-    
-    for (const auto& metric : timing_metrics)
+
+    // Back to joint order, ready for the palette precomputation
+    for (size_t position = 0; position < joint_count; position++)
     {
-        std::cout << std::left << std::setw(35) << metric.first 
-                  << std::right << std::setw(15) << std::fixed << std::setprecision(3) 
-                  << metric.second << std::endl;
+        world_matrices[skeleton.level_order[position]] = skeleton_world[position];
     }
-    std::cout << std::string(50, '-') << std::endl;
 }
 
-void MeshSkinner::apply_vertex_transformations(const std::vector<HMM_Mat4>& precomputed_matrices)
+bool MeshSkinner::sample_clip_pose(float time, std::vector<HMM_Mat4>& pose_matrices)
 {
-    // Reset skinned mesh to have the same vertices as original
-    skinned_mesh.vertices = original_mesh.vertices;
+    const AnimationClip& clip = skin_data.animation_clip;
+    const size_t joint_count = clip.joint_count();
+    if (joint_count == 0)
+    {
+        std::cerr << "No animation clip loaded\n";
+        return false;
+    }
+
+    // Without a hierarchy, each track already holds its joint's pose
+    const bool hierarchical = skin_data.skeleton.joint_count() != 0;
+    if (hierarchical && joint_count != skin_data.skeleton.joint_count())
+    {
+        std::cerr << "Animation clip joint count (" << joint_count
+                  << ") doesn't match skeleton joint count (" << skin_data.skeleton.joint_count() << ")\n";
+        return false;
+    }
+
+    clip_transforms.resize(joint_count);
+    if (!hierarchical)
+        pose_matrices.resize(joint_count);
 
-    // Parallel transform of each vertex
-    std::for_each(
-        std::execution::par, 
-        skinned_mesh.vertices.begin(),
-        skinned_mesh.vertices.end(),
-        [&](Vertex& vert)
+    thread_pool->parallel_for(0, joint_count, SKELETON_BLOCK_SIZE, [&](size_t begin, size_t end)
+    {
+        for (size_t joint = begin; joint < end; joint++)
         {
-            const size_t i = &vert - &skinned_mesh.vertices[0];
+            clip_transforms[joint] = clip.sample(joint, time);
+            if (!hierarchical)
+            {
+                pose_matrices[joint] = MathFacade::compose(clip_transforms[joint].translation,
+                                                           clip_transforms[joint].rotation,
+                                                           clip_transforms[joint].scale);
+            }
+        }
+    });
 
-            const HMM_Vec3 original_position = HMM_V3(
-                original_mesh.vertices[i].x,
-                original_mesh.vertices[i].y,
-                original_mesh.vertices[i].z
-            );
+    if (hierarchical)
+        evaluate_skeleton(clip_transforms, pose_matrices);
+    return true;
+}
 
-            HMM_Vec3 new_position = HMM_V3(0.f, 0.f, 0.f);
+void MeshSkinner::compute_skinning_matrices(const std::vector<HMM_Mat4>& pose_matrices,
+                                            std::vector<HMM_Mat4>& precomputed_matrices) const
+{
+    const size_t joint_count = std::min(pose_matrices.size(),
+                                        skin_data.inverse_bind_matrices.size());
+    precomputed_matrices.resize(joint_count);
 
-            // Grab the bone influences for this vertex
-            const VertexWeights& weights_for_vertex = skin_data.weights[i];
+    kernels->multiply_matrices(pose_matrices.data(),
+                               skin_data.inverse_bind_matrices.data(),
+                               precomputed_matrices.data(), joint_count);
+}
 
-            // Accumulate contributions from each joint influence
-            for (size_t j = 0; j < VertexWeights::MAX_INFLUENCES; j++)
-            {
-                const int joint_id = weights_for_vertex.joint_ids[j];
-                const float weight = weights_for_vertex.weights[j];
+void MeshSkinner::bind_palette(
+    const std::vector<HMM_Mat4>& precomputed_matrices,
+    ConvertedPalette& converted_palette,
+    SkinningKernels::SkinningJob& job) const
+{
+    const size_t joint_count = precomputed_matrices.size();
 
-                // Skip negligible weights or invalid IDs
-                if (weight < WEIGHT_THRESHOLD || joint_id < 0) 
-                    continue;
+    if (skinning_method == SkinningMethod::DualQuaternion)
+    {
+        // Dual quaternion skinning blends 8 floats per influence instead of a full matrix,
+        // so convert the palette once per pose
+        converted_palette.dual_quaternions.resize(joint_count);
+        for (size_t joint_id = 0; joint_id < joint_count; joint_id++)
+        {
+            converted_palette.dual_quaternions[joint_id] =
+                MathFacade::to_dual_quaternion(precomputed_matrices[joint_id]);
+        }
 
-                const HMM_Mat4& skinning_matrix = precomputed_matrices[joint_id];
-                const HMM_Vec3 transformed_position =
-                    MathFacade::transform_vec3(skinning_matrix, original_position);
+        job.dual_quaternion_palette = converted_palette.dual_quaternions.data();
+        return;
+    }
 
-                // Weighted sum
-                new_position.X += transformed_position.X * weight;
-                new_position.Y += transformed_position.Y * weight;
-                new_position.Z += transformed_position.Z * weight;
-            }
+    // Drop the bottom row, which linear blend skinning never reads (as in
+    // MathFacade::transform_vec3): 48 bytes per influence instead of 64
+    converted_palette.affine_matrices.resize(joint_count);
+    for (size_t joint_id = 0; joint_id < joint_count; joint_id++)
+    {
+        converted_palette.affine_matrices[joint_id] =
+            MathFacade::to_affine(precomputed_matrices[joint_id]);
+    }
+
+    job.affine_palette = converted_palette.affine_matrices.data();
+}
+
+void MeshSkinner::reserve_meshlet_palette(const SkinningKernels::SkinningJob& job,
+                                          ConvertedPalette& meshlet_palette) const
+{
+    const size_t entry_count = meshlets.joints.size();
+    if (job.dual_quaternion_palette != nullptr)
+        meshlet_palette.dual_quaternions.resize(entry_count);
+    if (job.affine_palette != nullptr)
+        meshlet_palette.affine_matrices.resize(entry_count);
+}
+
+SkinningKernels::SkinningJob MeshSkinner::bind_meshlet_palette(const SkinningKernels::SkinningJob& job,
+                                                               const Meshlets::Meshlet& meshlet,
+                                                               ConvertedPalette& meshlet_palette) const
+{
+    SkinningKernels::SkinningJob meshlet_job = job;
+    const uint32_t* joints = meshlets.joints.data() + meshlet.joint_begin;
+    const size_t joint_count = meshlet.joint_end - meshlet.joint_begin;
+
+    if (job.dual_quaternion_palette != nullptr)
+    {
+        DualQuaternion* local = meshlet_palette.dual_quaternions.data() + meshlet.joint_begin;
+        for (size_t j = 0; j < joint_count; j++)
+        {
+            local[j] = job.dual_quaternion_palette[joints[j]];
+        }
+        meshlet_job.dual_quaternion_palette = local;
+    }
 
-            // Update the skinned vertex position
-            vert.x = new_position.X;
-            vert.y = new_position.Y;
-            vert.z = new_position.Z;
+    if (job.affine_palette != nullptr)
+    {
+        AffineMatrix* local = meshlet_palette.affine_matrices.data() + meshlet.joint_begin;
+        for (size_t j = 0; j < joint_count; j++)
+        {
+            local[j] = job.affine_palette[joints[j]];
         }
-    );
+        meshlet_job.affine_palette = local;
+    }
+
+    return meshlet_job;
+}
+
+SkinningKernels::SkinVerticesFn MeshSkinner::select_kernel(size_t influence_count) const
+{
+    if (skinning_method == SkinningMethod::DualQuaternion)
+    {
+        return SkinningKernels::select_dual_quaternion(*kernels, influence_count,
+                                                       influence_streams.encoding);
+    }
+
+    return SkinningKernels::select_linear_blend(*kernels, influence_count,
+                                                influence_streams.encoding);
 }
 
 void MeshSkinner::record_timing(const std::string& operation_name, double duration)
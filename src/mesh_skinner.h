@@ -2,7 +2,11 @@
 
 // Standard library imports
 #include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -10,20 +14,200 @@
 #include "handmade_math/handmade_math.h"
 
 // Local application imports
+#include "kernel/skinning_kernels.h"
 #include "model/mesh.h"
+#include "model/pose_track.h"
 #include "model/skinning_data.h"
+#include "model/vertex_streams.h"
+#include "parallel/thread_pool.h"
 
 
 /**
- * @brief A class for performing linear blend skinning on 3D meshes.
+ * @brief The algorithm used to blend joint transforms at each vertex.
+ */
+enum class SkinningMethod
+{
+    /**
+     * @brief Classic linear blend skinning of 4x4 matrices.
+     */
+    LinearBlend,
+
+    /**
+     * @brief Dual quaternion skinning; preserves volume around twisting joints.
+     */
+    DualQuaternion
+};
+
+/**
+ * @brief A class for performing skeletal skinning on 3D meshes.
  *
  * This class manages the skinning process from loading input data (mesh, matrices, weights)
- * to applying the transformations and outputting the deformed mesh.
+ * to applying the transformations and outputting the deformed mesh. Linear blend
+ * skinning is used by default; dual quaternion skinning can be selected instead.
  */
 class MeshSkinner
 {
 public:
 
+    /**
+     * @brief Constructs a skinner using the fastest kernel variant this CPU supports.
+     *
+     * The variant is detected once via cpuid. It can be overridden for A/B benchmarking
+     * by setting the MESHSKINNER_ISA environment variable (scalar, sse4, avx2, avx512)
+     * or by calling set_instruction_set().
+     */
+    MeshSkinner();
+
+    /**
+     * @brief Stops the asynchronous skinning thread; pending submissions are abandoned.
+     */
+    ~MeshSkinner();
+
+    MeshSkinner(const MeshSkinner&) = delete;
+    MeshSkinner& operator=(const MeshSkinner&) = delete;
+
+    /**
+     * @brief A frame skinned by submit_skinning(), held in one of the skinner's output slots.
+     *
+     * The slot stays reserved for as long as a copy of the handle is alive, so the vertices
+     * can be read while the next frames are skinned into the other slots.
+     */
+    using SkinnedFrame = std::shared_ptr<const std::vector<Vertex>>;
+
+    /**
+     * @brief Forces a specific kernel variant.
+     * @param instruction_set The instruction set whose kernels should be used.
+     * @return true if the variant is supported on this CPU and was selected; otherwise false.
+     */
+    bool set_instruction_set(SkinningKernels::InstructionSet instruction_set);
+
+    /**
+     * @brief Gets the instruction set of the kernels currently in use.
+     * @return The active instruction set.
+     */
+    SkinningKernels::InstructionSet get_instruction_set() const;
+
+    /**
+     * @brief Resizes the thread pool used to load, skin and save.
+     *
+     * The initial size can also be set with the MESHSKINNER_THREADS environment variable.
+     *
+     * @param thread_count The number of threads, the calling thread included
+     *                     (0 picks one per hardware thread, and counts above
+     *                     MAX_THREAD_COUNT are clamped to it).
+     */
+    void set_thread_count(size_t thread_count);
+
+    /**
+     * @brief Enables or disables NUMA-aware skinning.
+     *
+     * When enabled, the pool's workers are pinned per NUMA node, each node skins its own
+     * part of the vertex range, and the streams that part reads and writes are copied into
+     * memory first touched by that node's workers. Also enabled by MESHSKINNER_NUMA=1.
+     * Has no effect beyond pinning where the NUMA topology cannot be read.
+     *
+     * @param enabled Whether to enable NUMA-aware skinning.
+     */
+    void set_numa_aware(bool enabled);
+
+    /**
+     * @brief Checks whether NUMA-aware skinning is enabled.
+     * @return true if enabled; otherwise false.
+     */
+    bool is_numa_aware() const;
+
+    /**
+     * @brief Enables or disables meshlet tiling of the vertex range.
+     *
+     * When enabled, each influence bucket is re-sorted by dominant joint and cut into
+     * meshlets of at most Meshlets::MAX_VERTICES vertices and (usually) Meshlets::MAX_JOINTS
+     * joints. Each parallel task skins one meshlet against a sub-palette gathered for it,
+     * so the matrices it reads stay in L1, and its joint IDs index that sub-palette (8-bit
+     * IDs for compact weights). The output order is unchanged. Rebuilds the streams of
+     * loaded weights; the grain size is ignored while enabled.
+     *
+     * @param enabled Whether to tile the vertex range into meshlets.
+     */
+    void set_meshlet_tiling(bool enabled);
+
+    /**
+     * @brief Checks whether meshlet tiling is enabled.
+     * @return true if enabled; otherwise false.
+     */
+    bool is_meshlet_tiling() const;
+
+    /**
+     * @brief Gets the number of meshlets the vertex range is tiled into.
+     * @return The meshlet count (0 unless meshlet tiling is enabled and weights are loaded).
+     */
+    size_t get_meshlet_count() const;
+
+    /**
+     * @brief Gets the number of threads used to load, skin and save.
+     * @return The thread count, the calling thread included.
+     */
+    size_t get_thread_count() const;
+
+    /**
+     * @brief Sets how many vertices perform_skinning() hands to the kernel per parallel task.
+     * @param vertex_count The task size (rounded up to a multiple of InfluenceStreams::CHUNK_SIZE).
+     */
+    void set_grain_size(size_t vertex_count);
+
+    /**
+     * @brief Gets how many vertices perform_skinning() hands to the kernel per parallel task.
+     * @return The task size in vertices.
+     */
+    size_t get_grain_size() const;
+
+    /**
+     * @brief Selects the blending algorithm used by perform_skinning().
+     * @param method The skinning method (linear blend by default).
+     */
+    void set_skinning_method(SkinningMethod method);
+
+    /**
+     * @brief Gets the blending algorithm used by perform_skinning().
+     * @return The active skinning method.
+     */
+    SkinningMethod get_skinning_method() const;
+
+    /**
+     * @brief Selects how compactly the skinning weights are stored.
+     *
+     * Unorm weights are paired with 8-bit joint IDs on rigs of up to 256 joints and 16-bit
+     * ones otherwise, taking 2 to 4 bytes per influence instead of 8. The kernels dequantize
+     * them on the fly, so skinning reads a quarter to a half of the weight bandwidth. Each
+     * vertex's quantized weights still sum to 1; measure_quantization_error() reports how
+     * far they move the skinned vertices. Rebuilds the streams of loaded weights.
+     *
+     * @param precision The weight precision (Float32 by default).
+     * @return true if the weights can be stored at that precision; otherwise false.
+     */
+    bool set_weight_precision(WeightPrecision precision);
+
+    /**
+     * @brief Gets how compactly the skinning weights are stored.
+     * @return The weight precision.
+     */
+    WeightPrecision get_weight_precision() const;
+
+    /**
+     * @brief Gets the encoding of the influence streams the kernels read.
+     * @return The encoding picked for the weight precision and the loaded rig.
+     */
+    InfluenceEncoding get_influence_encoding() const;
+
+    /**
+     * @brief Measures the largest displacement the weight quantization causes under the loaded pose.
+     *
+     * Compares linear blend skinning with the quantized weights against the float ones, one
+     * vertex at a time, so it is a diagnostic for callers rather than part of skinning.
+     *
+     * @return The largest distance between the two positions of any vertex (0 for float weights).
+     */
+    float measure_quantization_error() const;
+
     /**
      * @brief Loads mesh data from an OBJ file via ObjFacade.
      * @param mesh_path The path to the OBJ file.
@@ -51,13 +235,372 @@ public:
      * @return true if the matrices were loaded successfully; otherwise false.
      */
     bool load_output_pose_matrices(const std::string& pose_path);
+
+    /**
+     * @brief Replaces the pose matrices used by perform_skinning(), e.g. after an interactive edit.
+     * @param pose_matrices The new pose matrices, one per joint.
+     */
+    void set_output_pose_matrices(const std::vector<HMM_Mat4>& pose_matrices);
+
+    /**
+     * @brief Loads the joint hierarchy from a JSON array of parent indices (-1 for roots).
+     * @param skeleton_path The path to the skeleton JSON file.
+     * @return true if the skeleton was loaded successfully; otherwise false.
+     */
+    bool load_skeleton(const std::string& skeleton_path);
+
+    /**
+     * @brief Replaces the joint hierarchy used by set_local_pose().
+     * @param parents The parent of each joint, or -1 for a root.
+     * @return true if the hierarchy is valid and was set; otherwise false.
+     */
+    bool set_skeleton(const std::vector<int32_t>& parents);
+
+    /**
+     * @brief Loads local joint transforms from a JSON file and poses the skeleton with them.
+     * @param pose_path The path to the local transforms JSON file.
+     * @return true if the pose was loaded and evaluated; otherwise false.
+     */
+    bool load_local_pose(const std::string& pose_path);
+
+    /**
+     * @brief Poses the loaded skeleton with transforms relative to each joint's parent.
+     *
+     * Forward kinematics runs level by level: all joints of a depth level are multiplied
+     * with their parents' world matrices in parallel SIMD batches. The world matrices
+     * replace the pose matrices used by perform_skinning().
+     *
+     * @param local_transforms The transform of each joint relative to its parent.
+     * @return true if the skeleton was posed; otherwise false.
+     */
+    bool set_local_pose(const std::vector<JointTransform>& local_transforms);
+
+    /**
+     * @brief Loads a keyframed animation clip from a JSON file.
+     * @param clip_path The path to the clip JSON file (one array of keys per joint).
+     * @return true if the clip was loaded successfully; otherwise false.
+     */
+    bool load_animation_clip(const std::string& clip_path);
+
+    /**
+     * @brief Replaces the animation clip sampled by sample_animation_clip().
+     * @param clip The clip, one track per joint.
+     */
+    void set_animation_clip(const AnimationClip& clip);
+
+    /**
+     * @brief Gets the length of the loaded animation clip.
+     * @return The time of its last key, in seconds (0 if no clip is loaded).
+     */
+    float get_animation_duration() const;
+
+    /**
+     * @brief Poses the mesh with the loaded animation clip at a point in time.
+     *
+     * Every joint's track is sampled in parallel blocks, blending the surrounding keys
+     * (lerp for translation and scale, slerp for rotation). With a skeleton loaded, the
+     * samples are local transforms posed through the hierarchy like set_local_pose() does;
+     * otherwise each sample is the joint's pose matrix. The result replaces the pose matrices
+     * used by perform_skinning(), so a frame costs no palette parsing at all.
+     *
+     * @param time The time to sample at, in seconds (held at the first and last keys).
+     * @return true if the clip was sampled; otherwise false.
+     */
+    bool sample_animation_clip(float time);
+
+    /**
+     * @brief Samples the loaded animation clip at a fixed rate into the pose sequence.
+     *
+     * The frames cover the clip from time 0 to its last key and replace the poses loaded by
+     * load_pose_sequence(), ready for perform_sequence_skinning().
+     *
+     * @param frame_rate The number of frames per second.
+     * @return true if at least one frame was sampled; otherwise false.
+     */
+    bool sample_animation_sequence(float frame_rate);
+
+    /**
+     * @brief Loads sparse morph targets from a JSON file.
+     *
+     * Each target is an object listing the vertices it moves ("indices") and their offsets
+     * ("deltas"), with an optional initial "weight" (0 when omitted).
+     *
+     * @param morph_targets_path The path to the morph targets JSON file.
+     * @return true if the targets were loaded successfully; otherwise false.
+     */
+    bool load_morph_targets(const std::string& morph_targets_path);
+
+    /**
+     * @brief Replaces the morph targets applied to the rest pose; their weights are reset to 0.
+     *
+     * Skinning adds each target's deltas, scaled by its weight, to the rest positions of the
+     * vertices it moves. The deltas are regrouped by influence chunk, and each parallel task
+     * morphs the chunks it is about to skin while they are in cache, so vertices no target
+     * moves cost nothing and the morphed mesh is never written out between the two stages.
+     *
+     * @param targets The targets, indexing vertices of the mesh.
+     * @return true if the targets fit the loaded mesh and were set; otherwise false.
+     */
+    bool set_morph_targets(const MorphTargets& targets);
+
+    /**
+     * @brief Sets the morph target weights used by the next poses.
+     *
+     * When the next pose is skinned incrementally, only the vertices of targets whose weight
+     * changed are re-skinned (besides those of moved joints).
+     *
+     * @param weights The weight of each target.
+     * @return true if there is one finite weight per target; otherwise false.
+     */
+    bool set_morph_weights(const std::vector<float>& weights);
+
+    /**
+     * @brief Gets the number of loaded morph targets.
+     * @return The target count.
+     */
+    size_t get_morph_target_count() const;
     
+    /**
+     * @brief Loads a sequence of pose palettes, one per output frame.
+     *
+     * The path may name a directory (every .json file in it), a file pattern with '*' or '?'
+     * wildcards in its file name, a single JSON file holding either one palette or an array
+     * of palettes, or a .mska pose track (every frame decoded). Files are taken in natural
+     * name order, where numbers compare by value: pose_2.json comes before pose_10.json.
+     *
+     * @param sequence_path The directory, pattern or file to load.
+     * @return true if at least one pose was loaded; otherwise false.
+     */
+    bool load_pose_sequence(const std::string& sequence_path);
+
+    /**
+     * @brief Gets the number of poses loaded by load_pose_sequence().
+     * @return The number of frames in the sequence.
+     */
+    size_t get_pose_sequence_length() const;
+
+    /**
+     * @brief Compresses the poses loaded by load_pose_sequence() into a pose track file.
+     * @param track_path The .mska file to write (see PoseTrack for the format).
+     * @return true if the track was written; otherwise false.
+     */
+    bool save_pose_track(const std::string& track_path) const;
+
+    /**
+     * @brief Memory-maps a pose track, so set_pose_track_frame() can pose any of its frames.
+     * @param track_path The .mska file written by save_pose_track().
+     * @return true if the track was mapped; otherwise false.
+     */
+    bool load_pose_track(const std::string& track_path);
+
+    /**
+     * @brief Gets the number of frames of the mapped pose track.
+     * @return The frame count (0 if no track is mapped).
+     */
+    size_t get_pose_track_length() const;
+
+    /**
+     * @brief Decodes one frame of the mapped pose track into the output pose.
+     *
+     * Only that frame's keys are read from the file, so frames can be visited in any order
+     * without paging in the rest of the track.
+     *
+     * @param frame The frame to pose.
+     * @return true if the frame was decoded; otherwise false.
+     */
+    bool set_pose_track_frame(size_t frame);
+
+    /**
+     * @brief Skins every pose of the loaded sequence in one batch.
+     * @return true if skinning was successful; otherwise false.
+     */
+    bool perform_sequence_skinning();
+
+    /**
+     * @brief Saves every frame of the last batch to numbered OBJ files, in parallel.
+     * @param output_path The base output path; frame i is written to get_frame_path(output_path, i).
+     * @return true if every frame was saved successfully; otherwise false.
+     */
+    bool save_skinned_sequence(const std::string& output_path);
+
+    /**
+     * @brief Builds the numbered output path of one frame (e.g. "out.obj" -> "out_0007.obj").
+     * @param output_path The base output path.
+     * @param frame_index The index of the frame.
+     * @return The output path of the frame.
+     */
+    static std::string get_frame_path(const std::string& output_path, size_t frame_index);
+
     /**
      * @brief Performs the skinning operation using loaded data.
      * @return true if skinning was successful; otherwise false.
      */
     bool perform_skinning();
+
+    /**
+     * @brief Skins the loaded pose straight into a caller-owned position buffer.
+     *
+     * Meant to be called once per frame with a mapped vertex buffer, a shared-memory region
+     * or an interleaved vertex array: the skinned mesh is left untouched, nothing is logged,
+     * and once the first call has sized the scratch storage nothing is allocated either.
+     * When output is the buffer of the previous call, only the vertices of joints whose
+     * matrix changed are rewritten.
+     *
+     * Positions are converted to the buffer's format as they are written. For Unorm16
+     * buffers the frame's bounding box is stored in *output.bounds first; if it moved since
+     * the previous call, every vertex is rewritten against the new box.
+     *
+     * @param output The destination, holding at least as many vertices as the mesh.
+     * @return true if the pose was skinned into output; otherwise false.
+     */
+    bool perform_skinning(const PositionBuffer& output);
     
+    /**
+     * @brief Skins the loaded mesh against several pose palettes in a single pass.
+     *
+     * The vertex loop is tiled so that each block of rest positions and weights is
+     * skinned against a group of poses while it is still in cache, instead of
+     * re-streaming the whole mesh once per pose. Results are kept per pose and can
+     * be retrieved with get_batch_vertices() or save_batch_skinned_mesh().
+     *
+     * @param pose_palettes One vector of pose matrices (one per joint) for each pose.
+     * @return true if skinning was successful; otherwise false.
+     */
+    bool perform_batch_skinning(const std::vector<std::vector<HMM_Mat4>>& pose_palettes);
+
+    /**
+     * @brief Skins a crowd of instances of the loaded mesh, each with its own pose and placement.
+     *
+     * Every instance shares the rest positions, weights and inverse bind matrices held by
+     * this skinner; only its palette, folded with its world transform, and its output are
+     * its own. Dual quaternions can't hold scale or shear, so under dual quaternion skinning
+     * the world transform is not folded into the palette but applied to the skinned
+     * positions before they are scattered; scaled or sheared placements still come out
+     * right, at the cost of one extra affine transform per vertex. The work is tiled as (vertex block x group of instances) over all threads,
+     * each block's rest data staying in cache while the group is skinned, and every
+     * instance is scattered straight into its own buffer. Scratch memory grows with the
+     * thread count, not with the crowd, and nothing is logged.
+     *
+     * @param pose_palettes The pose matrices (one per joint) of each instance.
+     * @param world_transforms The transform placing each instance in the world.
+     * @param outputs The destination of each instance (Float32 or Float16; Unorm16 is only
+     *                supported by perform_skinning()).
+     * @return true if every instance was skinned; otherwise false.
+     */
+    bool perform_crowd_skinning(const std::vector<std::vector<HMM_Mat4>>& pose_palettes,
+                                const std::vector<HMM_Mat4>& world_transforms,
+                                const std::vector<PositionBuffer>& outputs);
+
+    /**
+     * @brief Gets the number of poses produced by the last perform_batch_skinning() call.
+     * @return The number of skinned poses.
+     */
+    size_t get_batch_size() const;
+
+    /**
+     * @brief Gets the skinned positions of one pose from the last batch.
+     * @param pose_index The index of the pose in the batch.
+     * @param vertices Receives the skinned vertices, in original vertex order.
+     */
+    void get_batch_vertices(size_t pose_index, std::vector<Vertex>& vertices) const;
+
+    /**
+     * @brief Saves one pose of the last batch to an OBJ file via ObjFacade.
+     * @param pose_index The index of the pose in the batch.
+     * @param output_path The path where the OBJ file will be saved.
+     * @return true if the mesh was saved successfully; otherwise false.
+     */
+    bool save_batch_skinned_mesh(size_t pose_index, const std::string& output_path) const;
+
+    /**
+     * @brief Sets how many output slots submit_skinning() rotates through.
+     *
+     * Waits for pending submissions first. Frames still held keep their old slot alive.
+     *
+     * @param slot_count 2 for double buffering (the default), 3 for triple buffering, ...
+     */
+    void set_output_slot_count(size_t slot_count);
+
+    /**
+     * @brief Gets the number of output slots submit_skinning() rotates through.
+     * @return The slot count.
+     */
+    size_t get_output_slot_count() const;
+
+    /**
+     * @brief Starts skinning a pose on a background thread and returns immediately.
+     *
+     * The pose is skinned into a free output slot once one is available, so frame N+1 can be
+     * skinned while the caller still reads frame N. Submissions complete in order. Until they
+     * have, the skinner's other methods must not be called, except submit_skinning() and
+     * wait_for_submissions(). Holding every slot's frame while waiting on a new one deadlocks.
+     *
+     * @param pose_matrices The pose matrices, one per joint.
+     * @return A future yielding the skinned frame, or rethrowing why the pose could not be skinned.
+     */
+    std::future<SkinnedFrame> submit_skinning(std::vector<HMM_Mat4> pose_matrices);
+
+    /**
+     * @brief Waits until every pose passed to submit_skinning() has been skinned.
+     */
+    void wait_for_submissions();
+
+    /**
+     * @brief Gets the mesh produced by the last perform_skinning() call without a buffer.
+     * @return The skinned mesh.
+     */
+    const Mesh& get_skinned_mesh() const;
+
+    /**
+     * @brief Bounds where a pose would put the skinned vertices, without touching them.
+     *
+     * Each joint's rest-space box (SkinningData::joint_rest_bounds) is moved by its skinning
+     * matrix and the results are merged, which takes O(joints). Linear blending keeps every
+     * vertex within its joints' moved boxes, so the box is conservative for linear blend
+     * skinning; dual quaternion blending can swing vertices slightly past it. Meant for
+     * culling and LOD decisions before an instance is skinned.
+     *
+     * @param pose_matrices The pose matrices, one per joint.
+     * @param world_transform The transform placing the instance in the world.
+     * @param bounds Receives the box.
+     * @return true if the pose could be bounded; otherwise false.
+     */
+    bool compute_pose_bounds(const std::vector<HMM_Mat4>& pose_matrices,
+                             const HMM_Mat4& world_transform, PositionBounds& bounds) const;
+
+    /**
+     * @brief Enables or disables computing the skinned bounds as a by-product of skinning.
+     *
+     * When enabled, each parallel task measures the box and sphere of every chunk it skins
+     * while the chunk is still in registers and cache, and the chunks are merged once the
+     * pass ends, so consumers need no second pass over the vertices. Incremental frames only
+     * re-measure the chunks they rewrite. Applies to perform_skinning() and submit_skinning().
+     *
+     * @param enabled Whether to compute the skinned bounds.
+     */
+    void set_bounds_tracking(bool enabled);
+
+    /**
+     * @brief Checks whether the skinned bounds are computed.
+     * @return true if enabled; otherwise false.
+     */
+    bool is_bounds_tracking() const;
+
+    /**
+     * @brief Gets the axis-aligned box of the last skinned pose (with bounds tracking enabled).
+     * @return The box.
+     */
+    const PositionBounds& get_skinned_box() const;
+
+    /**
+     * @brief Gets a bounding sphere of the last skinned pose (with bounds tracking enabled).
+     *
+     * Centered on the box; not the minimal sphere, but never larger than half the box's diagonal.
+     *
+     * @return The sphere.
+     */
+    const BoundingSphere& get_skinned_sphere() const;
+
     /**
      * @brief Saves the skinned mesh to an OBJ file via ObjFacade.
      * @param output_path The path where the OBJ file will be saved.
@@ -72,12 +615,201 @@ public:
 
 protected:
 
+    /**
+     * @brief Skins a pose into a buffer, checking the loaded data and the buffer first.
+     * @param pose_matrices The pose matrices, one per joint.
+     * @param output The destination of the skinned positions.
+     * @return true if the pose was skinned into output; otherwise false.
+     */
+    bool skin_pose(const std::vector<HMM_Mat4>& pose_matrices, const PositionBuffer& output);
+
+    /**
+     * @brief Runs the poses passed to submit_skinning(), one at a time, until the skinner is destroyed.
+     */
+    void run_submissions();
+
     /**
      * @brief Applies precomputed transformations to each vertex to produce the skinned mesh.
      *
+     * With dual quaternion skinning, the matrices are first converted to one unit dual
+     * quaternion per joint. If the streams already hold the result of a previous palette,
+     * only the vertices influenced by joints whose matrix changed are re-skinned.
+     *
      * @param precomputed_matrices A vector of precomputed skinning matrices for each joint.
+     * @param output The buffer receiving the skinned positions, in original vertex order.
+     * @return The number of entries re-skinned (padding included).
      */
-    void apply_vertex_transformations(const std::vector<HMM_Mat4>& precomputed_matrices);
+    size_t apply_vertex_transformations(const std::vector<HMM_Mat4>& precomputed_matrices,
+                                        const PositionBuffer& output);
+
+    /**
+     * @brief Merges the chunk bounds into skinned_box and skinned_sphere.
+     */
+    void merge_chunk_bounds();
+
+    /**
+     * @brief Lists the vertex ranges affected by joints whose skinning matrix changed.
+     * @param precomputed_matrices The skinning matrices of the new pose.
+     * @param blocks Receives the ranges (chunk aligned, each within one influence bucket).
+     * @param changed_joints Receives the number of joints whose matrix changed.
+     * @return true if the ranges were found; false if the whole mesh must be re-skinned.
+     */
+    bool find_changed_blocks(const std::vector<HMM_Mat4>& precomputed_matrices,
+                             std::vector<VertexBuckets::Bucket>& blocks,
+                             size_t& changed_joints);
+
+    /**
+     * @brief Rebuilds the bucketed vertex order and the kernel streams once mesh and weights agree.
+     */
+    void build_skinning_streams();
+
+    /**
+     * @brief Moves the skinning streams into pages first touched by the workers that skin them.
+     *
+     * Each block of perform_skinning() is copied by a task of the same loop shape, so in
+     * NUMA-aware mode it lands on the node that later skins it.
+     */
+    void place_streams_on_nodes();
+
+    /**
+     * @brief Regroups the loaded morph targets by influence chunk of the bucketed vertex order.
+     *
+     * Leaves morph_streams empty (and reports why) if a target moves a vertex the mesh lacks.
+     */
+    void build_morph_streams();
+
+    /**
+     * @brief Brings every morphed chunk up to the current morph weights, for loops that skin
+     *        the same block more than once.
+     * @return The rest positions the kernels should read (morphed_positions while morphing).
+     */
+    const VertexStreams& sync_morphed_positions();
+
+    /**
+     * @brief Splits every influence bucket into ranges of at most block_size vertices.
+     * @param block_size The maximum range size (a multiple of InfluenceStreams::CHUNK_SIZE).
+     * @return The ranges, each tagged with the influence count of its bucket; one per meshlet
+     *         instead when meshlet tiling is enabled.
+     */
+    std::vector<VertexBuckets::Bucket> split_buckets(size_t block_size) const;
+
+    /**
+     * @brief Checks that the mesh, weights and inverse bind matrices are loaded and consistent.
+     * @return true if skinning can proceed; otherwise false.
+     */
+    bool validate_skinning_data() const;
+
+    /**
+     * @brief Checks that a pose covers every joint the baked weights reference.
+     *
+     * Joint IDs are validated here, once per pose, so the kernels can index the palette
+     * without any checks.
+     *
+     * @param pose_matrices The pose matrices, one per joint.
+     * @return true if the pose can be skinned; otherwise false.
+     */
+    bool validate_pose_matrices(const std::vector<HMM_Mat4>& pose_matrices) const;
+
+    /**
+     * @brief Checks that a caller-owned buffer can receive every skinned vertex.
+     * @param output The destination of the skinned positions.
+     * @return true if the buffer is large enough, aligned and complete; otherwise false.
+     */
+    bool validate_output_buffer(const PositionBuffer& output) const;
+
+    /**
+     * @brief Cleans parsed weights once, so skinning never has to.
+     *
+     * Negligible and invalid influences are dropped, the remaining weights of each vertex
+     * are renormalized to sum to 1 and sorted by decreasing weight. Runs in parallel.
+     *
+     * @param weights The weights as parsed.
+     * @return The baked weights.
+     * @throws std::runtime_error if a weight is not finite.
+     */
+    SparseWeights bake_weights(const SparseWeights& weights);
+
+    /**
+     * @brief Computes the world matrix of every joint of the skeleton from local transforms.
+     * @param local_transforms The transform of each joint relative to its parent.
+     * @param world_matrices Receives the world matrix of each joint, in joint order.
+     */
+    void evaluate_skeleton(const std::vector<JointTransform>& local_transforms,
+                           std::vector<HMM_Mat4>& world_matrices);
+
+    /**
+     * @brief Samples the loaded animation clip into the pose matrices of one frame.
+     * @param time The time to sample at, in seconds.
+     * @param pose_matrices Receives the pose matrix of each joint.
+     * @return true if the clip was sampled; false if none is loaded or it doesn't fit the skeleton.
+     */
+    bool sample_clip_pose(float time, std::vector<HMM_Mat4>& pose_matrices);
+
+    /**
+     * @brief Computes the skinning matrices (pose * inverse bind) for one pose.
+     * @param pose_matrices The pose matrices, one per joint.
+     * @param precomputed_matrices Receives the skinning matrices.
+     */
+    void compute_skinning_matrices(const std::vector<HMM_Mat4>& pose_matrices,
+                                   std::vector<HMM_Mat4>& precomputed_matrices) const;
+
+    /**
+     * @brief Converted copies of one pose's skinning matrices, in the layout a kernel reads.
+     */
+    struct ConvertedPalette
+    {
+        /**
+         * @brief 3x4 matrices for affine linear blend skinning.
+         */
+        std::vector<AffineMatrix> affine_matrices;
+
+        /**
+         * @brief Unit dual quaternions for dual quaternion skinning.
+         */
+        std::vector<DualQuaternion> dual_quaternions;
+    };
+
+    /**
+     * @brief Attaches a pose's palette to a kernel job, in the form the skinning method reads.
+     *
+     * Linear blend palettes are repacked as 3x4 matrices; the bottom row is ignored.
+     *
+     * @param precomputed_matrices The skinning matrices for the pose.
+     * @param converted_palette Storage for the repacked palette (must outlive the job).
+     * @param job The job whose palette pointer is set.
+     */
+    void bind_palette(const std::vector<HMM_Mat4>& precomputed_matrices,
+                      ConvertedPalette& converted_palette,
+                      SkinningKernels::SkinningJob& job) const;
+
+    /**
+     * @brief Sizes the meshlet sub-palettes for the palette a job reads.
+     * @param job A job whose palette has been bound.
+     * @param meshlet_palette Receives room for every meshlet's joints.
+     */
+    void reserve_meshlet_palette(const SkinningKernels::SkinningJob& job,
+                                 ConvertedPalette& meshlet_palette) const;
+
+    /**
+     * @brief Gathers the palette entries a meshlet uses and points a copy of the job at them.
+     *
+     * Each meshlet owns its own range of meshlet_palette, so meshlets can be bound in parallel.
+     *
+     * @param job A job whose palette has been bound.
+     * @param meshlet The meshlet about to be skinned.
+     * @param meshlet_palette Storage sized by reserve_meshlet_palette().
+     * @return The job, reading the meshlet's sub-palette with its local joint IDs.
+     */
+    SkinningKernels::SkinningJob bind_meshlet_palette(const SkinningKernels::SkinningJob& job,
+                                                      const Meshlets::Meshlet& meshlet,
+                                                      ConvertedPalette& meshlet_palette) const;
+
+    /**
+     * @brief Picks the kernel instantiation for the skinning method and influence count.
+     * @param influence_count The influence count of the vertex range.
+     * @return The kernel to run the range with.
+     */
+    SkinningKernels::SkinVerticesFn select_kernel(size_t influence_count) const;
 
     /**
      * @brief Records the execution time of an operation.
@@ -88,6 +820,27 @@ protected:
 
     // Threshold below which joint weights are considered negligible.
     static const float WEIGHT_THRESHOLD;
+
+    // Default number of vertices handed to the SIMD kernel per parallel task.
+    static const size_t SKINNING_BLOCK_SIZE;
+
+    // Number of vertices per tile when skinning a batch of poses (sized to stay in L1).
+    static const size_t BATCH_BLOCK_SIZE;
+
+    // Number of poses skinned against one tile before moving on to the next.
+    static const size_t BATCH_POSE_GROUP_SIZE;
+
+    // Number of output slots submit_skinning() rotates through by default (double buffering).
+    static const size_t DEFAULT_OUTPUT_SLOT_COUNT;
+
+    // Number of joints per parallel task when evaluating the skeleton.
+    static const size_t SKELETON_BLOCK_SIZE;
+
+    // Number of frames per parallel task when decoding a whole pose track.
+    static const size_t TRACK_DECODE_BLOCK_SIZE;
+
+    // Largest thread pool the skinner creates; larger requests are clamped to it.
+    static const size_t MAX_THREAD_COUNT;
     
 private:
 
@@ -98,6 +851,87 @@ private:
     // The skinning data including weights and skinning matrices.
     SkinningData skin_data;
 
+    // The SIMD kernels selected for this CPU.
+    const SkinningKernels::KernelTable* kernels;
+    // The blending algorithm used by perform_skinning().
+    SkinningMethod skinning_method;
+    // Workers for the parallel load, skin and save loops.
+    std::unique_ptr<ThreadPool> thread_pool;
+    // Number of vertices handed to the SIMD kernel per parallel task.
+    size_t grain_size;
+    // Whether the pool is pinned per NUMA node and the streams placed accordingly.
+    bool numa_aware;
+    // How compactly influence_streams stores the weights.
+    WeightPrecision weight_precision;
+    // Whether the vertex range is tiled into meshlets with local joint IDs.
+    bool meshlet_tiling;
+    // Whether skinning also measures skinned_box and skinned_sphere.
+    bool bounds_tracking;
+
+    // One more than the largest joint ID the baked weights reference.
+    size_t referenced_joint_count;
+
+    // Vertex order grouping vertices by influence count, shared by all streams below.
+    VertexBuckets vertex_buckets;
+    // Rest positions of the original mesh in SoA form, fed to the SIMD kernel.
+    VertexStreams rest_positions;
+    // Skinned positions in SoA form, written by the SIMD kernel.
+    VertexStreams skinned_positions;
+    // Joint influences in SoA form, fed to the SIMD kernel.
+    InfluenceStreams influence_streams;
+    // The influence chunks of each joint, to re-skin only what a pose edit moves.
+    JointChunkIndex joint_chunk_index;
+    // The meshlets of vertex_buckets (empty unless meshlet_tiling is set).
+    Meshlets meshlets;
+    // The morph targets of skin_data by influence chunk (empty unless a target moves a vertex).
+    MorphStreams morph_streams;
+    // Rest positions with the morph targets applied, read by the kernels while morphing.
+    VertexStreams morphed_positions;
+    // The morph weights morphed_positions and skinned_positions were last computed with.
+    std::vector<float> morphed_weights;
+    std::vector<float> skinned_morph_weights;
+    // The palette skinned_positions was last computed from (empty when out of date).
+    std::vector<HMM_Mat4> skinned_palette;
+    // The buffer last written with every vertex of skinned_positions.
+    PositionBuffer synced_output;
+    // The box, and the radius around the box's center, of each influence chunk of
+    // skinned_positions, kept while tracking bounds or skinning into Unorm16 buffers
+    // (chunk_bounds_current says whether every chunk's bounds are up to date).
+    std::vector<PositionBounds> chunk_bounds;
+    std::vector<float> chunk_radii;
+    bool chunk_bounds_current = false;
+    // The bounds of skinned_positions, merged from the chunks.
+    PositionBounds skinned_box;
+    BoundingSphere skinned_sphere;
+    // The box synced_output was last normalized to.
+    PositionBounds synced_bounds;
+    // split_buckets(grain_size), kept for the per-pose loops.
+    std::vector<VertexBuckets::Bucket> skinning_blocks;
+
+    // Per-pose scratch storage, kept so that skinning a pose reuses its allocations.
+    std::vector<HMM_Mat4> pose_skinning_matrices;
+    ConvertedPalette converted_palette;
+    ConvertedPalette meshlet_palette;
+    std::vector<VertexBuckets::Bucket> changed_blocks;
+    std::vector<uint8_t> changed_chunks;
+    // Local, parent and world matrices of the skeleton's joints, in level order.
+    std::vector<HMM_Mat4> skeleton_local;
+    std::vector<HMM_Mat4> skeleton_parent;
+    std::vector<HMM_Mat4> skeleton_world;
+    // Joint transforms sampled from the animation clip, in joint order.
+    std::vector<JointTransform> clip_transforms;
+    // Pose palettes loaded by load_pose_sequence().
+    std::vector<std::vector<HMM_Mat4>> pose_sequence;
+    // Compressed poses mapped by load_pose_track().
+    PoseTrack pose_track;
+    // Skinned positions of each pose from the last batch.
+    std::vector<VertexStreams> batch_positions;
+
+    // Output slots and queued poses of submit_skinning(), with the thread running them.
+    struct AsyncSkinning;
+    std::unique_ptr<AsyncSkinning> async_skinning;
+    std::thread async_thread;
+
     // Performance tracking
     std::unordered_map<std::string, double> timing_metrics;
 };
\ No newline at end of file
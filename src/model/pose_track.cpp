@@ -0,0 +1,527 @@
+#include "pose_track.h"
+
+// Standard library imports
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+// Local application imports
+#include "facade/math_facade.h"
+#include "model/skinning_data.h"
+
+// Platform-specific includes
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace {
+
+constexpr char MAGIC[4] = { 'M', 'S', 'K', 'A' };
+constexpr uint32_t VERSION = 1;
+
+// Header, then per joint its flags and 16 range floats
+constexpr size_t HEADER_SIZE = 32;
+constexpr size_t JOINT_TRACK_SIZE = sizeof(uint32_t) + 16 * sizeof(float);
+
+// Which of a joint's tracks change, and so have keys in every frame
+constexpr uint32_t ANIMATED_TRANSLATION = 1;
+constexpr uint32_t ANIMATED_ROTATION = 2;
+constexpr uint32_t ANIMATED_SCALE = 4;
+
+// Every animated track stores three 16-bit words per frame
+using Key = std::array<uint16_t, 3>;
+constexpr size_t KEY_SIZE = sizeof(Key);
+
+// Tracks that stay within this distance of their first value are stored once
+constexpr float CONSTANT_TOLERANCE = .00001f;
+
+// Largest difference between a matrix and its recomposed tracks, relative to the matrix's
+// largest scale, before the matrix counts as sheared
+constexpr float SHEAR_TOLERANCE = .001f;
+
+// The three smallest components of a unit quaternion lie within +-1/sqrt(2)
+constexpr float SMALLEST_THREE_RANGE = .70710678f;
+constexpr float UNORM15_MAX = 32767.f;
+constexpr float UNORM16_MAX = 65535.f;
+
+template <typename T>
+void put(std::vector<uint8_t>& buffer, const T& value)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+// The mapping gives no alignment guarantees past the header, so fields are copied out
+template <typename T>
+T get(const uint8_t* bytes)
+{
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+uint16_t quantize(float unit, float max_value)
+{
+    return static_cast<uint16_t>(std::lround(std::clamp(unit, 0.f, 1.f) * max_value));
+}
+
+Key encode_range(const HMM_Vec3& value, const HMM_Vec3& min, const HMM_Vec3& extent)
+{
+    Key key;
+    for (int c = 0; c < 3; c++)
+    {
+        key[c] = extent.Elements[c] > 0.f ?
+            quantize((value.Elements[c] - min.Elements[c]) / extent.Elements[c], UNORM16_MAX) : 0;
+    }
+    return key;
+}
+
+HMM_Vec3 decode_range(const Key& key, const HMM_Vec3& min, const HMM_Vec3& extent)
+{
+    HMM_Vec3 value;
+    for (int c = 0; c < 3; c++)
+    {
+        value.Elements[c] = min.Elements[c] + extent.Elements[c] * (key[c] / UNORM16_MAX);
+    }
+    return value;
+}
+
+// Drops the largest component, which is rebuilt from the unit length; its index goes in
+// the top bits of the first two words
+Key encode_rotation(HMM_Quat rotation)
+{
+    rotation = HMM_NormQ(rotation);
+    int largest = 0;
+    for (int c = 1; c < 4; c++)
+    {
+        if (std::fabs(rotation.Elements[c]) > std::fabs(rotation.Elements[largest]))
+            largest = c;
+    }
+
+    // q and -q are the same rotation; keeping the dropped component positive spares its sign
+    const float sign = rotation.Elements[largest] < 0.f ? -1.f : 1.f;
+
+    Key key;
+    int slot = 0;
+    for (int c = 0; c < 4; c++)
+    {
+        if (c == largest)
+            continue;
+        const float unit = (sign * rotation.Elements[c] / SMALLEST_THREE_RANGE + 1.f) * .5f;
+        key[slot++] = quantize(unit, UNORM15_MAX);
+    }
+    key[0] |= static_cast<uint16_t>((largest >> 1) << 15);
+    key[1] |= static_cast<uint16_t>((largest & 1) << 15);
+    return key;
+}
+
+HMM_Quat decode_rotation(const Key& key)
+{
+    const int largest = ((key[0] >> 15) << 1) | (key[1] >> 15);
+
+    HMM_Quat rotation;
+    float length_squared = 0.f;
+    int slot = 0;
+    for (int c = 0; c < 4; c++)
+    {
+        if (c == largest)
+            continue;
+        const float unit = (key[slot++] & 0x7FFF) / UNORM15_MAX;
+        rotation.Elements[c] = (unit * 2.f - 1.f) * SMALLEST_THREE_RANGE;
+        length_squared += rotation.Elements[c] * rotation.Elements[c];
+    }
+    rotation.Elements[largest] = std::sqrt(std::max(0.f, 1.f - length_squared));
+    return rotation;
+}
+
+size_t keys_per_frame(uint32_t flags)
+{
+    return ((flags & ANIMATED_TRANSLATION) ? 1 : 0) + ((flags & ANIMATED_ROTATION) ? 1 : 0) +
+           ((flags & ANIMATED_SCALE) ? 1 : 0);
+}
+
+void put_key(std::vector<uint8_t>& buffer, const Key& key)
+{
+    for (const uint16_t word : key)
+        put(buffer, word);
+}
+
+Key get_key(const uint8_t* bytes)
+{
+    return { get<uint16_t>(bytes), get<uint16_t>(bytes + 2), get<uint16_t>(bytes + 4) };
+}
+
+} // namespace
+
+PoseTrack::~PoseTrack()
+{
+    close();
+}
+
+size_t PoseTrack::save(const std::string& track_path,
+                       const std::vector<std::vector<HMM_Mat4>>& palettes)
+{
+    if (palettes.empty())
+    {
+        throw std::invalid_argument("A pose track needs at least one frame");
+    }
+
+    const size_t joint_count = palettes[0].size();
+    const size_t frame_count = palettes.size();
+    if (joint_count > UINT32_MAX || frame_count > UINT32_MAX)
+    {
+        throw std::invalid_argument("Too many joints or frames for a pose track");
+    }
+
+    // Split every matrix into the tracks it is stored as
+    std::vector<JointTransform> transforms(frame_count * joint_count);
+    for (size_t frame = 0; frame < frame_count; frame++)
+    {
+        if (palettes[frame].size() != joint_count)
+        {
+            throw std::invalid_argument("Frame " + std::to_string(frame) + " has " +
+                                        std::to_string(palettes[frame].size()) + " joints instead of " +
+                                        std::to_string(joint_count));
+        }
+
+        for (size_t joint = 0; joint < joint_count; joint++)
+        {
+            const HMM_Mat4& matrix = palettes[frame][joint];
+            if (matrix.Elements[0][3] != 0.f || matrix.Elements[1][3] != 0.f ||
+                matrix.Elements[2][3] != 0.f || matrix.Elements[3][3] != 1.f)
+            {
+                throw std::invalid_argument("Joint " + std::to_string(joint) + " of frame " +
+                                            std::to_string(frame) + " is projective");
+            }
+
+            JointTransform& transform = transforms[frame * joint_count + joint];
+            MathFacade::decompose(matrix, transform.translation, transform.rotation, transform.scale);
+
+            // decompose() drops shear, so the tracks must rebuild the matrix they came from
+            const HMM_Mat4 recomposed =
+                MathFacade::compose(transform.translation, transform.rotation, transform.scale);
+            float largest_scale = 1.f;
+            float round_trip_error = 0.f;
+            for (int c = 0; c < 3; c++)
+            {
+                largest_scale = std::max(largest_scale, std::fabs(transform.scale.Elements[c]));
+                for (int r = 0; r < 3; r++)
+                {
+                    round_trip_error = std::max(round_trip_error,
+                                                std::fabs(recomposed.Elements[c][r] - matrix.Elements[c][r]));
+                }
+            }
+            if (round_trip_error > SHEAR_TOLERANCE * largest_scale)
+            {
+                throw std::invalid_argument("Joint " + std::to_string(joint) + " of frame " +
+                                            std::to_string(frame) + " has shear");
+            }
+
+            // Keep each rotation track on one hemisphere, so an unchanging rotation reads as constant
+            if (frame > 0 &&
+                HMM_DotQ(transforms[(frame - 1) * joint_count + joint].rotation, transform.rotation) < 0.f)
+            {
+                transform.rotation = HMM_MulQF(transform.rotation, -1.f);
+            }
+        }
+    }
+
+    // The range each track covers decides whether it is keyed and how it is quantized
+    std::vector<JointTrack> tracks(joint_count);
+    size_t frame_size = 0;
+    for (size_t joint = 0; joint < joint_count; joint++)
+    {
+        const JointTransform& first = transforms[joint];
+        HMM_Vec3 translation_max = first.translation;
+        HMM_Vec3 scale_max = first.scale;
+        float rotation_change = 0.f;
+
+        JointTrack& track = tracks[joint];
+        track.translation_min = first.translation;
+        track.rotation = first.rotation;
+        track.scale_min = first.scale;
+        for (size_t frame = 1; frame < frame_count; frame++)
+        {
+            const JointTransform& transform = transforms[frame * joint_count + joint];
+            for (int c = 0; c < 3; c++)
+            {
+                track.translation_min.Elements[c] = std::min(track.translation_min.Elements[c],
+                                                             transform.translation.Elements[c]);
+                translation_max.Elements[c] = std::max(translation_max.Elements[c],
+                                                       transform.translation.Elements[c]);
+                track.scale_min.Elements[c] = std::min(track.scale_min.Elements[c], transform.scale.Elements[c]);
+                scale_max.Elements[c] = std::max(scale_max.Elements[c], transform.scale.Elements[c]);
+            }
+            for (int c = 0; c < 4; c++)
+            {
+                rotation_change = std::max(rotation_change,
+                                           std::fabs(transform.rotation.Elements[c] - first.rotation.Elements[c]));
+            }
+        }
+        track.translation_extent = HMM_SubV3(translation_max, track.translation_min);
+        track.scale_extent = HMM_SubV3(scale_max, track.scale_min);
+
+        track.flags = 0;
+        if (std::max({ track.translation_extent.X, track.translation_extent.Y,
+                       track.translation_extent.Z }) > CONSTANT_TOLERANCE)
+            track.flags |= ANIMATED_TRANSLATION;
+        else
+            track.translation_extent = HMM_V3(0.f, 0.f, 0.f);
+
+        if (rotation_change > CONSTANT_TOLERANCE)
+            track.flags |= ANIMATED_ROTATION;
+
+        if (std::max({ track.scale_extent.X, track.scale_extent.Y, track.scale_extent.Z }) > CONSTANT_TOLERANCE)
+            track.flags |= ANIMATED_SCALE;
+        else
+            track.scale_extent = HMM_V3(0.f, 0.f, 0.f);
+
+        frame_size += keys_per_frame(track.flags) * KEY_SIZE;
+    }
+
+    // Header, track table and frame index are written up front; frames follow one at a time
+    const uint64_t frame_index_offset = HEADER_SIZE + joint_count * JOINT_TRACK_SIZE;
+    const uint64_t first_frame_offset = frame_index_offset + frame_count * sizeof(uint64_t);
+
+    std::vector<uint8_t> buffer;
+    buffer.insert(buffer.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    put(buffer, VERSION);
+    put(buffer, static_cast<uint32_t>(joint_count));
+    put(buffer, static_cast<uint32_t>(frame_count));
+    put(buffer, static_cast<uint32_t>(frame_size));
+    put(buffer, uint32_t(0));
+    put(buffer, frame_index_offset);
+
+    for (const JointTrack& track : tracks)
+    {
+        put(buffer, track.flags);
+        for (const float value : track.translation_min.Elements) put(buffer, value);
+        for (const float value : track.translation_extent.Elements) put(buffer, value);
+        for (const float value : track.rotation.Elements) put(buffer, value);
+        for (const float value : track.scale_min.Elements) put(buffer, value);
+        for (const float value : track.scale_extent.Elements) put(buffer, value);
+    }
+
+    for (size_t frame = 0; frame < frame_count; frame++)
+    {
+        put(buffer, static_cast<uint64_t>(first_frame_offset + frame * frame_size));
+    }
+
+    std::ofstream file(track_path, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("Cannot open pose track for writing: " + track_path);
+    }
+    file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+
+    for (size_t frame = 0; frame < frame_count; frame++)
+    {
+        buffer.clear();
+        for (size_t joint = 0; joint < joint_count; joint++)
+        {
+            const JointTrack& track = tracks[joint];
+            const JointTransform& transform = transforms[frame * joint_count + joint];
+            if (track.flags & ANIMATED_TRANSLATION)
+                put_key(buffer, encode_range(transform.translation, track.translation_min, track.translation_extent));
+            if (track.flags & ANIMATED_ROTATION)
+                put_key(buffer, encode_rotation(transform.rotation));
+            if (track.flags & ANIMATED_SCALE)
+                put_key(buffer, encode_range(transform.scale, track.scale_min, track.scale_extent));
+        }
+        file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    }
+
+    if (!file)
+    {
+        throw std::runtime_error("Failed to write pose track: " + track_path);
+    }
+    return static_cast<size_t>(first_frame_offset + frame_count * frame_size);
+}
+
+void PoseTrack::open(const std::string& track_path)
+{
+    close();
+
+#if defined(_WIN32)
+    const HANDLE file = CreateFileA(track_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Cannot open pose track: " + track_path);
+    }
+
+    // The view keeps the mapping alive once both handles are closed
+    LARGE_INTEGER file_bytes;
+    const void* view = nullptr;
+    if (GetFileSizeEx(file, &file_bytes) && file_bytes.QuadPart > 0)
+    {
+        const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr)
+        {
+            view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+
+    if (view == nullptr)
+    {
+        throw std::runtime_error("Cannot map pose track: " + track_path);
+    }
+    data = static_cast<const uint8_t*>(view);
+    size = static_cast<size_t>(file_bytes.QuadPart);
+#else
+    const int file = ::open(track_path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        throw std::runtime_error("Cannot open pose track: " + track_path);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    struct stat status;
+    void* view = MAP_FAILED;
+    if (fstat(file, &status) == 0 && status.st_size > 0)
+    {
+        view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    }
+    ::close(file);
+
+    if (view == MAP_FAILED)
+    {
+        throw std::runtime_error("Cannot map pose track: " + track_path);
+    }
+    data = static_cast<const uint8_t*>(view);
+    size = static_cast<size_t>(status.st_size);
+#endif
+
+    try
+    {
+        if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0)
+        {
+            throw std::runtime_error("Not a pose track: " + track_path);
+        }
+
+        const uint32_t version = get<uint32_t>(data + 4);
+        if (version != VERSION)
+        {
+            throw std::runtime_error("Unsupported pose track version " + std::to_string(version));
+        }
+
+        const size_t joint_count = get<uint32_t>(data + 8);
+        frames = get<uint32_t>(data + 12);
+        frame_size = get<uint32_t>(data + 16);
+        frame_index_offset = get<uint64_t>(data + 24);
+
+        // Every size is checked against the file before anything is read through it
+        if ((size - HEADER_SIZE) / JOINT_TRACK_SIZE < joint_count)
+        {
+            throw std::runtime_error("Pose track table is truncated");
+        }
+        if (frame_index_offset > size || (size - frame_index_offset) / sizeof(uint64_t) < frames)
+        {
+            throw std::runtime_error("Pose track frame index is truncated");
+        }
+
+        tracks.resize(joint_count);
+        size_t expected_frame_size = 0;
+        for (size_t joint = 0; joint < joint_count; joint++)
+        {
+            const uint8_t* entry = data + HEADER_SIZE + joint * JOINT_TRACK_SIZE;
+            std::array<float, 16> values;
+            std::memcpy(values.data(), entry + sizeof(uint32_t), sizeof(values));
+
+            JointTrack& track = tracks[joint];
+            track.flags = get<uint32_t>(entry);
+            track.translation_min = HMM_V3(values[0], values[1], values[2]);
+            track.translation_extent = HMM_V3(values[3], values[4], values[5]);
+            track.rotation = HMM_Q(values[6], values[7], values[8], values[9]);
+            track.scale_min = HMM_V3(values[10], values[11], values[12]);
+            track.scale_extent = HMM_V3(values[13], values[14], values[15]);
+            expected_frame_size += keys_per_frame(track.flags) * KEY_SIZE;
+        }
+
+        if (expected_frame_size != frame_size)
+        {
+            throw std::runtime_error("Pose track frame size doesn't match its track table");
+        }
+    }
+    catch (...)
+    {
+        close();
+        throw;
+    }
+}
+
+void PoseTrack::close()
+{
+    if (data != nullptr)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(data);
+#else
+        munmap(const_cast<uint8_t*>(data), size);
+#endif
+    }
+
+    data = nullptr;
+    size = 0;
+    frames = 0;
+    frame_size = 0;
+    frame_index_offset = 0;
+    tracks.clear();
+}
+
+void PoseTrack::decode_frame(size_t frame, std::vector<HMM_Mat4>& pose_matrices) const
+{
+    if (frame >= frames)
+    {
+        throw std::out_of_range("Frame " + std::to_string(frame) + " is past the end of the pose track (" +
+                                std::to_string(frames) + " frames)");
+    }
+
+    const uint64_t offset = get<uint64_t>(data + frame_index_offset + frame * sizeof(uint64_t));
+    if (offset > size || size - offset < frame_size)
+    {
+        throw std::runtime_error("Frame " + std::to_string(frame) + " of the pose track lies outside the file");
+    }
+
+    // Constant tracks keep the value from the track table
+    const uint8_t* keys = data + offset;
+    pose_matrices.resize(tracks.size());
+    for (size_t joint = 0; joint < tracks.size(); joint++)
+    {
+        const JointTrack& track = tracks[joint];
+        HMM_Vec3 translation = track.translation_min;
+        HMM_Quat rotation = track.rotation;
+        HMM_Vec3 scale = track.scale_min;
+
+        if (track.flags & ANIMATED_TRANSLATION)
+        {
+            translation = decode_range(get_key(keys), track.translation_min, track.translation_extent);
+            keys += KEY_SIZE;
+        }
+        if (track.flags & ANIMATED_ROTATION)
+        {
+            rotation = decode_rotation(get_key(keys));
+            keys += KEY_SIZE;
+        }
+        if (track.flags & ANIMATED_SCALE)
+        {
+            scale = decode_range(get_key(keys), track.scale_min, track.scale_extent);
+            keys += KEY_SIZE;
+        }
+
+        pose_matrices[joint] = MathFacade::compose(translation, rotation, scale);
+    }
+}
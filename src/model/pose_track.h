@@ -0,0 +1,133 @@
+#pragma once
+
+// Standard library imports
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Third-party imports
+#include "handmade_math/handmade_math.h"
+
+
+/**
+ * @brief A compressed sequence of pose palettes, read through a memory-mapped file.
+ *
+ * Every palette matrix is split into a translation, rotation and scale track per joint.
+ * Rotations are packed "smallest three" into 48 bits, translations and scales are quantized
+ * to 16 bits per component within the range the track covers, and a track that never
+ * changes is stored once in the track table instead of in every frame. A frame index
+ * locates the keys of each frame, so decoding a frame only touches the pages that hold it.
+ *
+ * File layout (little-endian):
+ * - Header: "MSKA", version, joint count, frame count, bytes per frame, reserved word,
+ *   and the 64-bit offset of the frame index.
+ * - Track table: per joint, the flags of its animated tracks, then the translation
+ *   minimum and extent, the constant rotation and the scale minimum and extent.
+ * - Frame index: the 64-bit file offset of each frame.
+ * - Frames: per joint, three 16-bit words for each animated track (translation,
+ *   rotation, scale, in that order).
+ */
+class PoseTrack
+{
+public:
+
+    PoseTrack() = default;
+
+    /**
+     * @brief Unmaps the file, if one is open.
+     */
+    ~PoseTrack();
+
+    PoseTrack(const PoseTrack&) = delete;
+    PoseTrack& operator=(const PoseTrack&) = delete;
+
+    /**
+     * @brief Compresses a sequence of palettes into a track file.
+     * @param track_path The path of the file to write.
+     * @param palettes The palettes, one per frame, all with the same joint count.
+     * @return The size of the written file in bytes.
+     * @throws std::invalid_argument if there are no frames, the joint counts differ or a
+     *         matrix is projective or sheared (translation, rotation and scale can't
+     *         rebuild it).
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    static size_t save(const std::string& track_path,
+                       const std::vector<std::vector<HMM_Mat4>>& palettes);
+
+    /**
+     * @brief Maps a track file, closing the one open before.
+     *
+     * Only the header and track table are read here; frames are paged in as they are decoded.
+     *
+     * @param track_path The path of the file to map.
+     * @throws std::runtime_error if the file cannot be mapped or is not a valid track.
+     */
+    void open(const std::string& track_path);
+
+    /**
+     * @brief Unmaps the open file.
+     */
+    void close();
+
+    /**
+     * @brief Checks whether a file is mapped.
+     * @return true if open() succeeded and close() wasn't called since.
+     */
+    bool is_open() const { return data != nullptr; }
+
+    /**
+     * @brief Gets the number of joints of each palette.
+     * @return The joint count (0 if no file is open)
+     */
+    size_t joint_count() const { return tracks.size(); }
+
+    /**
+     * @brief Gets the number of frames in the file.
+     * @return The frame count (0 if no file is open)
+     */
+    size_t frame_count() const { return frames; }
+
+    /**
+     * @brief Gets the size of the mapped file.
+     * @return The size in bytes (0 if no file is open)
+     */
+    size_t file_size() const { return size; }
+
+    /**
+     * @brief Decodes one frame back into a palette.
+     *
+     * Safe to call from several threads at once.
+     *
+     * @param frame The frame to decode.
+     * @param pose_matrices Receives the palette, resized to the joint count.
+     * @throws std::out_of_range if the frame is past the end of the track.
+     * @throws std::runtime_error if the frame index points outside the file.
+     */
+    void decode_frame(size_t frame, std::vector<HMM_Mat4>& pose_matrices) const;
+
+private:
+
+    /**
+     * @brief The ranges of one joint's tracks, copied out of the track table.
+     */
+    struct JointTrack
+    {
+        uint32_t flags;
+        HMM_Vec3 translation_min;
+        HMM_Vec3 translation_extent;
+        HMM_Quat rotation;
+        HMM_Vec3 scale_min;
+        HMM_Vec3 scale_extent;
+    };
+
+    // The mapped file
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+
+    // Decoded from the header and track table
+    size_t frames = 0;
+    size_t frame_size = 0;
+    uint64_t frame_index_offset = 0;
+    std::vector<JointTrack> tracks;
+};
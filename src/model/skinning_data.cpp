@@ -2,13 +2,46 @@
 
 // Standard library imports
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <stdexcept>
+#include <string>
 
 // Local application imports
 #include "facade/json_facade.h"
 #include "facade/math_facade.h"
+#include "model/mesh.h"
 
 
+namespace {
+
+// Reads the optional translation, rotation and scale of a joint object
+void read_joint_transform(const Json& joint_data, JointTransform& transform)
+{
+    // Reads a fixed-size float array into consecutive floats
+    auto read_floats = [](const Json& values, float* target, size_t count, const char* name)
+    {
+        if (values.size() != count)
+        {
+            throw std::runtime_error(std::string("Joint ") + name + " must contain exactly "
+                                     + std::to_string(count) + " elements");
+        }
+        for (size_t elem_idx = 0; elem_idx < count; elem_idx++)
+        {
+            target[elem_idx] = values.at(elem_idx).as_float();
+        }
+    };
+
+    if (joint_data.contains("translation"))
+        read_floats(joint_data["translation"], transform.translation.Elements, 3, "translation");
+    if (joint_data.contains("rotation"))
+        read_floats(joint_data["rotation"], transform.rotation.Elements, 4, "rotation");
+    if (joint_data.contains("scale"))
+        read_floats(joint_data["scale"], transform.scale.Elements, 3, "scale");
+}
+
+} // namespace
+
 std::vector<VertexWeights> SkinningData::parse_weights_from_json(const Json& json_obj)
 {
     // Reserve space for all vertices to avoid reallocations
@@ -58,6 +91,39 @@ std::vector<VertexWeights> SkinningData::parse_weights_from_json(const Json& jso
     return result;
 }
 
+SparseWeights SkinningData::parse_sparse_weights_from_json(const Json& json_obj)
+{
+    SparseWeights result;
+    result.offsets.reserve(json_obj.size() + 1);
+    result.offsets.push_back(0);
+
+    // Parse each vertex's bone weights, keeping every influence it lists
+    for (size_t vertex_idx = 0; vertex_idx < json_obj.size(); vertex_idx++)
+    {
+        const Json& vertex_data = json_obj.at(vertex_idx);
+
+        // Ensure the JSON has the required fields
+        if (!vertex_data.contains("weight") || !vertex_data.contains("index"))
+        {
+            throw std::runtime_error("Vertex weight data missing required fields");
+        }
+
+        const Json& weights_json = vertex_data["weight"];
+        const Json& indices_json = vertex_data["index"];
+
+        const size_t num_influences = std::min(weights_json.size(), indices_json.size());
+        for (size_t influence_idx = 0; influence_idx < num_influences; influence_idx++)
+        {
+            result.weights.push_back(weights_json.at(influence_idx).as_float());
+            result.joint_ids.push_back(indices_json.at(influence_idx).as_int());
+        }
+
+        result.offsets.push_back(static_cast<uint32_t>(result.joint_ids.size()));
+    }
+
+    return result;
+}
+
 std::vector<HMM_Mat4> SkinningData::parse_matrices_from_json(const Json& json_obj)
 {
     // Reserve space for all matrices to avoid reallocations
@@ -94,6 +160,355 @@ std::vector<HMM_Mat4> SkinningData::parse_matrices_from_json(const Json& json_ob
     return matrices;
 }
 
+std::vector<std::vector<HMM_Mat4>> SkinningData::parse_pose_sequence_from_json(const Json& json_obj)
+{
+    if (!json_obj.is_array())
+    {
+        throw std::runtime_error("Pose sequence JSON must be an array");
+    }
+
+    std::vector<std::vector<HMM_Mat4>> poses;
+
+    // A single palette has numbers two levels down; a sequence has matrices there
+    const bool is_sequence = json_obj.size() > 0 &&
+                             json_obj.at(0).is_array() &&
+                             json_obj.at(0).size() > 0 &&
+                             json_obj.at(0).at(0).is_array();
+    if (!is_sequence)
+    {
+        poses.push_back(parse_matrices_from_json(json_obj));
+        return poses;
+    }
+
+    poses.reserve(json_obj.size());
+    for (size_t pose_idx = 0; pose_idx < json_obj.size(); pose_idx++)
+    {
+        poses.push_back(parse_matrices_from_json(json_obj.at(pose_idx)));
+    }
+
+    return poses;
+}
+
+Skeleton SkinningData::parse_skeleton_from_json(const Json& json_obj)
+{
+    if (!json_obj.is_array())
+    {
+        throw std::runtime_error("Skeleton JSON must be an array of parent indices");
+    }
+
+    std::vector<int32_t> parents(json_obj.size());
+    for (size_t joint_idx = 0; joint_idx < json_obj.size(); joint_idx++)
+    {
+        parents[joint_idx] = json_obj.at(joint_idx).as_int();
+    }
+
+    return Skeleton::from_parents(parents);
+}
+
+std::vector<JointTransform> SkinningData::parse_joint_transforms_from_json(const Json& json_obj)
+{
+    std::vector<JointTransform> transforms(json_obj.size());
+    for (size_t joint_idx = 0; joint_idx < json_obj.size(); joint_idx++)
+    {
+        read_joint_transform(json_obj.at(joint_idx), transforms[joint_idx]);
+    }
+
+    return transforms;
+}
+
+AnimationClip SkinningData::parse_animation_clip_from_json(const Json& json_obj)
+{
+    if (!json_obj.is_array())
+    {
+        throw std::runtime_error("Animation clip JSON must be an array of joint tracks");
+    }
+
+    AnimationClip clip;
+    clip.key_offsets.reserve(json_obj.size() + 1);
+    clip.key_offsets.push_back(0);
+
+    for (size_t joint_idx = 0; joint_idx < json_obj.size(); joint_idx++)
+    {
+        const Json& track_data = json_obj.at(joint_idx);
+        for (size_t key_idx = 0; key_idx < track_data.size(); key_idx++)
+        {
+            const Json& key_data = track_data.at(key_idx);
+            if (!key_data.contains("time"))
+            {
+                throw std::runtime_error("Animation key missing required field: time");
+            }
+
+            // Keys must be sorted, so sampling can binary search them
+            const float time = key_data["time"].as_float();
+            if (!std::isfinite(time) ||
+                (key_idx > 0 && time < clip.key_times.back()))
+            {
+                throw std::runtime_error("Keys of joint " + std::to_string(joint_idx) +
+                                         " must have finite, increasing times");
+            }
+
+            JointTransform transform;
+            read_joint_transform(key_data, transform);
+            clip.key_times.push_back(time);
+            clip.key_transforms.push_back(transform);
+        }
+
+        clip.key_offsets.push_back(static_cast<uint32_t>(clip.key_times.size()));
+    }
+
+    return clip;
+}
+
+MorphTargets SkinningData::parse_morph_targets_from_json(const Json& json_obj)
+{
+    if (!json_obj.is_array())
+    {
+        throw std::runtime_error("Morph target JSON must be an array of targets");
+    }
+
+    MorphTargets result;
+    result.offsets.reserve(json_obj.size() + 1);
+    result.offsets.push_back(0);
+
+    for (size_t target_idx = 0; target_idx < json_obj.size(); target_idx++)
+    {
+        const Json& target_data = json_obj.at(target_idx);
+        if (!target_data.contains("indices") || !target_data.contains("deltas"))
+        {
+            throw std::runtime_error("Morph target data missing required fields");
+        }
+
+        const Json& indices_json = target_data["indices"];
+        const Json& deltas_json = target_data["deltas"];
+        if (indices_json.size() != deltas_json.size())
+        {
+            throw std::runtime_error("Morph target " + std::to_string(target_idx) +
+                                     " lists a different number of indices and deltas");
+        }
+
+        for (size_t delta_idx = 0; delta_idx < indices_json.size(); delta_idx++)
+        {
+            const int vertex_index = indices_json.at(delta_idx).as_int();
+            if (vertex_index < 0)
+            {
+                throw std::runtime_error("Morph target vertex index must not be negative");
+            }
+
+            const Json& delta_json = deltas_json.at(delta_idx);
+            if (delta_json.size() != 3)
+            {
+                throw std::runtime_error("Morph target delta must contain exactly 3 elements");
+            }
+
+            result.vertex_indices.push_back(static_cast<uint32_t>(vertex_index));
+            result.deltas.push_back(HMM_V3(delta_json.at(0).as_float(), delta_json.at(1).as_float(),
+                                           delta_json.at(2).as_float()));
+        }
+
+        result.offsets.push_back(static_cast<uint32_t>(result.vertex_indices.size()));
+    }
+
+    return result;
+}
+
+std::vector<float> SkinningData::parse_morph_weights_from_json(const Json& json_obj)
+{
+    std::vector<float> weights(json_obj.size(), 0.f);
+    for (size_t target_idx = 0; target_idx < json_obj.size(); target_idx++)
+    {
+        // Target objects carry their weight alongside the deltas
+        const Json& weight_data = json_obj.at(target_idx);
+        if (weight_data.contains("weight"))
+            weights[target_idx] = weight_data["weight"].as_float();
+        else if (!weight_data.contains("indices"))
+            weights[target_idx] = weight_data.as_float();
+    }
+
+    return weights;
+}
+
+Skeleton Skeleton::from_parents(const std::vector<int32_t>& parents)
+{
+    const size_t joint_count = parents.size();
+
+    // Depth of every joint; resolving a chain of parents at most joint_count steps long
+    // catches cycles, which would otherwise never reach a root
+    std::vector<int32_t> depths(joint_count, -1);
+    for (size_t joint = 0; joint < joint_count; joint++)
+    {
+        std::vector<size_t> chain;
+        size_t current = joint;
+        while (depths[current] < 0 && parents[current] >= 0)
+        {
+            if (static_cast<size_t>(parents[current]) >= joint_count)
+            {
+                throw std::runtime_error("Skeleton parent index out of range");
+            }
+            if (chain.size() > joint_count)
+            {
+                throw std::runtime_error("Skeleton parents form a cycle");
+            }
+            chain.push_back(current);
+            current = static_cast<size_t>(parents[current]);
+        }
+
+        int32_t depth = depths[current] < 0 ? 0 : depths[current];
+        depths[current] = depth;
+        for (auto link = chain.rbegin(); link != chain.rend(); ++link)
+        {
+            depths[*link] = ++depth;
+        }
+    }
+
+    // Counting sort by depth keeps joints in their original order within a level
+    Skeleton skeleton;
+    skeleton.parents = parents;
+    const int32_t max_depth = joint_count == 0 ? -1 : *std::max_element(depths.begin(), depths.end());
+    skeleton.level_offsets.assign(static_cast<size_t>(max_depth + 2), 0);
+    for (const int32_t depth : depths)
+    {
+        skeleton.level_offsets[static_cast<size_t>(depth) + 1]++;
+    }
+    for (size_t level = 1; level < skeleton.level_offsets.size(); level++)
+    {
+        skeleton.level_offsets[level] += skeleton.level_offsets[level - 1];
+    }
+
+    std::vector<uint32_t> positions(joint_count);
+    std::vector<uint32_t> next(skeleton.level_offsets.begin(), skeleton.level_offsets.end() - 1);
+    skeleton.level_order.resize(joint_count);
+    for (size_t joint = 0; joint < joint_count; joint++)
+    {
+        const uint32_t position = next[static_cast<size_t>(depths[joint])]++;
+        skeleton.level_order[position] = static_cast<uint32_t>(joint);
+        positions[joint] = position;
+    }
+
+    skeleton.level_parents.assign(joint_count, 0);
+    for (size_t position = 0; position < joint_count; position++)
+    {
+        const int32_t parent = parents[skeleton.level_order[position]];
+        if (parent >= 0)
+            skeleton.level_parents[position] = positions[static_cast<size_t>(parent)];
+    }
+
+    return skeleton;
+}
+
+SparseWeights SparseWeights::from_vertex_weights(const std::vector<VertexWeights>& weights)
+{
+    SparseWeights result;
+    result.offsets.reserve(weights.size() + 1);
+    result.joint_ids.reserve(weights.size() * VertexWeights::MAX_INFLUENCES);
+    result.weights.reserve(weights.size() * VertexWeights::MAX_INFLUENCES);
+    result.offsets.push_back(0);
+
+    for (const VertexWeights& vertex_weights : weights)
+    {
+        result.joint_ids.insert(result.joint_ids.end(), vertex_weights.joint_ids,
+                                vertex_weights.joint_ids + VertexWeights::MAX_INFLUENCES);
+        result.weights.insert(result.weights.end(), vertex_weights.weights,
+                              vertex_weights.weights + VertexWeights::MAX_INFLUENCES);
+        result.offsets.push_back(static_cast<uint32_t>(result.joint_ids.size()));
+    }
+
+    return result;
+}
+
+std::vector<JointBounds> SkinningData::compute_joint_rest_bounds(const SparseWeights& weights,
+                                                                const std::vector<Vertex>& vertices,
+                                                                float weight_threshold)
+{
+    if (weights.vertex_count() != vertices.size())
+    {
+        throw std::invalid_argument("Weights cover " + std::to_string(weights.vertex_count()) +
+                                    " vertices but the mesh has " + std::to_string(vertices.size()));
+    }
+
+    // Boxes start inverted, so joints that influence nothing stay empty
+    JointBounds empty_bounds;
+    empty_bounds.min = HMM_V3(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                              std::numeric_limits<float>::max());
+    empty_bounds.max = HMM_V3(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                              std::numeric_limits<float>::lowest());
+
+    std::vector<JointBounds> bounds;
+    for (size_t vertex = 0; vertex < vertices.size(); vertex++)
+    {
+        const HMM_Vec3 position = HMM_V3(vertices[vertex].x, vertices[vertex].y, vertices[vertex].z);
+        for (size_t entry = weights.offsets[vertex]; entry < weights.offsets[vertex + 1]; entry++)
+        {
+            if (weights.weights[entry] < weight_threshold || weights.joint_ids[entry] < 0)
+                continue;
+
+            const size_t joint_id = static_cast<size_t>(weights.joint_ids[entry]);
+            if (joint_id >= bounds.size())
+                bounds.resize(joint_id + 1, empty_bounds);
+
+            JointBounds& joint = bounds[joint_id];
+            joint.min = HMM_V3(std::min(joint.min.X, position.X), std::min(joint.min.Y, position.Y),
+                               std::min(joint.min.Z, position.Z));
+            joint.max = HMM_V3(std::max(joint.max.X, position.X), std::max(joint.max.Y, position.Y),
+                               std::max(joint.max.Z, position.Z));
+        }
+    }
+    return bounds;
+}
+
+float AnimationClip::duration() const
+{
+    float end_time = 0.f;
+    for (size_t joint = 0; joint < joint_count(); joint++)
+    {
+        if (key_offsets[joint + 1] > key_offsets[joint])
+            end_time = std::max(end_time, key_times[key_offsets[joint + 1] - 1]);
+    }
+    return end_time;
+}
+
+JointTransform AnimationClip::sample(size_t joint, float time) const
+{
+    const uint32_t first = key_offsets[joint];
+    const uint32_t last = key_offsets[joint + 1];
+    if (first == last)
+    {
+        return JointTransform();
+    }
+
+    // Hold the first and last keys outside the track
+    const auto next = std::upper_bound(key_times.begin() + first, key_times.begin() + last, time);
+    if (next == key_times.begin() + first)
+    {
+        return key_transforms[first];
+    }
+    if (next == key_times.begin() + last)
+    {
+        return key_transforms[last - 1];
+    }
+
+    const size_t to = static_cast<size_t>(next - key_times.begin());
+    const size_t from = to - 1;
+    const float factor = (time - key_times[from]) / (key_times[to] - key_times[from]);
+
+    // Translation and scale blend linearly; rotations along the shorter arc
+    JointTransform result;
+    result.translation = HMM_LerpV3(key_transforms[from].translation, factor, key_transforms[to].translation);
+    result.rotation = HMM_SLerp(HMM_NormQ(key_transforms[from].rotation), factor,
+                                HMM_NormQ(key_transforms[to].rotation));
+    result.scale = HMM_LerpV3(key_transforms[from].scale, factor, key_transforms[to].scale);
+    return result;
+}
+
+size_t SparseWeights::max_influences() const
+{
+    size_t result = 0;
+    for (size_t vertex = 0; vertex < vertex_count(); vertex++)
+    {
+        result = std::max<size_t>(result, offsets[vertex + 1] - offsets[vertex]);
+    }
+    return result;
+}
+
 HMM_Mat4 SkinningData::get_skinning_matrix(int joint_id) const
 {
     // Safety check: ensure joint ID is valid (non-negative and within bounds)
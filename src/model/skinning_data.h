@@ -1,6 +1,7 @@
 #pragma once
 
 // Standard library imports
+#include <cstdint>
 #include <vector>
 
 // Third-party imports
@@ -8,6 +9,7 @@
 
 
 class Json;
+struct Vertex;
 
 /**
  * @brief Represents the weights and joint influences for a single vertex
@@ -40,6 +42,230 @@ struct VertexWeights
     float weights[MAX_INFLUENCES];
 };
 
+/**
+ * @brief Variable-length joint influences for every vertex, in compressed sparse row form
+ *
+ * The influences of vertex i are the (joint_ids[k], weights[k]) pairs for k in
+ * [offsets[i], offsets[i + 1]). There is no upper limit on influences per vertex,
+ * and a vertex only stores the influences it really has.
+ */
+struct SparseWeights
+{
+    /**
+     * @brief Converts fixed-size per-vertex weights, keeping every slot
+     * @param weights The per-vertex weights
+     * @return The same influences in sparse form
+     */
+    static SparseWeights from_vertex_weights(const std::vector<VertexWeights>& weights);
+
+    /**
+     * @brief Gets the number of vertices described
+     * @return The vertex count
+     */
+    size_t vertex_count() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    /**
+     * @brief Gets the largest number of influences stored for a single vertex
+     * @return The maximum influence count
+     */
+    size_t max_influences() const;
+
+    /**
+     * @brief Start of each vertex's influences, plus one final entry holding the total
+     */
+    std::vector<uint32_t> offsets;
+
+    /**
+     * @brief Packed joint IDs of all influences
+     */
+    std::vector<int32_t> joint_ids;
+
+    /**
+     * @brief Packed weights of all influences, parallel to joint_ids
+     */
+    std::vector<float> weights;
+};
+
+/**
+ * @brief Sparse morph targets (blendshapes), in compressed sparse row form
+ *
+ * Target t moves vertex vertex_indices[k] by deltas[k] for k in [offsets[t], offsets[t + 1]),
+ * scaled by the target's weight. A target only stores the vertices it really moves.
+ */
+struct MorphTargets
+{
+    /**
+     * @brief Gets the number of targets described
+     * @return The target count
+     */
+    size_t target_count() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    /**
+     * @brief Gets the number of vertex deltas stored over all targets
+     * @return The delta count
+     */
+    size_t delta_count() const { return vertex_indices.size(); }
+
+    /**
+     * @brief Start of each target's deltas, plus one final entry holding the total
+     */
+    std::vector<uint32_t> offsets;
+
+    /**
+     * @brief Packed indices of the vertices each target moves
+     */
+    std::vector<uint32_t> vertex_indices;
+
+    /**
+     * @brief Packed rest-space offsets of those vertices, parallel to vertex_indices
+     */
+    std::vector<HMM_Vec3> deltas;
+};
+
+/**
+ * @brief The rest-space box around the vertices one joint influences
+ */
+struct JointBounds
+{
+    /**
+     * @brief Checks whether the joint influences no vertex
+     * @return true if the box holds nothing; otherwise false
+     */
+    bool empty() const { return min.X > max.X; }
+
+    /**
+     * @brief The smallest rest-pose x, y and z
+     */
+    HMM_Vec3 min = HMM_V3(0.f, 0.f, 0.f);
+
+    /**
+     * @brief The largest rest-pose x, y and z
+     */
+    HMM_Vec3 max = HMM_V3(0.f, 0.f, 0.f);
+};
+
+/**
+ * @brief A joint's transform relative to its parent, as translation, rotation and scale
+ *
+ * The matrix it stands for is T * R * S, so scale is applied first.
+ */
+struct JointTransform
+{
+    /**
+     * @brief Translation relative to the parent joint
+     */
+    HMM_Vec3 translation = HMM_V3(0.f, 0.f, 0.f);
+
+    /**
+     * @brief Rotation relative to the parent joint (normalized on use)
+     */
+    HMM_Quat rotation = HMM_Q(0.f, 0.f, 0.f, 1.f);
+
+    /**
+     * @brief Scale along the joint's own axes
+     */
+    HMM_Vec3 scale = HMM_V3(1.f, 1.f, 1.f);
+};
+
+/**
+ * @brief Keyframed joint transforms, one track per joint, in compressed sparse row form
+ *
+ * The keys of joint j are (key_times[k], key_transforms[k]) for k in
+ * [key_offsets[j], key_offsets[j + 1]), sorted by time. Each joint keeps only the keys it
+ * has, so a joint that never moves needs one key (or none, for the identity transform).
+ */
+struct AnimationClip
+{
+    /**
+     * @brief Gets the number of joint tracks
+     * @return The joint count
+     */
+    size_t joint_count() const { return key_offsets.empty() ? 0 : key_offsets.size() - 1; }
+
+    /**
+     * @brief Gets the time of the last key of any track
+     * @return The clip length (0 for an empty clip)
+     */
+    float duration() const;
+
+    /**
+     * @brief Interpolates one joint's transform at a point in time
+     *
+     * Translation and scale are blended linearly between the surrounding keys and the
+     * rotation is slerped along the shorter arc. Times outside the track hold its first
+     * or last key.
+     *
+     * @param joint The joint whose track is sampled
+     * @param time The time to sample at
+     * @return The joint's transform relative to its parent
+     */
+    JointTransform sample(size_t joint, float time) const;
+
+    /**
+     * @brief Start of each joint's keys, plus one final entry holding the total
+     */
+    std::vector<uint32_t> key_offsets;
+
+    /**
+     * @brief Packed key times of all tracks
+     */
+    std::vector<float> key_times;
+
+    /**
+     * @brief Packed key transforms of all tracks, parallel to key_times
+     */
+    std::vector<JointTransform> key_transforms;
+};
+
+/**
+ * @brief A joint hierarchy, with the joints grouped by depth for level-by-level evaluation
+ *
+ * Every joint of level L has its parent in a level below L, so all joints of one
+ * level can be evaluated independently once the levels below are done.
+ */
+struct Skeleton
+{
+    /**
+     * @brief Builds the depth levels of a hierarchy
+     * @param parents The parent of each joint, or -1 for a root
+     * @return The skeleton, with joints ordered by depth (stable within a level)
+     * @throws std::runtime_error if a parent index is out of range or the parents form a cycle
+     */
+    static Skeleton from_parents(const std::vector<int32_t>& parents);
+
+    /**
+     * @brief Gets the number of joints
+     * @return The joint count
+     */
+    size_t joint_count() const { return parents.size(); }
+
+    /**
+     * @brief Gets the number of depth levels
+     * @return The level count (0 for an empty skeleton)
+     */
+    size_t level_count() const { return level_offsets.empty() ? 0 : level_offsets.size() - 1; }
+
+    /**
+     * @brief The parent of each joint, or -1 for a root
+     */
+    std::vector<int32_t> parents;
+
+    /**
+     * @brief The joints sorted by depth, roots first
+     */
+    std::vector<uint32_t> level_order;
+
+    /**
+     * @brief Start of each level in level_order, plus one final entry holding the joint count
+     */
+    std::vector<uint32_t> level_offsets;
+
+    /**
+     * @brief Index in level_order of the parent of each entry of level_order (unused for roots)
+     */
+    std::vector<uint32_t> level_parents;
+};
+
 /**
  * @brief Contains all data needed for mesh skinning operations
  *
@@ -56,6 +282,14 @@ struct SkinningData
      * @throws std::runtime_error if required fields are missing or invalid.
      */
     static std::vector<VertexWeights> parse_weights_from_json(const Json& json_obj);
+
+    /**
+     * @brief Parses bone weights from a Json object without limiting influences per vertex.
+     * @param json_obj The source Json containing weight and index arrays for each vertex.
+     * @return The influences of every vertex in sparse form.
+     * @throws std::runtime_error if required fields are missing or invalid.
+     */
+    static SparseWeights parse_sparse_weights_from_json(const Json& json_obj);
     
     /**
      * @brief Parses transformation matrices from a Json array.
@@ -64,6 +298,87 @@ struct SkinningData
      * @throws std::runtime_error if matrices are malformed.
      */
     static std::vector<HMM_Mat4> parse_matrices_from_json(const Json& json_obj);
+
+    /**
+     * @brief Parses a sequence of pose palettes from a Json array.
+     *
+     * Accepts either a single palette (an array of 16-element matrices), which yields
+     * a one-pose sequence, or an array of such palettes, one per frame.
+     *
+     * @param json_obj The source Json array.
+     * @return One vector of matrices per pose.
+     * @throws std::runtime_error if any palette is malformed.
+     */
+    static std::vector<std::vector<HMM_Mat4>> parse_pose_sequence_from_json(const Json& json_obj);
+
+    /**
+     * @brief Parses a joint hierarchy from a Json array of parent indices.
+     * @param json_obj The source Json array, holding the parent of each joint (-1 for roots).
+     * @return The skeleton, grouped by depth.
+     * @throws std::runtime_error if the hierarchy is malformed.
+     */
+    static Skeleton parse_skeleton_from_json(const Json& json_obj);
+
+    /**
+     * @brief Parses local joint transforms from a Json array.
+     *
+     * Each joint is an object with "translation" ([x, y, z]), "rotation" ([x, y, z, w])
+     * and "scale" ([x, y, z]); any of them may be omitted to keep the identity value.
+     *
+     * @param json_obj The source Json array, one object per joint.
+     * @return The transform of each joint relative to its parent.
+     * @throws std::runtime_error if a component has the wrong number of elements.
+     */
+    static std::vector<JointTransform> parse_joint_transforms_from_json(const Json& json_obj);
+
+    /**
+     * @brief Parses a keyframed animation clip from a Json array.
+     *
+     * Each joint's track is an array of keys; a key is an object with a "time" (in seconds)
+     * and the "translation", "rotation" and "scale" of parse_joint_transforms_from_json().
+     *
+     * @param json_obj The source Json array, one track per joint.
+     * @return The clip.
+     * @throws std::runtime_error if a key has no time, its times decrease, or a component
+     *         has the wrong number of elements.
+     */
+    static AnimationClip parse_animation_clip_from_json(const Json& json_obj);
+
+    /**
+     * @brief Parses sparse morph targets from a Json array.
+     *
+     * Each target is an object with "indices" (the vertices it moves) and "deltas"
+     * (one [x, y, z] offset per index).
+     *
+     * @param json_obj The source Json array, one object per target.
+     * @return The targets in sparse form.
+     * @throws std::runtime_error if a target is missing fields, has a negative index,
+     *         or lists a different number of indices and deltas.
+     */
+    static MorphTargets parse_morph_targets_from_json(const Json& json_obj);
+
+    /**
+     * @brief Parses morph target weights from a Json array.
+     *
+     * Accepts either plain numbers or the target objects parsed by parse_morph_targets_from_json(),
+     * reading their optional "weight" field (0 when omitted).
+     *
+     * @param json_obj The source Json array, one element per target.
+     * @return The weight of each target.
+     */
+    static std::vector<float> parse_morph_weights_from_json(const Json& json_obj);
+
+    /**
+     * @brief Computes the rest-space box of the vertices each joint influences.
+     * @param weights The per-vertex joint influences.
+     * @param vertices The rest-pose vertices the weights belong to.
+     * @param weight_threshold Weights below this value do not count as influences.
+     * @return One box per joint up to the largest referenced ID (empty for unused joints).
+     * @throws std::invalid_argument if the weights and vertices disagree on the vertex count.
+     */
+    static std::vector<JointBounds> compute_joint_rest_bounds(const SparseWeights& weights,
+                                                              const std::vector<Vertex>& vertices,
+                                                              float weight_threshold);
     
     /**
      * @brief Weights for each vertex 
@@ -72,6 +387,11 @@ struct SkinningData
      * the joint IDs and weights that influence that vertex.
      */
     std::vector<VertexWeights> weights;
+
+    /**
+     * @brief Weights for each vertex, with any number of influences per vertex
+     */
+    SparseWeights sparse_weights;
     
     /**
      * @brief Inverse bind pose matrices for each joint
@@ -88,6 +408,39 @@ struct SkinningData
      * Combined with inverse bind matrices to create skinning matrices.
      */
     std::vector<HMM_Mat4> pose_matrices;
+
+    /**
+     * @brief Sparse morph targets applied to the rest pose before skinning
+     *
+     * Empty unless morph targets were loaded.
+     */
+    MorphTargets morph_targets;
+
+    /**
+     * @brief Current weight of each morph target
+     */
+    std::vector<float> morph_weights;
+
+    /**
+     * @brief The rest-space box of the vertices each joint influences
+     *
+     * Computed when the weights are loaded, so a pose can be bounded from its palette alone.
+     */
+    std::vector<JointBounds> joint_rest_bounds;
+
+    /**
+     * @brief The joint hierarchy, used to turn local joint transforms into pose matrices
+     *
+     * Empty unless a skeleton was loaded.
+     */
+    Skeleton skeleton;
+
+    /**
+     * @brief Keyframes sampled into pose matrices
+     *
+     * Empty unless an animation clip was loaded.
+     */
+    AnimationClip animation_clip;
     
     /**
      * @brief Calculates and returns the skinning matrix for a specific joint
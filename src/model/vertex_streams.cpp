@@ -0,0 +1,961 @@
+#include "vertex_streams.h"
+
+// Standard library imports
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+// Local application imports
+#include "model/mesh.h"
+
+
+namespace {
+
+// Counts the influences of a vertex that survive the weight threshold
+size_t count_influences(const SparseWeights& weights, size_t vertex, float weight_threshold)
+{
+    size_t influences = 0;
+    for (size_t entry = weights.offsets[vertex]; entry < weights.offsets[vertex + 1]; entry++)
+    {
+        if (weights.weights[entry] >= weight_threshold && weights.joint_ids[entry] >= 0)
+            influences++;
+    }
+    return influences;
+}
+
+// Whether an encoding stores 8-bit joint IDs (otherwise 16-bit ones, unless Float32)
+bool uses_joint_ids_8(InfluenceEncoding encoding)
+{
+    return encoding == InfluenceEncoding::Joint8Unorm16 || encoding == InfluenceEncoding::Joint8Unorm8;
+}
+
+// Whether an encoding stores 8-bit weights (otherwise 16-bit ones, unless Float32)
+bool uses_weights_unorm8(InfluenceEncoding encoding)
+{
+    return encoding == InfluenceEncoding::Joint16Unorm8 || encoding == InfluenceEncoding::Joint8Unorm8;
+}
+
+// Packs the influences of the vertices listed in order (PADDING entries stay empty)
+InfluenceStreams build_influence_streams(const SparseWeights& weights, float weight_threshold,
+                                         const std::vector<uint32_t>& order)
+{
+    constexpr size_t CHUNK_SIZE = InfluenceStreams::CHUNK_SIZE;
+
+    InfluenceStreams streams;
+    streams.count = weights.vertex_count();
+
+    const size_t chunk_count = order.size() / CHUNK_SIZE;
+    streams.chunk_offsets.resize(chunk_count);
+    streams.chunk_influences.resize(chunk_count);
+
+    // Size each chunk by its most influenced vertex
+    size_t total_slots = 0;
+    for (size_t chunk = 0; chunk < chunk_count; chunk++)
+    {
+        size_t max_influences = 0;
+        for (size_t i = chunk * CHUNK_SIZE; i < (chunk + 1) * CHUNK_SIZE; i++)
+        {
+            if (order[i] != VertexBuckets::PADDING)
+                max_influences = std::max(max_influences,
+                                          count_influences(weights, order[i], weight_threshold));
+        }
+
+        streams.chunk_offsets[chunk] = static_cast<uint32_t>(total_slots * CHUNK_SIZE);
+        streams.chunk_influences[chunk] = static_cast<uint32_t>(max_influences);
+        total_slots += max_influences;
+    }
+
+    // Unused slots get joint 0 with weight 0, so they contribute nothing
+    streams.joint_ids.assign(total_slots * CHUNK_SIZE, 0);
+    streams.weights.assign(total_slots * CHUNK_SIZE, 0.f);
+
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        if (order[i] == VertexBuckets::PADDING)
+            continue;
+
+        const size_t base = streams.chunk_offsets[i / CHUNK_SIZE] + i % CHUNK_SIZE;
+        const size_t vertex = order[i];
+
+        // Negligible weights and invalid IDs are not real influences
+        size_t slot = 0;
+        for (size_t entry = weights.offsets[vertex]; entry < weights.offsets[vertex + 1]; entry++)
+        {
+            if (weights.weights[entry] < weight_threshold || weights.joint_ids[entry] < 0)
+                continue;
+
+            streams.joint_ids[base + slot * CHUNK_SIZE] = weights.joint_ids[entry];
+            streams.weights[base + slot * CHUNK_SIZE] = weights.weights[entry];
+            slot++;
+        }
+    }
+
+    return streams;
+}
+
+} // namespace
+
+VertexBuckets VertexBuckets::from_sparse_weights(const SparseWeights& weights,
+                                                 float weight_threshold)
+{
+    constexpr size_t CHUNK_SIZE = InfluenceStreams::CHUNK_SIZE;
+
+    VertexBuckets result;
+    result.count = weights.vertex_count();
+
+    // Counting sort by influence count keeps each bucket in original (spatially coherent) order
+    std::vector<size_t> influence_counts(result.count);
+    std::vector<std::vector<uint32_t>> vertices_by_count;
+    for (size_t i = 0; i < result.count; i++)
+    {
+        influence_counts[i] = count_influences(weights, i, weight_threshold);
+        if (influence_counts[i] >= vertices_by_count.size())
+            vertices_by_count.resize(influence_counts[i] + 1);
+        vertices_by_count[influence_counts[i]].push_back(static_cast<uint32_t>(i));
+    }
+
+    // Lay the buckets out back to back, each padded to whole chunks
+    for (size_t influence_count = 0; influence_count < vertices_by_count.size(); influence_count++)
+    {
+        const std::vector<uint32_t>& bucket_vertices = vertices_by_count[influence_count];
+        if (bucket_vertices.empty())
+            continue;
+
+        Bucket bucket;
+        bucket.influence_count = influence_count;
+        bucket.begin = result.order.size();
+
+        result.order.insert(result.order.end(), bucket_vertices.begin(), bucket_vertices.end());
+        result.order.resize((result.order.size() + CHUNK_SIZE - 1) / CHUNK_SIZE * CHUNK_SIZE,
+                            PADDING);
+
+        bucket.end = result.order.size();
+        result.buckets.push_back(bucket);
+    }
+
+    return result;
+}
+
+
+VertexStreams VertexStreams::from_vertices(const std::vector<Vertex>& vertices)
+{
+    VertexStreams streams;
+    streams.resize(vertices.size());
+
+    // Scatter each coordinate into its own stream
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        streams.x[i] = vertices[i].x;
+        streams.y[i] = vertices[i].y;
+        streams.z[i] = vertices[i].z;
+    }
+
+    return streams;
+}
+
+VertexStreams VertexStreams::from_vertices(const std::vector<Vertex>& vertices,
+                                           const VertexBuckets& buckets)
+{
+    VertexStreams streams;
+    streams.resize(buckets);
+
+    // Gather each vertex into its bucketed position
+    for (size_t i = 0; i < buckets.order.size(); i++)
+    {
+        const uint32_t source = buckets.order[i];
+        if (source == VertexBuckets::PADDING)
+            continue;
+
+        streams.x[i] = vertices[source].x;
+        streams.y[i] = vertices[source].y;
+        streams.z[i] = vertices[source].z;
+    }
+
+    return streams;
+}
+
+void VertexStreams::resize(size_t vertex_count)
+{
+    count = vertex_count;
+
+    // Padding lanes are zero-initialized so kernels can safely process them
+    const size_t padded = padded_size(vertex_count);
+    x.assign(padded, 0.f);
+    y.assign(padded, 0.f);
+    z.assign(padded, 0.f);
+}
+
+void VertexStreams::resize(const VertexBuckets& buckets)
+{
+    count = buckets.count;
+
+    // Padding entries are zero-initialized so kernels can safely process them
+    x.assign(buckets.padded_count(), 0.f);
+    y.assign(buckets.padded_count(), 0.f);
+    z.assign(buckets.padded_count(), 0.f);
+}
+
+void VertexStreams::to_vertices(std::vector<Vertex>& vertices) const
+{
+    vertices.resize(count);
+
+    // Gather the coordinates back into AoS form, skipping the padding
+    for (size_t i = 0; i < count; i++)
+    {
+        vertices[i].x = x[i];
+        vertices[i].y = y[i];
+        vertices[i].z = z[i];
+    }
+}
+
+void VertexStreams::to_vertices(std::vector<Vertex>& vertices, const VertexBuckets& buckets) const
+{
+    vertices.resize(count);
+    to_vertices(vertices, buckets, 0, buckets.order.size());
+}
+
+void VertexStreams::to_vertices(std::vector<Vertex>& vertices, const VertexBuckets& buckets,
+                                size_t begin, size_t end) const
+{
+    to_positions(PositionBuffer::from_vertices(vertices), buckets, begin, end);
+}
+
+void VertexStreams::to_positions(const PositionBuffer& output, const VertexBuckets& buckets,
+                                 size_t begin, size_t end) const
+{
+    unsigned char* const bytes = static_cast<unsigned char*>(output.data);
+
+    // Scatter each entry back to its original index, skipping the padding
+    if (output.format == PositionFormat::Float32)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            const uint32_t target = buckets.order[i];
+            if (target == VertexBuckets::PADDING)
+                continue;
+
+            float* const position = reinterpret_cast<float*>(bytes + target * output.stride);
+            position[0] = x[i];
+            position[1] = y[i];
+            position[2] = z[i];
+        }
+    }
+    else if (output.format == PositionFormat::Float16)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            const uint32_t target = buckets.order[i];
+            if (target == VertexBuckets::PADDING)
+                continue;
+
+            uint16_t* const position = reinterpret_cast<uint16_t*>(bytes + target * output.stride);
+            position[0] = PositionBuffer::to_half(x[i]);
+            position[1] = PositionBuffer::to_half(y[i]);
+            position[2] = PositionBuffer::to_half(z[i]);
+        }
+    }
+    else
+    {
+        // Map each axis of the box onto [0, 65535] (flat axes collapse to 0)
+        float scale[3];
+        for (int axis = 0; axis < 3; axis++)
+        {
+            const float extent = output.bounds->max[axis] - output.bounds->min[axis];
+            scale[axis] = extent > 0.f ? std::numeric_limits<uint16_t>::max() / extent : 0.f;
+        }
+        const auto normalize = [&output, &scale](float value, int axis)
+        {
+            const float scaled = (value - output.bounds->min[axis]) * scale[axis] + .5f;
+            return static_cast<uint16_t>(std::clamp(scaled, 0.f, 65535.f));
+        };
+
+        for (size_t i = begin; i < end; i++)
+        {
+            const uint32_t target = buckets.order[i];
+            if (target == VertexBuckets::PADDING)
+                continue;
+
+            uint16_t* const position = reinterpret_cast<uint16_t*>(bytes + target * output.stride);
+            position[0] = normalize(x[i], 0);
+            position[1] = normalize(y[i], 1);
+            position[2] = normalize(z[i], 2);
+        }
+    }
+}
+
+PositionBounds VertexStreams::bounds(const VertexBuckets& buckets, size_t begin, size_t end) const
+{
+    PositionBounds box;
+    std::fill_n(box.min, 3, std::numeric_limits<float>::max());
+    std::fill_n(box.max, 3, std::numeric_limits<float>::lowest());
+
+    for (size_t i = begin; i < end; i++)
+    {
+        if (buckets.order[i] == VertexBuckets::PADDING)
+            continue;
+
+        box.min[0] = std::min(box.min[0], x[i]);
+        box.min[1] = std::min(box.min[1], y[i]);
+        box.min[2] = std::min(box.min[2], z[i]);
+        box.max[0] = std::max(box.max[0], x[i]);
+        box.max[1] = std::max(box.max[1], y[i]);
+        box.max[2] = std::max(box.max[2], z[i]);
+    }
+    return box;
+}
+
+float VertexStreams::radius(const VertexBuckets& buckets, size_t begin, size_t end,
+                           const float center[3]) const
+{
+    float max_squared = 0.f;
+    for (size_t i = begin; i < end; i++)
+    {
+        if (buckets.order[i] == VertexBuckets::PADDING)
+            continue;
+
+        const float dx = x[i] - center[0];
+        const float dy = y[i] - center[1];
+        const float dz = z[i] - center[2];
+        max_squared = std::max(max_squared, dx * dx + dy * dy + dz * dz);
+    }
+    return std::sqrt(max_squared);
+}
+
+PositionBuffer PositionBuffer::from_vertices(std::vector<Vertex>& vertices)
+{
+    // The scatter writes x, y and z as one float3
+    static_assert(offsetof(Vertex, y) == offsetof(Vertex, x) + sizeof(float) &&
+                  offsetof(Vertex, z) == offsetof(Vertex, y) + sizeof(float),
+                  "Vertex positions must be stored as three consecutive floats");
+
+    PositionBuffer buffer;
+    buffer.data = vertices.empty() ? nullptr : &vertices.front().x;
+    buffer.vertex_count = vertices.size();
+    buffer.stride = sizeof(Vertex);
+    return buffer;
+}
+
+PositionBuffer PositionBuffer::packed(void* data, size_t vertex_count, PositionFormat format)
+{
+    PositionBuffer buffer;
+    buffer.data = data;
+    buffer.vertex_count = vertex_count;
+    buffer.stride = 3 * component_size(format);
+    buffer.format = format;
+    return buffer;
+}
+
+size_t PositionBuffer::component_size(PositionFormat format)
+{
+    return format == PositionFormat::Float32 ? sizeof(float) : sizeof(uint16_t);
+}
+
+uint16_t PositionBuffer::to_half(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    const uint32_t exponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    // Infinity stays infinite, NaN stays (quiet) NaN
+    if (exponent == 0xFFu)
+    {
+        return static_cast<uint16_t>(sign | 0x7C00u | (mantissa != 0 ? 0x200u : 0u));
+    }
+
+    const int32_t half_exponent = static_cast<int32_t>(exponent) - 127 + 15;
+    if (half_exponent >= 0x1F)
+    {
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+
+    // Too small for a normal half: shift the mantissa, implicit bit included, into a subnormal
+    if (half_exponent <= 0)
+    {
+        if (half_exponent < -10)
+        {
+            return static_cast<uint16_t>(sign);
+        }
+
+        mantissa |= 0x800000u;
+        const uint32_t shift = static_cast<uint32_t>(14 - half_exponent);
+        uint32_t half_mantissa = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half_mantissa & 1u) != 0))
+            half_mantissa++;
+        return static_cast<uint16_t>(sign | half_mantissa);
+    }
+
+    // Round the dropped 13 mantissa bits to nearest even; a carry correctly bumps the exponent
+    uint32_t half = sign | (static_cast<uint32_t>(half_exponent) << 10) | (mantissa >> 13);
+    const uint32_t remainder = mantissa & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u) != 0))
+        half++;
+    return static_cast<uint16_t>(half);
+}
+
+float PositionBuffer::from_half(uint16_t half)
+{
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1Fu;
+    const uint32_t mantissa = half & 0x3FFu;
+
+    // Subnormals are mantissa * 2^-24
+    if (exponent == 0)
+    {
+        const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign != 0 ? -magnitude : magnitude;
+    }
+
+    const uint32_t bits = exponent == 0x1Fu ?
+        sign | 0x7F800000u | (mantissa << 13) :
+        sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+InfluenceStreams InfluenceStreams::from_sparse_weights(const SparseWeights& weights,
+                                                       float weight_threshold)
+{
+    // Identity order: every vertex stays in place, padding only at the end
+    std::vector<uint32_t> order(VertexStreams::padded_size(weights.vertex_count()),
+                                VertexBuckets::PADDING);
+    for (size_t i = 0; i < weights.vertex_count(); i++)
+    {
+        order[i] = static_cast<uint32_t>(i);
+    }
+
+    return build_influence_streams(weights, weight_threshold, order);
+}
+
+InfluenceStreams InfluenceStreams::from_sparse_weights(const SparseWeights& weights,
+                                                       float weight_threshold,
+                                                       const VertexBuckets& buckets)
+{
+    return build_influence_streams(weights, weight_threshold, buckets.order);
+}
+
+InfluenceStreams InfluenceStreams::from_weights(const std::vector<VertexWeights>& weights,
+                                                float weight_threshold)
+{
+    return from_sparse_weights(SparseWeights::from_vertex_weights(weights), weight_threshold);
+}
+
+InfluenceEncoding InfluenceStreams::select_encoding(WeightPrecision precision, size_t joint_count)
+{
+    if (precision == WeightPrecision::Float32)
+    {
+        return InfluenceEncoding::Float32;
+    }
+
+    constexpr size_t MAX_JOINTS_16 = size_t(std::numeric_limits<uint16_t>::max()) + 1;
+    constexpr size_t MAX_JOINTS_8 = size_t(std::numeric_limits<uint8_t>::max()) + 1;
+    if (joint_count > MAX_JOINTS_16)
+    {
+        throw std::invalid_argument("Compact weights support up to " + std::to_string(MAX_JOINTS_16) +
+                                    " joints, not " + std::to_string(joint_count));
+    }
+
+    const bool narrow_ids = joint_count <= MAX_JOINTS_8;
+    if (precision == WeightPrecision::Unorm16)
+    {
+        return narrow_ids ? InfluenceEncoding::Joint8Unorm16 : InfluenceEncoding::Joint16Unorm16;
+    }
+    return narrow_ids ? InfluenceEncoding::Joint8Unorm8 : InfluenceEncoding::Joint16Unorm8;
+}
+
+size_t InfluenceStreams::bytes_per_influence(InfluenceEncoding encoding)
+{
+    if (encoding == InfluenceEncoding::Float32)
+    {
+        return sizeof(int32_t) + sizeof(float);
+    }
+    return (uses_joint_ids_8(encoding) ? sizeof(uint8_t) : sizeof(uint16_t)) +
+           (uses_weights_unorm8(encoding) ? sizeof(uint8_t) : sizeof(uint16_t));
+}
+
+InfluenceStreams InfluenceStreams::encode(InfluenceEncoding target) const
+{
+    if (encoding != InfluenceEncoding::Float32)
+    {
+        throw std::invalid_argument("Only float influence streams can be re-encoded");
+    }
+    if (target == InfluenceEncoding::Float32)
+    {
+        return *this;
+    }
+
+    InfluenceStreams encoded;
+    encoded.encoding = target;
+    encoded.count = count;
+    encoded.chunk_offsets = chunk_offsets;
+    encoded.chunk_influences = chunk_influences;
+
+    // Joint IDs are narrowed as-is
+    const size_t entries = joint_ids.size();
+    const int32_t max_joint_id = uses_joint_ids_8(target) ?
+        std::numeric_limits<uint8_t>::max() : std::numeric_limits<uint16_t>::max();
+    if (uses_joint_ids_8(target))
+        encoded.joint_ids_8.resize(entries);
+    else
+        encoded.joint_ids_16.resize(entries);
+
+    for (size_t entry = 0; entry < entries; entry++)
+    {
+        const int32_t joint_id = joint_ids[entry];
+        if (joint_id < 0 || joint_id > max_joint_id)
+        {
+            throw std::invalid_argument("Joint ID " + std::to_string(joint_id) +
+                                        " does not fit the compact encoding");
+        }
+
+        if (uses_joint_ids_8(target))
+            encoded.joint_ids_8[entry] = static_cast<uint8_t>(joint_id);
+        else
+            encoded.joint_ids_16[entry] = static_cast<uint16_t>(joint_id);
+    }
+
+    // Weights are rounded per vertex: every value is rounded down, then the units still
+    // missing from the rounded total go to the largest remainders, so the sum is preserved
+    const uint32_t unorm_max = uses_weights_unorm8(target) ?
+        std::numeric_limits<uint8_t>::max() : std::numeric_limits<uint16_t>::max();
+    std::vector<uint32_t> quantized(entries, 0);
+    for (size_t chunk = 0; chunk < chunk_offsets.size(); chunk++)
+    {
+        const size_t slots = chunk_influences[chunk];
+        for (size_t lane = 0; lane < CHUNK_SIZE; lane++)
+        {
+            const size_t base = chunk_offsets[chunk] + lane;
+            const auto scaled = [&](size_t slot)
+            {
+                return std::clamp(weights[base + slot * CHUNK_SIZE], 0.f, 1.f) * unorm_max;
+            };
+
+            float total = 0.f;
+            uint32_t rounded_total = 0;
+            for (size_t slot = 0; slot < slots; slot++)
+            {
+                quantized[base + slot * CHUNK_SIZE] = static_cast<uint32_t>(scaled(slot));
+                rounded_total += quantized[base + slot * CHUNK_SIZE];
+                total += scaled(slot);
+            }
+
+            const uint32_t target_total = static_cast<uint32_t>(std::lround(total));
+            for (; rounded_total < target_total; rounded_total++)
+            {
+                size_t best = slots;
+                float best_remainder = 0.f;
+                for (size_t slot = 0; slot < slots; slot++)
+                {
+                    const uint32_t value = quantized[base + slot * CHUNK_SIZE];
+                    const float remainder = scaled(slot) - static_cast<float>(value);
+                    if (value < unorm_max && (best == slots || remainder > best_remainder))
+                    {
+                        best = slot;
+                        best_remainder = remainder;
+                    }
+                }
+                if (best == slots)
+                    break;
+                quantized[base + best * CHUNK_SIZE]++;
+            }
+        }
+    }
+
+    if (uses_weights_unorm8(target))
+    {
+        encoded.weights_unorm8.assign(quantized.begin(), quantized.end());
+    }
+    else
+    {
+        encoded.weights_unorm16.assign(quantized.begin(), quantized.end());
+    }
+    return encoded;
+}
+
+size_t InfluenceStreams::entry_count() const
+{
+    if (encoding == InfluenceEncoding::Float32)
+    {
+        return joint_ids.size();
+    }
+    return uses_joint_ids_8(encoding) ? joint_ids_8.size() : joint_ids_16.size();
+}
+
+int32_t InfluenceStreams::joint_id(size_t entry) const
+{
+    if (encoding == InfluenceEncoding::Float32)
+    {
+        return joint_ids[entry];
+    }
+    return uses_joint_ids_8(encoding) ? joint_ids_8[entry] : joint_ids_16[entry];
+}
+
+float InfluenceStreams::weight(size_t entry) const
+{
+    if (encoding == InfluenceEncoding::Float32)
+    {
+        return weights[entry];
+    }
+    return uses_weights_unorm8(encoding) ?
+        static_cast<float>(weights_unorm8[entry]) * UNORM8_SCALE :
+        static_cast<float>(weights_unorm16[entry]) * UNORM16_SCALE;
+}
+
+JointChunkIndex JointChunkIndex::from_influence_streams(const InfluenceStreams& influences)
+{
+    const size_t chunk_count = influences.chunk_offsets.size();
+
+    int32_t max_joint_id = -1;
+    for (size_t entry = 0; entry < influences.entry_count(); entry++)
+    {
+        if (influences.weight(entry) != 0.f)
+            max_joint_id = std::max(max_joint_id, influences.joint_id(entry));
+    }
+
+    JointChunkIndex index;
+    index.offsets.assign(static_cast<size_t>(max_joint_id + 1) + 1, 0);
+
+    // Visits each (joint, chunk) pair once; chunks are visited in order, so a joint's
+    // last recorded chunk is enough to skip its repeated slots and lanes
+    const auto for_each_pair = [&](auto&& visit)
+    {
+        std::vector<uint32_t> last_chunk(index.joint_count(), VertexBuckets::PADDING);
+        for (size_t chunk = 0; chunk < chunk_count; chunk++)
+        {
+            const size_t begin = influences.chunk_offsets[chunk];
+            const size_t end = begin + influences.chunk_influences[chunk] * InfluenceStreams::CHUNK_SIZE;
+            for (size_t entry = begin; entry < end; entry++)
+            {
+                const int32_t joint_id = influences.joint_id(entry);
+                if (influences.weight(entry) == 0.f || last_chunk[joint_id] == chunk)
+                    continue;
+
+                last_chunk[joint_id] = static_cast<uint32_t>(chunk);
+                visit(static_cast<size_t>(joint_id), static_cast<uint32_t>(chunk));
+            }
+        }
+    };
+
+    // Count the chunks of each joint, then fill them in (CSR layout)
+    for_each_pair([&](size_t joint_id, uint32_t) { index.offsets[joint_id + 1]++; });
+    for (size_t joint_id = 0; joint_id < index.joint_count(); joint_id++)
+    {
+        index.offsets[joint_id + 1] += index.offsets[joint_id];
+    }
+
+    index.chunks.resize(index.offsets.back());
+    std::vector<uint32_t> cursor(index.offsets.begin(), index.offsets.end() - 1);
+    for_each_pair([&](size_t joint_id, uint32_t chunk) { index.chunks[cursor[joint_id]++] = chunk; });
+
+    return index;
+}
+
+Meshlets Meshlets::tile(const SparseWeights& weights, float weight_threshold, VertexBuckets& buckets)
+{
+    constexpr size_t CHUNK_SIZE = InfluenceStreams::CHUNK_SIZE;
+    static_assert(MAX_VERTICES % CHUNK_SIZE == 0, "Meshlets must hold whole chunks");
+
+    Meshlets result;
+    std::vector<uint32_t> order;
+    order.reserve(buckets.order.size());
+
+    // The meshlet (plus one) that last referenced each joint, to count a vertex's new joints
+    int32_t max_joint_id = -1;
+    for (const int32_t joint_id : weights.joint_ids)
+    {
+        max_joint_id = std::max(max_joint_id, joint_id);
+    }
+    std::vector<uint32_t> joint_stamps(static_cast<size_t>(max_joint_id + 1), 0);
+
+    std::vector<std::pair<std::pair<int32_t, int32_t>, uint32_t>> keyed_vertices;
+    std::vector<uint32_t> meshlet_joints;
+    std::vector<uint32_t> vertex_joints;
+
+    for (VertexBuckets::Bucket& bucket : buckets.buckets)
+    {
+        // Sort by strongest, then second strongest joint, so neighbours share their joint sets
+        keyed_vertices.clear();
+        for (size_t i = bucket.begin; i < bucket.end; i++)
+        {
+            const uint32_t vertex = buckets.order[i];
+            if (vertex == VertexBuckets::PADDING)
+                continue;
+
+            int32_t first = -1;
+            int32_t second = -1;
+            float first_weight = 0.f;
+            float second_weight = 0.f;
+            for (size_t entry = weights.offsets[vertex]; entry < weights.offsets[vertex + 1]; entry++)
+            {
+                const float weight = weights.weights[entry];
+                if (weight < weight_threshold || weights.joint_ids[entry] < 0)
+                    continue;
+
+                if (weight > first_weight)
+                {
+                    second = first;
+                    second_weight = first_weight;
+                    first = weights.joint_ids[entry];
+                    first_weight = weight;
+                }
+                else if (weight > second_weight)
+                {
+                    second = weights.joint_ids[entry];
+                    second_weight = weight;
+                }
+            }
+            keyed_vertices.push_back({ { first, second }, vertex });
+        }
+        std::sort(keyed_vertices.begin(), keyed_vertices.end());
+
+        // Fill meshlets greedily, starting a new one when the next vertex would overflow it
+        bucket.begin = order.size();
+        size_t meshlet_begin = order.size();
+        const auto close_meshlet = [&]()
+        {
+            if (order.size() == meshlet_begin)
+                return;
+
+            order.resize((order.size() + CHUNK_SIZE - 1) / CHUNK_SIZE * CHUNK_SIZE, VertexBuckets::PADDING);
+            std::sort(meshlet_joints.begin(), meshlet_joints.end());
+
+            Meshlet meshlet;
+            meshlet.influence_count = bucket.influence_count;
+            meshlet.begin = meshlet_begin;
+            meshlet.end = order.size();
+            meshlet.joint_begin = static_cast<uint32_t>(result.joints.size());
+            meshlet.joint_end = static_cast<uint32_t>(result.joints.size() + meshlet_joints.size());
+            result.meshlets.push_back(meshlet);
+            result.joints.insert(result.joints.end(), meshlet_joints.begin(), meshlet_joints.end());
+
+            meshlet_begin = order.size();
+            meshlet_joints.clear();
+        };
+
+        for (const auto& keyed_vertex : keyed_vertices)
+        {
+            const uint32_t vertex = keyed_vertex.second;
+
+            vertex_joints.clear();
+            for (size_t entry = weights.offsets[vertex]; entry < weights.offsets[vertex + 1]; entry++)
+            {
+                if (weights.weights[entry] >= weight_threshold && weights.joint_ids[entry] >= 0)
+                    vertex_joints.push_back(static_cast<uint32_t>(weights.joint_ids[entry]));
+            }
+            std::sort(vertex_joints.begin(), vertex_joints.end());
+            vertex_joints.erase(std::unique(vertex_joints.begin(), vertex_joints.end()), vertex_joints.end());
+
+            uint32_t stamp = static_cast<uint32_t>(result.meshlets.size() + 1);
+            const size_t new_joints = static_cast<size_t>(std::count_if(
+                vertex_joints.begin(), vertex_joints.end(),
+                [&](uint32_t joint_id) { return joint_stamps[joint_id] != stamp; }));
+
+            if (order.size() - meshlet_begin == MAX_VERTICES ||
+                meshlet_joints.size() + new_joints > MAX_JOINTS)
+            {
+                close_meshlet();
+                stamp = static_cast<uint32_t>(result.meshlets.size() + 1);
+            }
+
+            for (const uint32_t joint_id : vertex_joints)
+            {
+                if (joint_stamps[joint_id] != stamp)
+                {
+                    joint_stamps[joint_id] = stamp;
+                    meshlet_joints.push_back(joint_id);
+                }
+            }
+            order.push_back(vertex);
+        }
+        close_meshlet();
+        bucket.end = order.size();
+    }
+
+    buckets.order = std::move(order);
+
+    result.chunk_meshlets.resize(buckets.order.size() / CHUNK_SIZE);
+    for (size_t m = 0; m < result.meshlets.size(); m++)
+    {
+        for (size_t chunk = result.meshlets[m].begin / CHUNK_SIZE;
+             chunk < result.meshlets[m].end / CHUNK_SIZE; chunk++)
+        {
+            result.chunk_meshlets[chunk] = static_cast<uint32_t>(m);
+        }
+    }
+
+    return result;
+}
+
+void Meshlets::localize(InfluenceStreams& influences) const
+{
+    constexpr size_t CHUNK_SIZE = InfluenceStreams::CHUNK_SIZE;
+
+    if (influences.encoding != InfluenceEncoding::Float32)
+    {
+        throw std::invalid_argument("Only Float32 influence streams can be localized to meshlets");
+    }
+
+    for (size_t chunk = 0; chunk < influences.chunk_offsets.size(); chunk++)
+    {
+        const Meshlet& meshlet = meshlets[chunk_meshlets[chunk]];
+        const auto first = joints.begin() + meshlet.joint_begin;
+        const auto last = joints.begin() + meshlet.joint_end;
+
+        const size_t begin = influences.chunk_offsets[chunk];
+        const size_t end = begin + influences.chunk_influences[chunk] * CHUNK_SIZE;
+        for (size_t entry = begin; entry < end; entry++)
+        {
+            // Empty slots contribute nothing, whichever matrix they read
+            if (influences.weights[entry] == 0.f)
+            {
+                influences.joint_ids[entry] = 0;
+                continue;
+            }
+
+            const uint32_t joint_id = static_cast<uint32_t>(influences.joint_ids[entry]);
+            const auto local = std::lower_bound(first, last, joint_id);
+            if (local == last || *local != joint_id)
+            {
+                throw std::invalid_argument("Joint " + std::to_string(joint_id) +
+                                            " is missing from its meshlet's joint list");
+            }
+            influences.joint_ids[entry] = static_cast<int32_t>(local - first);
+        }
+    }
+}
+
+size_t Meshlets::max_joint_count() const
+{
+    size_t max_joints = 0;
+    for (const Meshlet& meshlet : meshlets)
+    {
+        max_joints = std::max<size_t>(max_joints, meshlet.joint_end - meshlet.joint_begin);
+    }
+    return max_joints;
+}
+
+MorphStreams MorphStreams::from_morph_targets(const MorphTargets& targets, const VertexBuckets& buckets)
+{
+    constexpr size_t CHUNK_SIZE = InfluenceStreams::CHUNK_SIZE;
+    const size_t target_count = targets.target_count();
+
+    // Position of each original vertex in skinning order
+    std::vector<uint32_t> vertex_entries(buckets.count, VertexBuckets::PADDING);
+    for (size_t entry = 0; entry < buckets.order.size(); entry++)
+    {
+        if (buckets.order[entry] != VertexBuckets::PADDING)
+            vertex_entries[buckets.order[entry]] = static_cast<uint32_t>(entry);
+    }
+
+    // Deltas in target order, then stably sorted by entry so each entry sums its targets in order
+    std::vector<uint32_t> delta_entries(targets.delta_count());
+    std::vector<uint32_t> delta_targets(targets.delta_count());
+    for (size_t target = 0; target < target_count; target++)
+    {
+        for (uint32_t delta = targets.offsets[target]; delta < targets.offsets[target + 1]; delta++)
+        {
+            const uint32_t vertex = targets.vertex_indices[delta];
+            if (vertex >= vertex_entries.size() || vertex_entries[vertex] == VertexBuckets::PADDING)
+            {
+                throw std::invalid_argument("Morph target " + std::to_string(target) + " moves vertex " +
+                                            std::to_string(vertex) + " but the mesh has " +
+                                            std::to_string(buckets.count) + " vertices");
+            }
+            delta_entries[delta] = vertex_entries[vertex];
+            delta_targets[delta] = static_cast<uint32_t>(target);
+        }
+    }
+
+    std::vector<uint32_t> sorted(targets.delta_count());
+    for (size_t delta = 0; delta < sorted.size(); delta++)
+    {
+        sorted[delta] = static_cast<uint32_t>(delta);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [&](uint32_t lhs, uint32_t rhs)
+    {
+        return delta_entries[lhs] < delta_entries[rhs];
+    });
+
+    MorphStreams streams;
+    const size_t chunk_count = buckets.padded_count() / CHUNK_SIZE;
+    streams.chunk_offsets.assign(chunk_count + 1, 0);
+    streams.entries.reserve(sorted.size());
+    streams.targets.reserve(sorted.size());
+    streams.deltas.reserve(sorted.size());
+    for (const uint32_t delta : sorted)
+    {
+        streams.entries.push_back(delta_entries[delta]);
+        streams.targets.push_back(delta_targets[delta]);
+        streams.deltas.push_back(targets.deltas[delta]);
+        streams.chunk_offsets[delta_entries[delta] / CHUNK_SIZE + 1]++;
+    }
+    for (size_t chunk = 0; chunk < chunk_count; chunk++)
+    {
+        streams.chunk_offsets[chunk + 1] += streams.chunk_offsets[chunk];
+    }
+
+    // The distinct chunks of each target, and its largest offset along each axis
+    streams.target_offsets.assign(target_count + 1, 0);
+    streams.target_extents.assign(target_count, HMM_V3(0.f, 0.f, 0.f));
+    std::vector<uint32_t> chunks;
+    for (size_t target = 0; target < target_count; target++)
+    {
+        chunks.clear();
+        HMM_Vec3& extent = streams.target_extents[target];
+        for (uint32_t delta = targets.offsets[target]; delta < targets.offsets[target + 1]; delta++)
+        {
+            chunks.push_back(static_cast<uint32_t>(delta_entries[delta] / CHUNK_SIZE));
+            extent = HMM_V3(std::max(extent.X, std::abs(targets.deltas[delta].X)),
+                            std::max(extent.Y, std::abs(targets.deltas[delta].Y)),
+                            std::max(extent.Z, std::abs(targets.deltas[delta].Z)));
+        }
+        std::sort(chunks.begin(), chunks.end());
+        chunks.erase(std::unique(chunks.begin(), chunks.end()), chunks.end());
+
+        streams.target_chunks.insert(streams.target_chunks.end(), chunks.begin(), chunks.end());
+        streams.target_offsets[target + 1] = static_cast<uint32_t>(streams.target_chunks.size());
+    }
+
+    return streams;
+}
+
+void MorphStreams::apply(const float* weights, const VertexStreams& rest, VertexStreams& morphed,
+                         size_t begin, size_t end) const
+{
+    constexpr size_t CHUNK_SIZE = InfluenceStreams::CHUNK_SIZE;
+
+    for (size_t chunk = begin / CHUNK_SIZE; chunk < (end + CHUNK_SIZE - 1) / CHUNK_SIZE; chunk++)
+    {
+        const uint32_t first = chunk_offsets[chunk];
+        const uint32_t last = chunk_offsets[chunk + 1];
+        if (first == last)
+            continue;
+
+        // Start from the rest pose, so the chunk never accumulates earlier frames' deltas
+        const size_t chunk_begin = chunk * CHUNK_SIZE;
+        std::copy_n(rest.x.data() + chunk_begin, CHUNK_SIZE, morphed.x.data() + chunk_begin);
+        std::copy_n(rest.y.data() + chunk_begin, CHUNK_SIZE, morphed.y.data() + chunk_begin);
+        std::copy_n(rest.z.data() + chunk_begin, CHUNK_SIZE, morphed.z.data() + chunk_begin);
+
+        for (uint32_t delta = first; delta < last; delta++)
+        {
+            const float weight = weights[targets[delta]];
+            if (weight == 0.f)
+                continue;
+
+            const uint32_t entry = entries[delta];
+            morphed.x[entry] += weight * deltas[delta].X;
+            morphed.y[entry] += weight * deltas[delta].Y;
+            morphed.z[entry] += weight * deltas[delta].Z;
+        }
+    }
+}
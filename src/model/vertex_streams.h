@@ -0,0 +1,847 @@
+#pragma once
+
+// Standard library imports
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Local application imports
+#include "model/skinning_data.h"
+
+
+struct Vertex;
+
+/**
+ * @brief Minimal allocator returning memory aligned to a fixed boundary.
+ *
+ * Used by the structure-of-arrays streams so that every stream starts on a
+ * boundary suitable for aligned SIMD loads and stores. resize() default-initializes
+ * new elements (leaving numbers uninitialized), so the pages of a fresh stream are
+ * first touched by whichever thread writes them; assign() still fills as usual.
+ *
+ * @tparam T The element type.
+ * @tparam Alignment The required alignment in bytes (must be a power of two).
+ */
+template <typename T, size_t Alignment>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* ptr, size_t) noexcept
+    {
+        ::operator delete(ptr, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    void construct(U* ptr) noexcept
+    {
+        ::new (static_cast<void*>(ptr)) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* ptr, Args&&... args)
+    {
+        ::new (static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+/**
+ * @brief Alignment (in bytes) of every SIMD stream, enough for a full AVX-512 register.
+ */
+constexpr size_t SIMD_ALIGNMENT = 64;
+
+/**
+ * @brief A std::vector whose storage is aligned to SIMD_ALIGNMENT.
+ */
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T, SIMD_ALIGNMENT>>;
+
+/**
+ * @brief A permutation grouping vertices into buckets of equal influence count.
+ *
+ * Vertices are stably sorted by their effective influence count (negligible
+ * weights and invalid joint IDs excluded), and every bucket is padded to a
+ * multiple of InfluenceStreams::CHUNK_SIZE. Streams built in this order have
+ * chunks whose vertices all share one influence count, so a kernel never blends
+ * padding slots, and each bucket can be handed to a loop specialized for its count.
+ */
+struct VertexBuckets
+{
+    /**
+     * @brief Marks a padding entry in order (no source vertex).
+     */
+    static constexpr uint32_t PADDING = 0xFFFFFFFFu;
+
+    /**
+     * @brief A contiguous range of vertices, in skinning order, sharing one influence count.
+     */
+    struct Bucket
+    {
+        /**
+         * @brief Number of effective influences of every vertex in the bucket.
+         */
+        size_t influence_count;
+
+        /**
+         * @brief First entry of the bucket (a multiple of InfluenceStreams::CHUNK_SIZE).
+         */
+        size_t begin;
+
+        /**
+         * @brief One past the last entry of the bucket (a multiple of InfluenceStreams::CHUNK_SIZE).
+         */
+        size_t end;
+    };
+
+    /**
+     * @brief Builds the permutation from sparse per-vertex weights.
+     * @param weights The per-vertex joint influences.
+     * @param weight_threshold Weights below this value do not count as influences.
+     * @return The bucketed vertex order.
+     */
+    static VertexBuckets from_sparse_weights(const SparseWeights& weights, float weight_threshold);
+
+    /**
+     * @brief Gets the number of entries in skinning order, padding included.
+     * @return The padded vertex count.
+     */
+    size_t padded_count() const { return order.size(); }
+
+    /**
+     * @brief Number of real vertices in the permutation.
+     */
+    size_t count = 0;
+
+    /**
+     * @brief The original index of the vertex at each position in skinning order, or PADDING.
+     */
+    std::vector<uint32_t> order;
+
+    /**
+     * @brief The buckets, by increasing influence count.
+     */
+    std::vector<Bucket> buckets;
+};
+
+/**
+ * @brief How positions are stored in a PositionBuffer.
+ */
+enum class PositionFormat
+{
+    /**
+     * @brief Three 32-bit floats per vertex.
+     */
+    Float32,
+
+    /**
+     * @brief Three IEEE 754 half-precision floats per vertex (see PositionBuffer::to_half()).
+     */
+    Float16,
+
+    /**
+     * @brief Three 16-bit unsigned values per vertex, normalized to the frame's bounding box.
+     *
+     * Component k decodes to bounds.min[k] + value / 65535 * (bounds.max[k] - bounds.min[k]).
+     */
+    Unorm16
+};
+
+/**
+ * @brief An axis-aligned box, such as the extent of a skinned frame.
+ */
+struct PositionBounds
+{
+    bool operator==(const PositionBounds& other) const
+    {
+        return min[0] == other.min[0] && min[1] == other.min[1] && min[2] == other.min[2] &&
+               max[0] == other.max[0] && max[1] == other.max[1] && max[2] == other.max[2];
+    }
+
+    /**
+     * @brief The smallest x, y and z.
+     */
+    float min[3] = { 0.f, 0.f, 0.f };
+
+    /**
+     * @brief The largest x, y and z.
+     */
+    float max[3] = { 0.f, 0.f, 0.f };
+};
+
+/**
+ * @brief A sphere enclosing a set of positions, such as a skinned frame.
+ */
+struct BoundingSphere
+{
+    /**
+     * @brief The center's x, y and z.
+     */
+    float center[3] = { 0.f, 0.f, 0.f };
+
+    /**
+     * @brief The distance from the center to the farthest position.
+     */
+    float radius = 0.f;
+};
+
+/**
+ * @brief A caller-owned destination for vertex positions, possibly interleaved with other data.
+ *
+ * Vertex i's x, y and z are written as three consecutive components (floats by default)
+ * starting at byte i * stride of data; the bytes in between (normals, UVs, ...) are left
+ * untouched. This covers tightly packed float3 arrays, mapped vertex buffers and AoS Vertex
+ * arrays, as well as half-size 16-bit positions for preview and streaming consumers.
+ */
+struct PositionBuffer
+{
+    /**
+     * @brief Wraps an array of AoS vertices.
+     * @param vertices The vertices to write into (not resized).
+     * @return A buffer addressing the vertices' positions.
+     */
+    static PositionBuffer from_vertices(std::vector<Vertex>& vertices);
+
+    /**
+     * @brief Wraps a tightly packed array of positions.
+     * @param data The first component of the first vertex.
+     * @param vertex_count The number of vertices the array holds.
+     * @param format The format of each component.
+     * @return A buffer whose stride is three components.
+     */
+    static PositionBuffer packed(void* data, size_t vertex_count,
+                                 PositionFormat format = PositionFormat::Float32);
+
+    /**
+     * @brief Gets the size of one position component.
+     * @param format The position format.
+     * @return 4 for Float32; otherwise 2.
+     */
+    static size_t component_size(PositionFormat format);
+
+    /**
+     * @brief Converts a float to the nearest half-precision float (ties to even).
+     * @param value The value to convert.
+     * @return The IEEE 754 binary16 bits (infinite if out of range).
+     */
+    static uint16_t to_half(float value);
+
+    /**
+     * @brief Converts a half-precision float back to a float (exactly).
+     * @param half The IEEE 754 binary16 bits.
+     * @return The value.
+     */
+    static float from_half(uint16_t half);
+
+    /**
+     * @brief Checks whether two buffers address the same memory in the same layout.
+     */
+    bool operator==(const PositionBuffer& other) const
+    {
+        return data == other.data && vertex_count == other.vertex_count && stride == other.stride &&
+               format == other.format && bounds == other.bounds;
+    }
+
+    /**
+     * @brief The x coordinate of the first vertex (aligned to the component size).
+     */
+    void* data = nullptr;
+
+    /**
+     * @brief The number of vertices the buffer holds.
+     */
+    size_t vertex_count = 0;
+
+    /**
+     * @brief The distance in bytes between consecutive vertices (a multiple of the component size).
+     */
+    size_t stride = 3 * sizeof(float);
+
+    /**
+     * @brief How the positions are stored.
+     */
+    PositionFormat format = PositionFormat::Float32;
+
+    /**
+     * @brief The box the Unorm16 positions are normalized to.
+     *
+     * Required for Unorm16: the skinner stores the frame's bounding box here before writing
+     * the positions, and VertexStreams::to_positions() reads it.
+     */
+    PositionBounds* bounds = nullptr;
+};
+
+/**
+ * @brief Structure-of-arrays storage for vertex positions.
+ *
+ * Positions are split into separate x, y and z streams so that a SIMD kernel
+ * can load the same coordinate of several consecutive vertices with a single
+ * instruction. Each stream is aligned and padded with zeros up to a multiple
+ * of LANE_PADDING, which lets kernels process whole registers without a
+ * scalar remainder loop.
+ */
+struct VertexStreams
+{
+    /**
+     * @brief Number of vertices every stream is padded to a multiple of.
+     *
+     * Matches the widest kernel variant (16 floats per AVX-512 register).
+     */
+    static constexpr size_t LANE_PADDING = 16;
+
+    /**
+     * @brief Rounds a vertex count up to the next multiple of LANE_PADDING.
+     * @param vertex_count The number of real vertices.
+     * @return The padded vertex count.
+     */
+    static constexpr size_t padded_size(size_t vertex_count)
+    {
+        return (vertex_count + LANE_PADDING - 1) / LANE_PADDING * LANE_PADDING;
+    }
+
+    /**
+     * @brief Builds the streams from an array of AoS vertices.
+     * @param vertices The source vertices.
+     * @return The populated streams, padded with zeroed vertices.
+     */
+    static VertexStreams from_vertices(const std::vector<Vertex>& vertices);
+
+    /**
+     * @brief Builds the streams from an array of AoS vertices, in bucketed skinning order.
+     * @param vertices The source vertices.
+     * @param buckets The permutation to gather the vertices in.
+     * @return The populated streams, with zeroed vertices in the padding entries.
+     */
+    static VertexStreams from_vertices(const std::vector<Vertex>& vertices,
+                                       const VertexBuckets& buckets);
+
+    /**
+     * @brief Resizes all streams for the given number of vertices (plus padding).
+     * @param vertex_count The number of real vertices.
+     */
+    void resize(size_t vertex_count);
+
+    /**
+     * @brief Resizes all streams to hold the vertices of a bucketed permutation.
+     * @param buckets The permutation the streams will be written in.
+     */
+    void resize(const VertexBuckets& buckets);
+
+    /**
+     * @brief Writes the real (non-padding) vertices back into an AoS array.
+     * @param vertices The destination array, resized to the vertex count.
+     */
+    void to_vertices(std::vector<Vertex>& vertices) const;
+
+    /**
+     * @brief Scatters streams stored in bucketed skinning order back to the original vertex order.
+     * @param vertices The destination array, resized to the vertex count.
+     * @param buckets The permutation the streams were written in.
+     */
+    void to_vertices(std::vector<Vertex>& vertices, const VertexBuckets& buckets) const;
+
+    /**
+     * @brief Scatters a range of entries in bucketed skinning order back into an AoS array.
+     * @param vertices The destination array, already holding every vertex.
+     * @param buckets The permutation the streams were written in.
+     * @param begin The first entry to scatter.
+     * @param end One past the last entry to scatter.
+     */
+    void to_vertices(std::vector<Vertex>& vertices, const VertexBuckets& buckets,
+                     size_t begin, size_t end) const;
+
+    /**
+     * @brief Scatters a range of entries in bucketed skinning order into a caller-owned buffer.
+     *
+     * Positions are converted to the buffer's format on the way; Unorm16 buffers are
+     * normalized to the box their bounds point to.
+     *
+     * @param output The destination, holding at least buckets.count vertices.
+     * @param buckets The permutation the streams were written in.
+     * @param begin The first entry to scatter.
+     * @param end One past the last entry to scatter.
+     */
+    void to_positions(const PositionBuffer& output, const VertexBuckets& buckets,
+                      size_t begin, size_t end) const;
+
+    /**
+     * @brief Computes the bounding box of a range of entries in bucketed skinning order.
+     * @param buckets The permutation the streams were written in (padding entries are skipped).
+     * @param begin The first entry.
+     * @param end One past the last entry.
+     * @return The box, or an empty one (min above max) if the range holds no vertex.
+     */
+    PositionBounds bounds(const VertexBuckets& buckets, size_t begin, size_t end) const;
+
+    /**
+     * @brief Computes the distance from a point to the farthest of a range of entries.
+     * @param buckets The permutation the streams were written in (padding entries are skipped).
+     * @param begin The first entry.
+     * @param end One past the last entry.
+     * @param center The point to measure from.
+     * @return The largest distance (0 if the range holds no vertex).
+     */
+    float radius(const VertexBuckets& buckets, size_t begin, size_t end, const float center[3]) const;
+
+    /**
+     * @brief Gets the number of entries in each stream, padding included.
+     * @return The padded vertex count.
+     */
+    size_t padded_count() const { return x.size(); }
+
+    /**
+     * @brief Number of real vertices stored in the streams.
+     */
+    size_t count = 0;
+
+    /**
+     * @brief X coordinates of every vertex.
+     */
+    AlignedVector<float> x;
+
+    /**
+     * @brief Y coordinates of every vertex.
+     */
+    AlignedVector<float> y;
+
+    /**
+     * @brief Z coordinates of every vertex.
+     */
+    AlignedVector<float> z;
+};
+
+/**
+ * @brief The precision of the skinning weights, as chosen by the user.
+ */
+enum class WeightPrecision
+{
+    /**
+     * @brief 32-bit float weights with 32-bit joint IDs (8 bytes per influence).
+     */
+    Float32,
+
+    /**
+     * @brief 16-bit unsigned normalized weights with compact joint IDs.
+     */
+    Unorm16,
+
+    /**
+     * @brief 8-bit unsigned normalized weights with compact joint IDs.
+     */
+    Unorm8
+};
+
+/**
+ * @brief How InfluenceStreams stores its joint IDs and weights.
+ *
+ * The compact encodings pair 8-bit joint IDs (rigs of up to 256 joints) or 16-bit ones
+ * (up to 65536) with unorm weights, which the kernels dequantize on the fly.
+ */
+enum class InfluenceEncoding
+{
+    Float32,
+    Joint16Unorm16,
+    Joint16Unorm8,
+    Joint8Unorm16,
+    Joint8Unorm8
+};
+
+/**
+ * @brief Number of InfluenceEncoding values (the outer width of the kernel dispatch tables).
+ */
+constexpr size_t INFLUENCE_ENCODING_COUNT = 5;
+
+/**
+ * @brief Chunked structure-of-arrays storage for per-vertex joint influences.
+ *
+ * Vertices are grouped into chunks of CHUNK_SIZE consecutive vertices. A chunk
+ * stores as many influence slots as its most influenced vertex needs, and each
+ * slot holds the joint ID and weight of every vertex in the chunk contiguously,
+ * so a SIMD kernel loads the k-th influence of several vertices at once and
+ * never iterates more slots than the chunk really uses. Negligible influences
+ * and invalid joint IDs are dropped when the streams are built; vertices with
+ * fewer influences than their chunk are padded with (joint 0, weight 0), which
+ * keeps the kernel free of per-influence branches.
+ *
+ * The streams hold 32-bit joint IDs and float weights, or, once encode()d, one pair
+ * of the compact streams below (2 to 4 bytes per influence instead of 8).
+ */
+struct InfluenceStreams
+{
+    /**
+     * @brief Number of vertices per chunk (the padding of VertexStreams, so chunks never straddle it).
+     */
+    static constexpr size_t CHUNK_SIZE = VertexStreams::LANE_PADDING;
+
+    /**
+     * @brief Factor turning an 8-bit unorm weight into a float weight.
+     */
+    static constexpr float UNORM8_SCALE = 1.f / 255.f;
+
+    /**
+     * @brief Factor turning a 16-bit unorm weight into a float weight.
+     */
+    static constexpr float UNORM16_SCALE = 1.f / 65535.f;
+
+    /**
+     * @brief Builds the streams from sparse per-vertex weights.
+     * @param weights The per-vertex joint influences, any number per vertex.
+     * @param weight_threshold Weights below this value are treated as zero.
+     * @return The populated streams, covering VertexStreams::padded_size() vertices.
+     */
+    static InfluenceStreams from_sparse_weights(const SparseWeights& weights,
+                                                float weight_threshold);
+
+    /**
+     * @brief Builds the streams from sparse per-vertex weights, in bucketed skinning order.
+     * @param weights The per-vertex joint influences, any number per vertex.
+     * @param weight_threshold Weights below this value are treated as zero.
+     * @param buckets The permutation to gather the influences in.
+     * @return The populated streams, covering buckets.padded_count() entries.
+     */
+    static InfluenceStreams from_sparse_weights(const SparseWeights& weights,
+                                                float weight_threshold,
+                                                const VertexBuckets& buckets);
+
+    /**
+     * @brief Builds the streams from fixed-size per-vertex weights.
+     * @param weights The per-vertex joint influences.
+     * @param weight_threshold Weights below this value are treated as zero.
+     * @return The populated streams, covering VertexStreams::padded_size() vertices.
+     */
+    static InfluenceStreams from_weights(const std::vector<VertexWeights>& weights,
+                                         float weight_threshold);
+
+    /**
+     * @brief Picks the most compact encoding for a weight precision and rig size.
+     * @param precision The requested weight precision.
+     * @param joint_count The number of joints the weights reference.
+     * @return Float32 for float weights; otherwise the unorm encoding with the narrowest joint IDs.
+     * @throws std::invalid_argument if the rig has too many joints for 16-bit joint IDs.
+     */
+    static InfluenceEncoding select_encoding(WeightPrecision precision, size_t joint_count);
+
+    /**
+     * @brief Gets the storage size of one influence slot entry.
+     * @param encoding The encoding.
+     * @return The bytes of one joint ID plus one weight.
+     */
+    static size_t bytes_per_influence(InfluenceEncoding encoding);
+
+    /**
+     * @brief Re-encodes float streams in a compact encoding.
+     *
+     * Each vertex's weights are rounded so that their unorm values still sum to exactly
+     * the largest unorm value, i.e. the dequantized weights still sum to 1.
+     *
+     * @param encoding The target encoding.
+     * @return Streams with the same chunk layout, whose float joint_ids and weights are empty.
+     * @throws std::invalid_argument if these streams are not Float32 or a joint ID does not fit.
+     */
+    InfluenceStreams encode(InfluenceEncoding encoding) const;
+
+    /**
+     * @brief Gets the number of slot entries in the streams (CHUNK_SIZE per slot of each chunk).
+     * @return The length of the joint ID and weight streams of the active encoding.
+     */
+    size_t entry_count() const;
+
+    /**
+     * @brief Decodes the joint ID of one slot entry, whatever the encoding.
+     * @param entry The slot entry.
+     * @return The joint ID.
+     */
+    int32_t joint_id(size_t entry) const;
+
+    /**
+     * @brief Decodes the weight of one slot entry, exactly as the kernels dequantize it.
+     * @param entry The slot entry.
+     * @return The weight.
+     */
+    float weight(size_t entry) const;
+
+    /**
+     * @brief How joint IDs and weights are stored.
+     */
+    InfluenceEncoding encoding = InfluenceEncoding::Float32;
+
+    /**
+     * @brief Number of real vertices stored in the streams.
+     */
+    size_t count = 0;
+
+    /**
+     * @brief Index in joint_ids and weights of the first slot of each chunk.
+     */
+    std::vector<uint32_t> chunk_offsets;
+
+    /**
+     * @brief Number of influence slots stored for each chunk.
+     */
+    std::vector<uint32_t> chunk_influences;
+
+    /**
+     * @brief Joint IDs, CHUNK_SIZE entries per slot of each chunk (Float32 encoding only).
+     */
+    AlignedVector<int32_t> joint_ids;
+
+    /**
+     * @brief Joint weights, laid out like joint_ids (Float32 encoding only).
+     */
+    AlignedVector<float> weights;
+
+    /**
+     * @brief 16-bit joint IDs of the Joint16 encodings, laid out like joint_ids.
+     */
+    AlignedVector<uint16_t> joint_ids_16;
+
+    /**
+     * @brief 8-bit joint IDs of the Joint8 encodings, laid out like joint_ids.
+     */
+    AlignedVector<uint8_t> joint_ids_8;
+
+    /**
+     * @brief Weights of the Unorm16 encodings (weight * 65535), laid out like joint_ids.
+     */
+    AlignedVector<uint16_t> weights_unorm16;
+
+    /**
+     * @brief Weights of the Unorm8 encodings (weight * 255), laid out like joint_ids.
+     */
+    AlignedVector<uint8_t> weights_unorm8;
+};
+
+/**
+ * @brief Reverse index from each joint to the influence chunks it affects.
+ *
+ * Built from InfluenceStreams, so chunk c covers entries [c * CHUNK_SIZE, (c + 1) * CHUNK_SIZE)
+ * of the streams' order. When only a few joints move, the chunks listed for them are the
+ * only vertices whose skinned positions can change.
+ */
+struct JointChunkIndex
+{
+    /**
+     * @brief Builds the index from packed influence streams (zero-weight slots are skipped).
+     * @param influences The influence streams to index.
+     * @return The index, covering every joint ID referenced by the streams.
+     */
+    static JointChunkIndex from_influence_streams(const InfluenceStreams& influences);
+
+    /**
+     * @brief Gets the number of joints in the index (one past the largest referenced joint ID).
+     * @return The joint count.
+     */
+    size_t joint_count() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    /**
+     * @brief Index in chunks of the first chunk of each joint (joint_count() + 1 entries).
+     */
+    std::vector<uint32_t> offsets;
+
+    /**
+     * @brief Chunk indices, in increasing order for each joint.
+     */
+    std::vector<uint32_t> chunks;
+};
+
+/**
+ * @brief A tiling of the bucketed vertex order into meshlets with small joint sets.
+ *
+ * Each bucket is re-sorted by dominant joint and cut into meshlets of at most MAX_VERTICES
+ * entries referencing at most MAX_JOINTS joints, each padded to whole chunks. A meshlet
+ * lists the joints it uses, and localize() rewrites the joint IDs of its influences as
+ * indices into that list, so a kernel can skin it against a gathered sub-palette that
+ * stays in L1. Only the skinning order changes: vertices still scatter to their original
+ * indices.
+ */
+struct Meshlets
+{
+    /**
+     * @brief Most entries in one meshlet (a multiple of InfluenceStreams::CHUNK_SIZE).
+     */
+    static constexpr size_t MAX_VERTICES = 128;
+
+    /**
+     * @brief Most joints referenced by one meshlet (unless a single vertex has more influences).
+     */
+    static constexpr size_t MAX_JOINTS = 64;
+
+    /**
+     * @brief A chunk-aligned range of entries within one bucket, with its joint list.
+     */
+    struct Meshlet
+    {
+        /**
+         * @brief Number of effective influences of every vertex in the meshlet.
+         */
+        size_t influence_count;
+
+        /**
+         * @brief First entry of the meshlet (a multiple of InfluenceStreams::CHUNK_SIZE).
+         */
+        size_t begin;
+
+        /**
+         * @brief One past the last entry of the meshlet (a multiple of InfluenceStreams::CHUNK_SIZE).
+         */
+        size_t end;
+
+        /**
+         * @brief Index in joints of the meshlet's first joint.
+         */
+        uint32_t joint_begin;
+
+        /**
+         * @brief One past the index in joints of the meshlet's last joint.
+         */
+        uint32_t joint_end;
+    };
+
+    /**
+     * @brief Tiles a bucketed vertex order into meshlets, reordering it in place.
+     * @param weights The per-vertex joint influences the order was built from.
+     * @param weight_threshold Weights below this value do not count as influences.
+     * @param buckets The order to tile; receives the meshlet order (with extra padding).
+     * @return The meshlets, covering every bucket back to back.
+     */
+    static Meshlets tile(const SparseWeights& weights, float weight_threshold, VertexBuckets& buckets);
+
+    /**
+     * @brief Rewrites the joint IDs of Float32 influence streams as meshlet-local indices.
+     * @param influences Streams built from the tiled order (padding slots get index 0).
+     */
+    void localize(InfluenceStreams& influences) const;
+
+    /**
+     * @brief Gets the largest number of joints referenced by one meshlet.
+     * @return The joint count a local index must be able to address.
+     */
+    size_t max_joint_count() const;
+
+    /**
+     * @brief Gets the meshlet holding an entry.
+     * @param entry An entry in skinning order.
+     * @return The index of the meshlet in meshlets.
+     */
+    size_t meshlet_of(size_t entry) const { return chunk_meshlets[entry / InfluenceStreams::CHUNK_SIZE]; }
+
+    /**
+     * @brief The meshlets, in skinning order.
+     */
+    std::vector<Meshlet> meshlets;
+
+    /**
+     * @brief The global joint ID of each local index, meshlet after meshlet (ascending within one).
+     */
+    std::vector<uint32_t> joints;
+
+    /**
+     * @brief The meshlet of each influence chunk.
+     */
+    std::vector<uint32_t> chunk_meshlets;
+};
+
+/**
+ * @brief Sparse morph targets regrouped by influence chunk of the bucketed vertex order.
+ *
+ * The deltas of each chunk are stored back to back, sorted by entry, so the task that skins
+ * a chunk can first morph its rest positions while they are in cache. Chunks that no target
+ * moves hold no deltas and are never rewritten. The chunks each target moves are indexed
+ * too, so changing one weight only re-skins those chunks.
+ */
+struct MorphStreams
+{
+    /**
+     * @brief Regroups morph targets in skinning order.
+     * @param targets The targets, indexing vertices in original order.
+     * @param buckets The bucketed vertex order.
+     * @return The streams, covering every chunk of the order.
+     * @throws std::invalid_argument if a target moves a vertex the order does not hold.
+     */
+    static MorphStreams from_morph_targets(const MorphTargets& targets, const VertexBuckets& buckets);
+
+    /**
+     * @brief Gets the number of targets indexed.
+     * @return The target count.
+     */
+    size_t target_count() const { return target_offsets.empty() ? 0 : target_offsets.size() - 1; }
+
+    /**
+     * @brief Checks whether any target moves a vertex.
+     * @return true if there is nothing to morph; otherwise false.
+     */
+    bool empty() const { return entries.empty(); }
+
+    /**
+     * @brief Morphs the rest positions of every moved chunk in [begin, end).
+     *
+     * Each such chunk is reset to the rest pose, then receives the weighted deltas of every
+     * target with a nonzero weight. Entries of chunks without deltas are not written.
+     *
+     * @param weights The weight of each target.
+     * @param rest The rest positions in skinning order.
+     * @param morphed Receives the morphed positions (sized like rest).
+     * @param begin The first entry (a multiple of InfluenceStreams::CHUNK_SIZE).
+     * @param end One past the last entry.
+     */
+    void apply(const float* weights, const VertexStreams& rest, VertexStreams& morphed,
+               size_t begin, size_t end) const;
+
+    /**
+     * @brief Index in entries of the first delta of each chunk, plus one final entry holding the total.
+     */
+    std::vector<uint32_t> chunk_offsets;
+
+    /**
+     * @brief The entry each delta moves, in increasing order.
+     */
+    std::vector<uint32_t> entries;
+
+    /**
+     * @brief The target of each delta (ascending for one entry).
+     */
+    std::vector<uint32_t> targets;
+
+    /**
+     * @brief The rest-space offset of each delta.
+     */
+    std::vector<HMM_Vec3> deltas;
+
+    /**
+     * @brief Index in target_chunks of the first chunk of each target (target_count() + 1 entries).
+     */
+    std::vector<uint32_t> target_offsets;
+
+    /**
+     * @brief Chunk indices, in increasing order for each target.
+     */
+    std::vector<uint32_t> target_chunks;
+
+    /**
+     * @brief The largest |delta| along each axis of each target.
+     */
+    std::vector<HMM_Vec3> target_extents;
+};
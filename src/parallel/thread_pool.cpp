@@ -0,0 +1,382 @@
+#include "thread_pool.h"
+
+// Standard library imports
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+// Platform-specific includes
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+namespace {
+
+// Set on pool workers, and on a caller while it runs tasks, so nested loops run inline
+// instead of waiting on themselves
+thread_local bool inside_pool_task = false;
+
+uint64_t pack_tasks(uint32_t first, uint32_t end)
+{
+    return (static_cast<uint64_t>(first) << 32) | end;
+}
+
+uint32_t first_task(uint64_t tasks)
+{
+    return static_cast<uint32_t>(tasks >> 32);
+}
+
+uint32_t end_task(uint64_t tasks)
+{
+    return static_cast<uint32_t>(tasks);
+}
+
+// Parses a kernel CPU list such as "0-3,8-11"
+std::vector<int> parse_cpu_list(const std::string& cpu_list)
+{
+    std::vector<int> cpus;
+    std::stringstream stream(cpu_list);
+    std::string item;
+    while (std::getline(stream, item, ','))
+    {
+        const size_t dash = item.find('-');
+        const int first = std::stoi(item.substr(0, dash));
+        const int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+        for (int cpu = first; cpu <= last; cpu++)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+// Restricts a thread to the given CPUs (best effort)
+void pin_thread(std::thread& thread, const std::vector<int>& cpus)
+{
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (const int cpu : cpus)
+    {
+        if (cpu >= 0 && cpu < CPU_SETSIZE)
+            CPU_SET(cpu, &cpu_set);
+    }
+    pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set), &cpu_set);
+#else
+    (void)thread;
+    (void)cpus;
+#endif
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t thread_count, bool numa_aware)
+{
+    const std::vector<std::vector<int>> numa_nodes =
+        numa_aware ? detect_numa_nodes() : std::vector<std::vector<int>>();
+    caller_runs_tasks = numa_nodes.empty();
+
+    if (thread_count == 0)
+    {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Participant 0 is whichever thread calls parallel_for(); in NUMA-aware mode it
+    // only waits, so there is one worker per requested thread
+    const size_t worker_count = caller_runs_tasks ? thread_count - 1 : thread_count;
+    const size_t participants = worker_count + 1;
+
+    task_ranges.reset(new TaskRange[participants]);
+    participant_nodes.assign(participants, 0);
+    for (size_t participant = 0; participant < participants; participant++)
+    {
+        task_ranges[participant].tasks.store(0, std::memory_order_relaxed);
+    }
+
+    // Give each node a contiguous block of workers, so contiguous runs of tasks map to nodes
+    if (!caller_runs_tasks)
+    {
+        node_count = std::min(numa_nodes.size(), worker_count);
+        for (size_t worker = 0; worker < worker_count; worker++)
+        {
+            participant_nodes[worker + 1] = worker * node_count / worker_count;
+        }
+    }
+
+    workers.reserve(worker_count);
+    try
+    {
+        for (size_t participant = 1; participant < participants; participant++)
+        {
+            workers.emplace_back(&ThreadPool::worker_loop, this, participant);
+            if (!caller_runs_tasks)
+            {
+                pin_thread(workers.back(), numa_nodes[participant_nodes[participant]]);
+            }
+        }
+    }
+    catch (...)
+    {
+        // The destructor won't run, and destroying a joinable thread terminates the process
+        stop_workers();
+        throw;
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    stop_workers();
+}
+
+size_t ThreadPool::get_thread_count() const
+{
+    return caller_runs_tasks ? workers.size() + 1 : workers.size();
+}
+
+size_t ThreadPool::get_node_count() const
+{
+    return node_count;
+}
+
+std::vector<std::vector<int>> ThreadPool::detect_numa_nodes()
+{
+    std::vector<std::vector<int>> nodes;
+
+#if defined(__linux__)
+    namespace fs = std::filesystem;
+
+    std::error_code error;
+    for (size_t node = 0; ; node++)
+    {
+        const fs::path cpu_list_path =
+            fs::path("/sys/devices/system/node") / ("node" + std::to_string(node)) / "cpulist";
+        if (!fs::exists(cpu_list_path, error))
+            break;
+
+        std::ifstream cpu_list_file(cpu_list_path);
+        std::string cpu_list;
+        std::getline(cpu_list_file, cpu_list);
+
+        // Memory-only nodes have no CPUs to pin to
+        std::vector<int> cpus = parse_cpu_list(cpu_list);
+        if (!cpus.empty())
+            nodes.push_back(std::move(cpus));
+    }
+#endif
+
+    return nodes;
+}
+
+void ThreadPool::parallel_for(size_t begin, size_t end, size_t grain_size, RangeRef body)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+
+    grain_size = std::max<size_t>(grain_size, 1);
+    const size_t task_count = (end - begin + grain_size - 1) / grain_size;
+    if (task_count > std::numeric_limits<uint32_t>::max())
+    {
+        throw std::length_error("Too many tasks for one parallel loop");
+    }
+
+    // Nothing to share out: run in place (this also covers loops nested in a task)
+    if (inside_pool_task || (caller_runs_tasks && (task_count == 1 || workers.empty())))
+    {
+        for (size_t task_begin = begin; task_begin < end; task_begin += grain_size)
+        {
+            body(task_begin, std::min(task_begin + grain_size, end));
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit_lock(submit_mutex);
+
+    current_body = &body;
+    current_begin = begin;
+    current_end = end;
+    current_grain = grain_size;
+    failed.store(false, std::memory_order_relaxed);
+    first_exception = nullptr;
+
+    // Deal each participant a contiguous run of tasks, so neighbouring tasks share a thread
+    // (and, in NUMA-aware mode, the same loop shape always deals the same ranges to a node)
+    const size_t first_participant = caller_runs_tasks ? 0 : 1;
+    const size_t runners = workers.size() + 1 - first_participant;
+    task_ranges[0].tasks.store(0, std::memory_order_relaxed);
+    for (size_t runner = 0; runner < runners; runner++)
+    {
+        const uint32_t first = static_cast<uint32_t>(task_count * runner / runners);
+        const uint32_t last = static_cast<uint32_t>(task_count * (runner + 1) / runners);
+        task_ranges[first_participant + runner].tasks.store(pack_tasks(first, last),
+                                                            std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        generation++;
+        busy_workers = workers.size();
+    }
+    work_available.notify_all();
+
+    if (caller_runs_tasks)
+    {
+        inside_pool_task = true;
+        run_tasks(0);
+        inside_pool_task = false;
+    }
+
+    // Every worker must have left the loop before its task ranges can be reused
+    {
+        std::unique_lock<std::mutex> lock(state_mutex);
+        work_done.wait(lock, [this]() { return busy_workers == 0; });
+    }
+
+    current_body = nullptr;
+    if (first_exception)
+    {
+        std::rethrow_exception(first_exception);
+    }
+}
+
+void ThreadPool::stop_workers()
+{
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        stopping = true;
+    }
+    work_available.notify_all();
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::worker_loop(size_t participant)
+{
+    inside_pool_task = true;
+    uint64_t seen_generation = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(state_mutex);
+            work_available.wait(lock, [&]() { return stopping || generation != seen_generation; });
+            if (stopping)
+            {
+                return;
+            }
+            seen_generation = generation;
+        }
+
+        run_tasks(participant);
+
+        bool last_worker = false;
+        {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            last_worker = --busy_workers == 0;
+        }
+        if (last_worker)
+        {
+            work_done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::run_tasks(size_t participant)
+{
+    uint32_t task;
+    while (pop_task(participant, task) || steal_task(participant, task))
+    {
+        execute_task(task);
+    }
+}
+
+bool ThreadPool::pop_task(size_t participant, uint32_t& task)
+{
+    std::atomic<uint64_t>& own = task_ranges[participant].tasks;
+    uint64_t tasks = own.load(std::memory_order_acquire);
+
+    while (first_task(tasks) < end_task(tasks))
+    {
+        if (own.compare_exchange_weak(tasks, pack_tasks(first_task(tasks) + 1, end_task(tasks)),
+                                      std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            task = first_task(tasks);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::steal_task(size_t participant, uint32_t& task)
+{
+    const size_t participants = workers.size() + 1;
+    const size_t own_node = participant_nodes[participant];
+
+    // Try victims on our own node first, then the rest; start with the next participant,
+    // so thieves spread over different victims
+    for (const bool same_node : { true, false })
+    {
+        for (size_t offset = 1; offset < participants; offset++)
+        {
+            const size_t victim_index = (participant + offset) % participants;
+            if ((participant_nodes[victim_index] == own_node) != same_node)
+                continue;
+
+            std::atomic<uint64_t>& victim = task_ranges[victim_index].tasks;
+            uint64_t tasks = victim.load(std::memory_order_acquire);
+
+            while (first_task(tasks) < end_task(tasks))
+            {
+                const uint32_t first = first_task(tasks);
+                const uint32_t last = end_task(tasks);
+                const uint32_t middle = first + (last - first) / 2;
+
+                if (victim.compare_exchange_weak(tasks, pack_tasks(first, middle),
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_acquire))
+                {
+                    // Our own run is empty, so no other thief can be updating it
+                    task = middle;
+                    task_ranges[participant].tasks.store(pack_tasks(middle + 1, last),
+                                                         std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void ThreadPool::execute_task(uint32_t task)
+{
+    if (failed.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    const size_t task_begin = current_begin + task * current_grain;
+    const size_t task_end = std::min(task_begin + current_grain, current_end);
+
+    try
+    {
+        (*current_body)(task_begin, task_end);
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        if (!failed.exchange(true))
+        {
+            first_exception = std::current_exception();
+        }
+    }
+}
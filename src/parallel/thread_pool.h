@@ -0,0 +1,170 @@
+#pragma once
+
+// Standard library imports
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+/**
+ * @brief A fixed-size pool of worker threads running parallel loops with work stealing.
+ *
+ * parallel_for() splits an index range into tasks of grain_size indices and deals each
+ * participant (the workers plus the calling thread) a contiguous run of tasks. A
+ * participant takes tasks from the front of its own run; once it runs dry it steals
+ * the back half of another participant's run, so uneven task costs still balance out.
+ *
+ * Unlike std::execution::par, the parallelism does not depend on how the standard
+ * library was built or linked: the thread count and grain size are always honoured.
+ *
+ * In NUMA-aware mode the workers are pinned to the CPUs of the NUMA nodes in order
+ * (worker blocks per node), the caller only waits, and thieves prefer victims on their
+ * own node. A loop of the same shape therefore hands the same index ranges to the same
+ * node every time, so data first touched by one loop stays node-local for the next.
+ */
+class ThreadPool
+{
+public:
+
+    /**
+     * @brief A non-owning reference to the loop body, which processes the indices [begin, end).
+     *
+     * Unlike std::function, wrapping a lambda never allocates, so starting a loop doesn't
+     * either. The body must outlive the parallel_for() call, as a temporary argument does.
+     */
+    class RangeRef
+    {
+    public:
+
+        template <typename Body,
+                  typename = std::enable_if_t<!std::is_same_v<std::decay_t<Body>, RangeRef>>>
+        RangeRef(const Body& body)
+            : body(&body)
+            , invoke([](const void* target, size_t begin, size_t end)
+                     {
+                         (*static_cast<const Body*>(target))(begin, end);
+                     })
+        {
+        }
+
+        void operator()(size_t begin, size_t end) const { invoke(body, begin, end); }
+
+    private:
+
+        const void* body;
+        void (*invoke)(const void* target, size_t begin, size_t end);
+    };
+
+    /**
+     * @brief Starts the pool.
+     * @param thread_count The number of threads that run each loop, the caller included
+     *                     unless numa_aware is set (0 picks one per hardware thread).
+     * @param numa_aware Whether to pin workers to NUMA nodes and keep the caller out of loops.
+     *                   Ignored where the NUMA topology cannot be read.
+     * @throws std::system_error if a worker thread cannot be started (the workers started
+     *         before it are stopped and joined first).
+     */
+    explicit ThreadPool(size_t thread_count = 0, bool numa_aware = false);
+
+    /**
+     * @brief Stops and joins the workers.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Gets the number of threads that run each loop.
+     * @return The thread count (at least 1).
+     */
+    size_t get_thread_count() const;
+
+    /**
+     * @brief Gets the number of NUMA nodes the workers are spread over.
+     * @return The node count (1 unless the pool is NUMA-aware on a multi-node machine).
+     */
+    size_t get_node_count() const;
+
+    /**
+     * @brief Reads the CPUs of each NUMA node from the operating system.
+     * @return The CPU IDs of every node, or an empty list where the topology is unavailable.
+     */
+    static std::vector<std::vector<int>> detect_numa_nodes();
+
+    /**
+     * @brief Runs body over [begin, end) in tasks of grain_size indices and waits for all of them.
+     *
+     * Calls made from inside a task run serially on the calling worker, and concurrent
+     * calls from different threads take turns. If a task throws, the remaining tasks are
+     * skipped and the first exception is rethrown here.
+     *
+     * @param begin The first index.
+     * @param end One past the last index.
+     * @param grain_size The number of indices per task (0 is treated as 1).
+     * @param body The function processing each task's range.
+     */
+    void parallel_for(size_t begin, size_t end, size_t grain_size, RangeRef body);
+
+private:
+
+    // The remaining tasks of one participant, packed as (first << 32 | end) so that the
+    // owner and thieves can update both bounds with a single compare-and-swap
+    struct alignas(64) TaskRange
+    {
+        std::atomic<uint64_t> tasks;
+    };
+
+    // Loop executed by each worker thread.
+    void worker_loop(size_t participant);
+
+    // Tells the workers to exit and joins them.
+    void stop_workers();
+
+    // Runs tasks until none are left to take or steal.
+    void run_tasks(size_t participant);
+
+    // Takes the next task of a participant's own run.
+    bool pop_task(size_t participant, uint32_t& task);
+
+    // Moves the back half of another participant's run to this one, returning its first task.
+    bool steal_task(size_t participant, uint32_t& task);
+
+    // Runs one task, recording the first exception thrown.
+    void execute_task(uint32_t task);
+
+    std::vector<std::thread> workers;
+    std::unique_ptr<TaskRange[]> task_ranges;
+
+    // The NUMA node of each participant (all 0 unless NUMA-aware).
+    std::vector<size_t> participant_nodes;
+    size_t node_count = 1;
+    // False in NUMA-aware mode, where the (unpinned) caller only waits for the workers.
+    bool caller_runs_tasks = true;
+
+    // Serializes parallel_for() calls from different threads.
+    std::mutex submit_mutex;
+
+    // Wakes the workers for a new loop, and the caller once they are done.
+    std::mutex state_mutex;
+    std::condition_variable work_available;
+    std::condition_variable work_done;
+    uint64_t generation = 0;
+    size_t busy_workers = 0;
+    bool stopping = false;
+
+    // The loop being run.
+    const RangeRef* current_body = nullptr;
+    size_t current_begin = 0;
+    size_t current_end = 0;
+    size_t current_grain = 1;
+    std::atomic<bool> failed{ false };
+    std::exception_ptr first_exception;
+};
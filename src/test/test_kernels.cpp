@@ -0,0 +1,939 @@
+// Standard library imports
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// Third-party imports
+#include "handmade_math/handmade_math.h"
+
+// Local application imports
+#include "facade/math_facade.h"
+#include "kernel/skinning_kernels.h"
+#include "mesh_skinner.h"
+#include "model/mesh.h"
+#include "model/skinning_data.h"
+#include "model/vertex_streams.h"
+#include "test/test_framework.h"
+#include "test/test_utils.h"
+
+
+namespace {
+
+// Every kernel variant, from slowest to fastest
+const SkinningKernels::InstructionSet ALL_INSTRUCTION_SETS[] = {
+    SkinningKernels::InstructionSet::Scalar,
+    SkinningKernels::InstructionSet::SSE4,
+    SkinningKernels::InstructionSet::AVX2,
+    SkinningKernels::InstructionSet::AVX512
+};
+
+// Builds a deterministic pseudo-random mesh with the given number of vertices
+std::vector<Vertex> make_test_vertices(size_t vertex_count)
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> coord(-2.f, 2.f);
+
+    std::vector<Vertex> vertices(vertex_count);
+    for (auto& vert : vertices)
+    {
+        vert.x = coord(rng);
+        vert.y = coord(rng);
+        vert.z = coord(rng);
+    }
+    return vertices;
+}
+
+// Builds per-vertex weights that exercise negligible weights and invalid joint IDs
+std::vector<VertexWeights> make_test_weights(size_t vertex_count, int joint_count)
+{
+    std::mt19937 rng(5678);
+    std::uniform_int_distribution<int> joint(0, joint_count - 1);
+    std::uniform_real_distribution<float> weight(0.f, 1.f);
+
+    std::vector<VertexWeights> weights(vertex_count);
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        float total = 0.f;
+        for (size_t slot = 0; slot < VertexWeights::MAX_INFLUENCES; slot++)
+        {
+            weights[i].joint_ids[slot] = joint(rng);
+            weights[i].weights[slot] = weight(rng);
+            total += weights[i].weights[slot];
+        }
+        for (size_t slot = 0; slot < VertexWeights::MAX_INFLUENCES; slot++)
+        {
+            weights[i].weights[slot] /= total;
+        }
+
+        // Sprinkle in influences the kernel must ignore
+        if (i % 5 == 0) weights[i].weights[3] = 0.f;
+        if (i % 7 == 0) weights[i].joint_ids[2] = -1;
+    }
+    return weights;
+}
+
+// Builds sparse weights with 1 to 8 influences per vertex, mostly rigid like a typical body
+SparseWeights make_test_sparse_weights(size_t vertex_count, int joint_count)
+{
+    std::mt19937 rng(9012);
+    std::uniform_int_distribution<int> joint(0, joint_count - 1);
+    std::uniform_int_distribution<int> extra_influences(1, 8);
+    std::uniform_real_distribution<float> weight(.01f, 1.f);
+
+    SparseWeights weights;
+    weights.offsets.push_back(0);
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        const int influences = (i % 3 == 0) ? extra_influences(rng) : 1;
+
+        float total = 0.f;
+        for (int influence = 0; influence < influences; influence++)
+        {
+            weights.joint_ids.push_back(joint(rng));
+            weights.weights.push_back(weight(rng));
+            total += weights.weights.back();
+        }
+        for (int influence = 0; influence < influences; influence++)
+        {
+            weights.weights[weights.weights.size() - 1 - influence] /= total;
+        }
+
+        weights.offsets.push_back(static_cast<uint32_t>(weights.joint_ids.size()));
+    }
+    return weights;
+}
+
+// Builds a palette of non-trivial rigid skinning matrices
+std::vector<HMM_Mat4> make_test_palette(int joint_count)
+{
+    std::vector<HMM_Mat4> palette(joint_count);
+    for (int joint_id = 0; joint_id < joint_count; joint_id++)
+    {
+        const float angle = MathFacade::to_radians(17.f * joint_id);
+        palette[joint_id] = MathFacade::multiply(
+            MathFacade::translate(.5f * joint_id, -.25f * joint_id, 1.f),
+            MathFacade::multiply(MathFacade::rotateY(angle), MathFacade::rotateX(.5f * angle)));
+    }
+    return palette;
+}
+
+// Repacks a palette as the 3x4 matrices read by the affine linear blend kernels
+std::vector<AffineMatrix> make_affine_palette(const std::vector<HMM_Mat4>& palette)
+{
+    std::vector<AffineMatrix> affine_palette(palette.size());
+    for (size_t joint_id = 0; joint_id < palette.size(); joint_id++)
+    {
+        affine_palette[joint_id] = MathFacade::to_affine(palette[joint_id]);
+    }
+    return affine_palette;
+}
+
+// Reference linear blend skinning, one vertex at a time through MathFacade
+HMM_Vec3 reference_skin_vertex(const Vertex& vert, const VertexWeights& weights,
+                               const std::vector<HMM_Mat4>& palette)
+{
+    const HMM_Vec3 position = HMM_V3(vert.x, vert.y, vert.z);
+    HMM_Vec3 result = HMM_V3(0.f, 0.f, 0.f);
+
+    for (size_t slot = 0; slot < VertexWeights::MAX_INFLUENCES; slot++)
+    {
+        const int joint_id = weights.joint_ids[slot];
+        const float weight = weights.weights[slot];
+        if (weight < .0001f || joint_id < 0)
+            continue;
+
+        const HMM_Vec3 transformed = MathFacade::transform_vec3(palette[joint_id], position);
+        result.X += transformed.X * weight;
+        result.Y += transformed.Y * weight;
+        result.Z += transformed.Z * weight;
+    }
+    return result;
+}
+
+// Reference dual quaternion skinning, one vertex at a time through MathFacade
+HMM_Vec3 reference_dual_quaternion_skin_vertex(const Vertex& vert, const VertexWeights& weights,
+                                               const std::vector<DualQuaternion>& palette)
+{
+    DualQuaternion blend = { HMM_Q(0.f, 0.f, 0.f, 0.f), HMM_Q(0.f, 0.f, 0.f, 0.f) };
+
+    for (size_t slot = 0; slot < VertexWeights::MAX_INFLUENCES; slot++)
+    {
+        const int joint_id = weights.joint_ids[slot];
+        float weight = weights.weights[slot];
+        if (weight < .0001f || joint_id < 0)
+            continue;
+
+        // Keep every quaternion in the hemisphere of the running blend
+        if (HMM_DotQ(blend.real, palette[joint_id].real) < 0.f)
+            weight = -weight;
+
+        blend.real = HMM_AddQ(blend.real, HMM_MulQF(palette[joint_id].real, weight));
+        blend.dual = HMM_AddQ(blend.dual, HMM_MulQF(palette[joint_id].dual, weight));
+    }
+
+    const float length = std::sqrt(HMM_DotQ(blend.real, blend.real));
+    blend.real = HMM_DivQF(blend.real, length);
+    blend.dual = HMM_DivQF(blend.dual, length);
+
+    return MathFacade::transform_vec3(blend, HMM_V3(vert.x, vert.y, vert.z));
+}
+
+} // namespace
+
+TestSuite create_kernel_tests()
+{
+    TestSuite suite("Skinning Kernels");
+
+    // SoA conversion must be lossless and pad to the SIMD width
+    suite.add_test("SoA Vertex Streams Round Trip", []()
+    {
+        const std::vector<Vertex> vertices = make_test_vertices(37);
+        const VertexStreams streams = VertexStreams::from_vertices(vertices);
+
+        bool valid = streams.count == vertices.size() &&
+                     streams.padded_count() % VertexStreams::LANE_PADDING == 0 &&
+                     streams.padded_count() >= vertices.size();
+
+        // Padding lanes must be zeroed
+        for (size_t i = vertices.size(); i < streams.padded_count(); i++)
+        {
+            valid &= streams.x[i] == 0.f && streams.y[i] == 0.f && streams.z[i] == 0.f;
+        }
+
+        std::vector<Vertex> round_trip;
+        streams.to_vertices(round_trip);
+        valid &= round_trip.size() == vertices.size();
+        for (size_t i = 0; valid && i < vertices.size(); i++)
+        {
+            valid &= round_trip[i].x == vertices[i].x &&
+                     round_trip[i].y == vertices[i].y &&
+                     round_trip[i].z == vertices[i].z;
+        }
+
+        TestUtils::print_colored(valid ? "SoA round trip preserved all vertices\n" :
+                                         "SoA round trip corrupted vertex data\n",
+            valid ? TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+        return valid;
+    });
+
+    // Every kernel variant this CPU supports must agree with the one-vertex-at-a-time reference
+    suite.add_test("Linear Blend Kernels Match Reference", []()
+    {
+        const int joint_count = 9;
+        const std::vector<Vertex> vertices = make_test_vertices(101);
+        const std::vector<VertexWeights> weights = make_test_weights(vertices.size(), joint_count);
+        const std::vector<HMM_Mat4> palette = make_test_palette(joint_count);
+        const std::vector<AffineMatrix> affine_palette = make_affine_palette(palette);
+
+        const VertexStreams rest = VertexStreams::from_vertices(vertices);
+        const InfluenceStreams influences = InfluenceStreams::from_weights(weights, .0001f);
+
+        bool all_match = true;
+        for (const SkinningKernels::InstructionSet isa : ALL_INSTRUCTION_SETS)
+        {
+            if (!SkinningKernels::is_supported(isa))
+            {
+                std::cout << SkinningKernels::instruction_set_name(isa)
+                          << " kernel: not supported on this CPU, skipped" << std::endl;
+                continue;
+            }
+
+            VertexStreams skinned;
+            skinned.resize(vertices.size());
+
+            SkinningKernels::SkinningJob job =
+                SkinningKernels::make_skinning_job(rest, influences, skinned);
+            job.affine_palette = affine_palette.data();
+            SkinningKernels::select_linear_blend(SkinningKernels::get_kernels(isa), 0)(
+                job, 0, rest.padded_count());
+
+            size_t mismatches = 0;
+            for (size_t i = 0; i < vertices.size(); i++)
+            {
+                const HMM_Vec3 expected = reference_skin_vertex(vertices[i], weights[i], palette);
+                const HMM_Vec3 actual = HMM_V3(skinned.x[i], skinned.y[i], skinned.z[i]);
+                if (!TestUtils::approx_equal_vec3(expected, actual, .001f))
+                {
+                    mismatches++;
+                }
+            }
+
+            TestUtils::set_console_color(mismatches == 0 ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << SkinningKernels::instruction_set_name(isa) << " kernel: "
+                      << mismatches << " mismatching vertices out of " << vertices.size() << std::endl;
+            TestUtils::reset_console_color();
+
+            all_match &= mismatches == 0;
+        }
+
+        return all_match;
+    });
+
+    // Vertices with more than MAX_INFLUENCES influences must keep all of them
+    suite.add_test("Sparse Influences Match Reference", []()
+    {
+        const int joint_count = 9;
+        const std::vector<Vertex> vertices = make_test_vertices(101);
+        const SparseWeights weights = make_test_sparse_weights(vertices.size(), joint_count);
+        const std::vector<HMM_Mat4> palette = make_test_palette(joint_count);
+        const std::vector<AffineMatrix> affine_palette = make_affine_palette(palette);
+
+        const VertexStreams rest = VertexStreams::from_vertices(vertices);
+        const InfluenceStreams influences = InfluenceStreams::from_sparse_weights(weights, .0001f);
+
+        // Chunks must only store as many slots as their most influenced vertex
+        size_t stored_slots = 0;
+        for (size_t chunk = 0; chunk < influences.chunk_influences.size(); chunk++)
+        {
+            size_t max_influences = 0;
+            for (size_t i = chunk * InfluenceStreams::CHUNK_SIZE;
+                 i < std::min((chunk + 1) * InfluenceStreams::CHUNK_SIZE, vertices.size()); i++)
+            {
+                max_influences = std::max<size_t>(max_influences,
+                                                  weights.offsets[i + 1] - weights.offsets[i]);
+            }
+            stored_slots += influences.chunk_influences[chunk];
+            if (influences.chunk_influences[chunk] != max_influences)
+            {
+                TestUtils::print_colored("Chunk influence count does not match its vertices\n",
+                    TestUtils::ConsoleColor::Red);
+                return false;
+            }
+        }
+
+        bool all_match = stored_slots * InfluenceStreams::CHUNK_SIZE == influences.joint_ids.size();
+        for (const SkinningKernels::InstructionSet isa : ALL_INSTRUCTION_SETS)
+        {
+            if (!SkinningKernels::is_supported(isa))
+                continue;
+
+            VertexStreams skinned;
+            skinned.resize(vertices.size());
+
+            SkinningKernels::SkinningJob job =
+                SkinningKernels::make_skinning_job(rest, influences, skinned);
+            job.affine_palette = affine_palette.data();
+            SkinningKernels::select_linear_blend(SkinningKernels::get_kernels(isa), 0)(
+                job, 0, rest.padded_count());
+
+            size_t mismatches = 0;
+            for (size_t i = 0; i < vertices.size(); i++)
+            {
+                const HMM_Vec3 position = HMM_V3(vertices[i].x, vertices[i].y, vertices[i].z);
+                HMM_Vec3 expected = HMM_V3(0.f, 0.f, 0.f);
+                for (size_t entry = weights.offsets[i]; entry < weights.offsets[i + 1]; entry++)
+                {
+                    expected = HMM_AddV3(expected, HMM_MulV3F(MathFacade::transform_vec3(
+                        palette[weights.joint_ids[entry]], position), weights.weights[entry]));
+                }
+
+                const HMM_Vec3 actual = HMM_V3(skinned.x[i], skinned.y[i], skinned.z[i]);
+                if (!TestUtils::approx_equal_vec3(expected, actual, .001f))
+                {
+                    mismatches++;
+                }
+            }
+
+            TestUtils::set_console_color(mismatches == 0 ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << SkinningKernels::instruction_set_name(isa) << " sparse kernel: "
+                      << mismatches << " mismatching vertices out of " << vertices.size() << std::endl;
+            TestUtils::reset_console_color();
+
+            all_match &= mismatches == 0;
+        }
+
+        return all_match;
+    });
+
+    // Bucketing must give every chunk a single influence count and scatter results back in order
+    suite.add_test("Influence Buckets Round Trip", []()
+    {
+        const int joint_count = 9;
+        const std::vector<Vertex> vertices = make_test_vertices(101);
+        const SparseWeights weights = make_test_sparse_weights(vertices.size(), joint_count);
+        const std::vector<HMM_Mat4> palette = make_test_palette(joint_count);
+        const std::vector<AffineMatrix> affine_palette = make_affine_palette(palette);
+
+        const VertexBuckets buckets = VertexBuckets::from_sparse_weights(weights, .0001f);
+        const VertexStreams rest = VertexStreams::from_vertices(vertices, buckets);
+        const InfluenceStreams influences =
+            InfluenceStreams::from_sparse_weights(weights, .0001f, buckets);
+
+        // Each vertex appears exactly once, and chunks never mix influence counts
+        std::vector<int> seen(vertices.size(), 0);
+        for (const uint32_t source : buckets.order)
+        {
+            if (source != VertexBuckets::PADDING)
+                seen[source]++;
+        }
+        bool valid = std::all_of(seen.begin(), seen.end(), [](int n) { return n == 1; });
+
+        for (const VertexBuckets::Bucket& bucket : buckets.buckets)
+        {
+            valid &= bucket.begin % InfluenceStreams::CHUNK_SIZE == 0 &&
+                     bucket.end % InfluenceStreams::CHUNK_SIZE == 0;
+            for (size_t i = bucket.begin; i < bucket.end; i += InfluenceStreams::CHUNK_SIZE)
+            {
+                valid &= influences.chunk_influences[i / InfluenceStreams::CHUNK_SIZE] ==
+                         bucket.influence_count;
+            }
+        }
+
+        // Skinning in bucketed order and scattering back must match the identity order
+        const VertexStreams identity_rest = VertexStreams::from_vertices(vertices);
+        const InfluenceStreams identity_influences =
+            InfluenceStreams::from_sparse_weights(weights, .0001f);
+        const SkinningKernels::KernelTable& kernels =
+            SkinningKernels::get_kernels(SkinningKernels::detect_instruction_set());
+
+        VertexStreams bucketed_skinned;
+        bucketed_skinned.resize(buckets);
+        SkinningKernels::SkinningJob job =
+            SkinningKernels::make_skinning_job(rest, influences, bucketed_skinned);
+        job.affine_palette = affine_palette.data();
+        SkinningKernels::select_linear_blend(kernels, 0)(job, 0, rest.padded_count());
+
+        VertexStreams identity_skinned;
+        identity_skinned.resize(vertices.size());
+        job = SkinningKernels::make_skinning_job(identity_rest, identity_influences, identity_skinned);
+        job.affine_palette = affine_palette.data();
+        SkinningKernels::select_linear_blend(kernels, 0)(job, 0, identity_rest.padded_count());
+
+        std::vector<Vertex> bucketed_vertices;
+        std::vector<Vertex> identity_vertices;
+        bucketed_skinned.to_vertices(bucketed_vertices, buckets);
+        identity_skinned.to_vertices(identity_vertices);
+
+        valid &= bucketed_vertices.size() == vertices.size();
+        for (size_t i = 0; valid && i < vertices.size(); i++)
+        {
+            valid &= TestUtils::approx_equal_vec3(
+                HMM_V3(bucketed_vertices[i].x, bucketed_vertices[i].y, bucketed_vertices[i].z),
+                HMM_V3(identity_vertices[i].x, identity_vertices[i].y, identity_vertices[i].z));
+        }
+
+        TestUtils::set_console_color(valid ?
+            TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+        std::cout << buckets.buckets.size() << " influence buckets over "
+                  << buckets.padded_count() << " entries" << std::endl;
+        TestUtils::reset_console_color();
+
+        return valid;
+    });
+
+    // Meshlets must tile every bucket in bounded pieces whose local joint IDs map back to the rig
+    suite.add_test("Meshlet Tiling Bounds Joint Sets", []()
+    {
+        constexpr size_t CHUNK_SIZE = InfluenceStreams::CHUNK_SIZE;
+        const int joint_count = 300;
+        const SparseWeights weights = make_test_sparse_weights(2000, joint_count);
+
+        VertexBuckets buckets = VertexBuckets::from_sparse_weights(weights, .0001f);
+        const std::vector<VertexBuckets::Bucket> untiled_buckets = buckets.buckets;
+        const Meshlets meshlets = Meshlets::tile(weights, .0001f, buckets);
+
+        // Each vertex still appears exactly once, in a bucket of its influence count
+        std::vector<int> seen(weights.vertex_count(), 0);
+        for (const uint32_t source : buckets.order)
+        {
+            if (source != VertexBuckets::PADDING)
+                seen[source]++;
+        }
+        bool valid = std::all_of(seen.begin(), seen.end(), [](int n) { return n == 1; }) &&
+                     buckets.buckets.size() == untiled_buckets.size();
+
+        // Meshlets cover the buckets back to back, chunk aligned and within their bounds
+        size_t next_entry = 0;
+        size_t bucket = 0;
+        for (const Meshlets::Meshlet& meshlet : meshlets.meshlets)
+        {
+            while (bucket < buckets.buckets.size() && buckets.buckets[bucket].end <= meshlet.begin)
+                bucket++;
+
+            valid &= meshlet.begin == next_entry && meshlet.begin % CHUNK_SIZE == 0 &&
+                     meshlet.end % CHUNK_SIZE == 0 && meshlet.end > meshlet.begin &&
+                     meshlet.end - meshlet.begin <= Meshlets::MAX_VERTICES &&
+                     meshlet.joint_end - meshlet.joint_begin <= Meshlets::MAX_JOINTS &&
+                     bucket < buckets.buckets.size() && meshlet.end <= buckets.buckets[bucket].end &&
+                     meshlet.influence_count == buckets.buckets[bucket].influence_count &&
+                     meshlets.meshlet_of(meshlet.begin) == static_cast<size_t>(&meshlet - meshlets.meshlets.data());
+            next_entry = meshlet.end;
+        }
+        valid &= next_entry == buckets.padded_count();
+
+        // Local joint IDs index each meshlet's joint list
+        const InfluenceStreams global = InfluenceStreams::from_sparse_weights(weights, .0001f, buckets);
+        InfluenceStreams local = global;
+        meshlets.localize(local);
+        for (size_t chunk = 0; valid && chunk < global.chunk_offsets.size(); chunk++)
+        {
+            const Meshlets::Meshlet& meshlet = meshlets.meshlets[meshlets.chunk_meshlets[chunk]];
+            const size_t begin = global.chunk_offsets[chunk];
+            for (size_t entry = begin; entry < begin + global.chunk_influences[chunk] * CHUNK_SIZE; entry++)
+            {
+                if (global.weights[entry] == 0.f)
+                    continue;
+
+                const size_t local_id = static_cast<size_t>(local.joint_ids[entry]);
+                valid &= local_id < meshlet.joint_end - meshlet.joint_begin &&
+                         meshlets.joints[meshlet.joint_begin + local_id] ==
+                         static_cast<uint32_t>(global.joint_ids[entry]);
+            }
+        }
+
+        TestUtils::set_console_color(valid ?
+            TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+        std::cout << meshlets.meshlets.size() << " meshlets of up to " << meshlets.max_joint_count()
+                  << " joints over " << buckets.padded_count() << " entries" << std::endl;
+        TestUtils::reset_console_color();
+
+        return valid;
+    });
+
+    // Unrolled kernels must match the generic loop, and projective palettes must drop w like MathFacade
+    // once packed as 3x4 matrices
+    suite.add_test("Specialized Kernels Match Reference", []()
+    {
+        const int joint_count = 9;
+        const std::vector<Vertex> vertices = make_test_vertices(101);
+        const SparseWeights weights = make_test_sparse_weights(vertices.size(), joint_count);
+
+        // A perspective term in the bottom row makes the palette projective
+        const std::vector<HMM_Mat4> affine_palette = make_test_palette(joint_count);
+        std::vector<HMM_Mat4> projective_palette = affine_palette;
+        for (int joint_id = 0; joint_id < joint_count; joint_id++)
+        {
+            projective_palette[joint_id].Elements[0][3] = .01f * joint_id;
+            projective_palette[joint_id].Elements[3][3] = 1.f + .05f * joint_id;
+        }
+
+        bool valid = true;
+
+        const VertexBuckets buckets = VertexBuckets::from_sparse_weights(weights, .0001f);
+        const VertexStreams rest = VertexStreams::from_vertices(vertices, buckets);
+        const InfluenceStreams influences =
+            InfluenceStreams::from_sparse_weights(weights, .0001f, buckets);
+
+        for (const SkinningKernels::InstructionSet isa : ALL_INSTRUCTION_SETS)
+        {
+            if (!SkinningKernels::is_supported(isa))
+                continue;
+
+            const SkinningKernels::KernelTable& kernels = SkinningKernels::get_kernels(isa);
+            size_t mismatches = 0;
+
+            for (const std::vector<HMM_Mat4>& palette : { affine_palette, projective_palette })
+            {
+                const std::vector<AffineMatrix> packed_palette = make_affine_palette(palette);
+
+                // Run each bucket through its specialized kernel, and the whole mesh generically
+                VertexStreams specialized;
+                VertexStreams generic;
+                specialized.resize(buckets);
+                generic.resize(buckets);
+
+                SkinningKernels::SkinningJob job =
+                    SkinningKernels::make_skinning_job(rest, influences, specialized);
+                job.affine_palette = packed_palette.data();
+                for (const VertexBuckets::Bucket& bucket : buckets.buckets)
+                {
+                    SkinningKernels::select_linear_blend(kernels, bucket.influence_count)(
+                        job, bucket.begin, bucket.end);
+                }
+
+                job = SkinningKernels::make_skinning_job(rest, influences, generic);
+                job.affine_palette = packed_palette.data();
+                SkinningKernels::select_linear_blend(kernels, 0)(job, 0, rest.padded_count());
+
+                std::vector<Vertex> specialized_vertices;
+                std::vector<Vertex> generic_vertices;
+                specialized.to_vertices(specialized_vertices, buckets);
+                generic.to_vertices(generic_vertices, buckets);
+
+                for (size_t i = 0; i < vertices.size(); i++)
+                {
+                    // Reference: blend M * (p, 1) and keep xyz, as MathFacade::transform_vec3 does
+                    const HMM_Vec4 position = HMM_V4(vertices[i].x, vertices[i].y, vertices[i].z, 1.f);
+                    HMM_Vec4 blended = HMM_V4(0.f, 0.f, 0.f, 0.f);
+                    for (uint32_t k = weights.offsets[i]; k < weights.offsets[i + 1]; k++)
+                    {
+                        if (weights.weights[k] < .0001f)
+                            continue;
+                        blended = HMM_AddV4(blended, HMM_MulV4F(
+                            HMM_MulM4V4(palette[weights.joint_ids[k]], position), weights.weights[k]));
+                    }
+                    const HMM_Vec3 expected = blended.XYZ;
+
+                    const HMM_Vec3 actual = HMM_V3(specialized_vertices[i].x,
+                                                   specialized_vertices[i].y,
+                                                   specialized_vertices[i].z);
+                    const HMM_Vec3 fallback = HMM_V3(generic_vertices[i].x,
+                                                     generic_vertices[i].y,
+                                                     generic_vertices[i].z);
+                    if (!TestUtils::approx_equal_vec3(expected, actual, .001f) ||
+                        !TestUtils::approx_equal_vec3(actual, fallback, .0001f))
+                    {
+                        mismatches++;
+                    }
+                }
+            }
+
+            TestUtils::set_console_color(mismatches == 0 ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << SkinningKernels::instruction_set_name(isa) << " kernels: "
+                      << mismatches << " mismatching vertices over both palettes" << std::endl;
+            TestUtils::reset_console_color();
+
+            valid &= mismatches == 0;
+        }
+
+        return valid;
+    });
+
+    // A rigid matrix and its dual quaternion must move points identically
+    suite.add_test("Dual Quaternion Conversion", []()
+    {
+        const std::vector<HMM_Mat4> palette = make_test_palette(9);
+        const std::vector<Vertex> vertices = make_test_vertices(16);
+
+        bool valid = true;
+        for (const HMM_Mat4& matrix : palette)
+        {
+            const DualQuaternion dual_quat = MathFacade::to_dual_quaternion(matrix);
+            for (const Vertex& vert : vertices)
+            {
+                const HMM_Vec3 point = HMM_V3(vert.x, vert.y, vert.z);
+                valid &= TestUtils::approx_equal_vec3(MathFacade::transform_vec3(matrix, point),
+                                                      MathFacade::transform_vec3(dual_quat, point),
+                                                      .001f);
+            }
+        }
+
+        TestUtils::print_colored(valid ? "Dual quaternions reproduce the rigid matrices\n" :
+                                         "Dual quaternion conversion is incorrect\n",
+            valid ? TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+        return valid;
+    });
+
+    // Every dual quaternion kernel variant must agree with the scalar reference
+    suite.add_test("Dual Quaternion Kernels Match Reference", []()
+    {
+        const int joint_count = 9;
+        const std::vector<Vertex> vertices = make_test_vertices(101);
+        const std::vector<VertexWeights> weights = make_test_weights(vertices.size(), joint_count);
+        const std::vector<HMM_Mat4> matrices = make_test_palette(joint_count);
+
+        std::vector<DualQuaternion> palette(joint_count);
+        for (int joint_id = 0; joint_id < joint_count; joint_id++)
+        {
+            palette[joint_id] = MathFacade::to_dual_quaternion(matrices[joint_id]);
+        }
+
+        const VertexStreams rest = VertexStreams::from_vertices(vertices);
+        const InfluenceStreams influences = InfluenceStreams::from_weights(weights, .0001f);
+
+        bool all_match = true;
+        for (const SkinningKernels::InstructionSet isa : ALL_INSTRUCTION_SETS)
+        {
+            if (!SkinningKernels::is_supported(isa))
+                continue;
+
+            VertexStreams skinned;
+            skinned.resize(vertices.size());
+
+            SkinningKernels::SkinningJob job =
+                SkinningKernels::make_skinning_job(rest, influences, skinned);
+            job.dual_quaternion_palette = palette.data();
+            SkinningKernels::select_dual_quaternion(SkinningKernels::get_kernels(isa), 0)(
+                job, 0, rest.padded_count());
+
+            size_t mismatches = 0;
+            for (size_t i = 0; i < vertices.size(); i++)
+            {
+                const HMM_Vec3 expected =
+                    reference_dual_quaternion_skin_vertex(vertices[i], weights[i], palette);
+                const HMM_Vec3 actual = HMM_V3(skinned.x[i], skinned.y[i], skinned.z[i]);
+                if (!TestUtils::approx_equal_vec3(expected, actual, .001f))
+                {
+                    mismatches++;
+                }
+            }
+
+            TestUtils::set_console_color(mismatches == 0 ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << SkinningKernels::instruction_set_name(isa) << " DQS kernel: "
+                      << mismatches << " mismatching vertices out of " << vertices.size() << std::endl;
+            TestUtils::reset_console_color();
+
+            all_match &= mismatches == 0;
+        }
+
+        return all_match;
+    });
+
+    // Blending a 180 degree twist must not collapse the vertex onto the axis (candy wrapper)
+    suite.add_test("Dual Quaternion Preserves Volume Under Twist", []()
+    {
+        const std::vector<HMM_Mat4> matrices = {
+            MathFacade::create_identity(),
+            MathFacade::rotateX(MathFacade::to_radians(179.f))
+        };
+        const std::vector<DualQuaternion> palette = {
+            MathFacade::to_dual_quaternion(matrices[0]),
+            MathFacade::to_dual_quaternion(matrices[1])
+        };
+
+        // A vertex one unit away from the twist axis, weighted half/half
+        const std::vector<Vertex> vertices = { { 0.f, 1.f, 0.f } };
+        VertexWeights weight = { { 0, 1, 0, 0 }, { .5f, .5f, 0.f, 0.f } };
+        const std::vector<VertexWeights> weights = { weight };
+
+        const VertexStreams rest = VertexStreams::from_vertices(vertices);
+        const InfluenceStreams influences = InfluenceStreams::from_weights(weights, .0001f);
+        VertexStreams linear_blend;
+        linear_blend.resize(1);
+        VertexStreams dual_quaternion;
+        dual_quaternion.resize(1);
+
+        const SkinningKernels::KernelTable& kernels =
+            SkinningKernels::get_kernels(SkinningKernels::detect_instruction_set());
+
+        SkinningKernels::SkinningJob job =
+            SkinningKernels::make_skinning_job(rest, influences, linear_blend);
+        const std::vector<AffineMatrix> affine_matrices = make_affine_palette(matrices);
+        job.affine_palette = affine_matrices.data();
+        SkinningKernels::select_linear_blend(kernels, 0)(job, 0, rest.padded_count());
+
+        job = SkinningKernels::make_skinning_job(rest, influences, dual_quaternion);
+        job.dual_quaternion_palette = palette.data();
+        SkinningKernels::select_dual_quaternion(kernels, 0)(job, 0, rest.padded_count());
+
+        const float lbs_radius = HMM_LenV3(HMM_V3(0.f, linear_blend.y[0], linear_blend.z[0]));
+        const float dqs_radius = HMM_LenV3(HMM_V3(0.f, dual_quaternion.y[0], dual_quaternion.z[0]));
+
+        const bool valid = TestUtils::approx_equal(dqs_radius, 1.f, .001f) && lbs_radius < .1f;
+
+        TestUtils::set_console_color(valid ?
+            TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+        std::cout << "Distance from twist axis: LBS " << lbs_radius
+                  << ", DQS " << dqs_radius << " (expected 1)" << std::endl;
+        TestUtils::reset_console_color();
+
+        return valid;
+    });
+
+    // Palette multiplication must match MathFacade::multiply for every variant
+    suite.add_test("Matrix Multiply Kernels Match Reference", []()
+    {
+        const std::vector<HMM_Mat4> lhs = make_test_palette(11);
+        std::vector<HMM_Mat4> rhs = make_test_palette(11);
+        for (auto& matrix : rhs)
+        {
+            matrix = MathFacade::inverse(MathFacade::multiply(matrix, MathFacade::scale(1.f, 2.f, .5f)));
+        }
+
+        bool all_match = true;
+        for (const SkinningKernels::InstructionSet isa : ALL_INSTRUCTION_SETS)
+        {
+            if (!SkinningKernels::is_supported(isa))
+                continue;
+
+            std::vector<HMM_Mat4> result(lhs.size());
+            SkinningKernels::get_kernels(isa).multiply_matrices(
+                lhs.data(), rhs.data(), result.data(), lhs.size());
+
+            bool match = true;
+            for (size_t m = 0; m < lhs.size(); m++)
+            {
+                match &= TestUtils::approx_equal_mat4(
+                    result[m], MathFacade::multiply(lhs[m], rhs[m]), .0001f);
+            }
+
+            TestUtils::set_console_color(match ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << SkinningKernels::instruction_set_name(isa) << " matrix multiply: "
+                      << (match ? "Correct" : "Incorrect") << std::endl;
+            TestUtils::reset_console_color();
+
+            all_match &= match;
+        }
+
+        return all_match;
+    });
+
+    // Compact encodings must keep every weight within one unorm step, keep each vertex's
+    // weights summing to 1, and skin exactly like float streams holding the decoded weights
+    suite.add_test("Quantized Influence Kernels Match Decoded Weights", []()
+    {
+        const int joint_count = 9;
+        const std::vector<Vertex> vertices = make_test_vertices(101);
+        const SparseWeights weights = make_test_sparse_weights(vertices.size(), joint_count);
+        const std::vector<HMM_Mat4> palette = make_test_palette(joint_count);
+        const std::vector<AffineMatrix> affine_palette = make_affine_palette(palette);
+        std::vector<DualQuaternion> dual_quaternion_palette(palette.size());
+        for (size_t joint_id = 0; joint_id < palette.size(); joint_id++)
+        {
+            dual_quaternion_palette[joint_id] = MathFacade::to_dual_quaternion(palette[joint_id]);
+        }
+
+        const VertexStreams rest = VertexStreams::from_vertices(vertices);
+        const InfluenceStreams influences = InfluenceStreams::from_sparse_weights(weights, .0001f);
+
+        // The narrowest joint IDs that fit the rig are picked
+        bool all_match =
+            InfluenceStreams::select_encoding(WeightPrecision::Unorm8, 256) == InfluenceEncoding::Joint8Unorm8 &&
+            InfluenceStreams::select_encoding(WeightPrecision::Unorm16, 257) == InfluenceEncoding::Joint16Unorm16 &&
+            InfluenceStreams::select_encoding(WeightPrecision::Float32, 1) == InfluenceEncoding::Float32 &&
+            InfluenceStreams::bytes_per_influence(InfluenceEncoding::Joint8Unorm8) == 2;
+
+        for (const InfluenceEncoding encoding : { InfluenceEncoding::Joint16Unorm16,
+                                                  InfluenceEncoding::Joint16Unorm8,
+                                                  InfluenceEncoding::Joint8Unorm16,
+                                                  InfluenceEncoding::Joint8Unorm8 })
+        {
+            const InfluenceStreams encoded = influences.encode(encoding);
+            const bool unorm8 = encoding == InfluenceEncoding::Joint16Unorm8 ||
+                                encoding == InfluenceEncoding::Joint8Unorm8;
+            const float step = unorm8 ? InfluenceStreams::UNORM8_SCALE : InfluenceStreams::UNORM16_SCALE;
+
+            // Float streams holding the decoded weights, to skin against
+            InfluenceStreams decoded = influences;
+            bool weights_valid = encoded.entry_count() == influences.entry_count();
+            for (size_t entry = 0; weights_valid && entry < influences.entry_count(); entry++)
+            {
+                decoded.weights[entry] = encoded.weight(entry);
+                weights_valid &= encoded.joint_id(entry) == influences.joint_ids[entry] &&
+                                 std::abs(encoded.weight(entry) - influences.weights[entry]) <= step;
+            }
+            for (size_t i = 0; weights_valid && i < vertices.size(); i++)
+            {
+                const size_t chunk = i / InfluenceStreams::CHUNK_SIZE;
+                const size_t base = encoded.chunk_offsets[chunk] + i % InfluenceStreams::CHUNK_SIZE;
+                float sum = 0.f;
+                for (size_t slot = 0; slot < encoded.chunk_influences[chunk]; slot++)
+                {
+                    sum += encoded.weight(base + slot * InfluenceStreams::CHUNK_SIZE);
+                }
+                weights_valid &= std::abs(sum - 1.f) < .00001f;
+            }
+            all_match &= weights_valid;
+
+            for (const SkinningKernels::InstructionSet isa : ALL_INSTRUCTION_SETS)
+            {
+                if (!SkinningKernels::is_supported(isa))
+                    continue;
+
+                const SkinningKernels::KernelTable& kernels = SkinningKernels::get_kernels(isa);
+                size_t mismatches = 0;
+                for (const bool dual_quaternion : { false, true })
+                {
+                    VertexStreams expected;
+                    VertexStreams actual;
+                    expected.resize(vertices.size());
+                    actual.resize(vertices.size());
+
+                    SkinningKernels::SkinningJob reference_job =
+                        SkinningKernels::make_skinning_job(rest, decoded, expected);
+                    SkinningKernels::SkinningJob encoded_job =
+                        SkinningKernels::make_skinning_job(rest, encoded, actual);
+                    for (SkinningKernels::SkinningJob* job : { &reference_job, &encoded_job })
+                    {
+                        job->affine_palette = affine_palette.data();
+                        job->dual_quaternion_palette = dual_quaternion_palette.data();
+                    }
+
+                    if (dual_quaternion)
+                    {
+                        SkinningKernels::select_dual_quaternion(kernels, 0)(
+                            reference_job, 0, rest.padded_count());
+                        SkinningKernels::select_dual_quaternion(kernels, 0, encoding)(
+                            encoded_job, 0, rest.padded_count());
+                    }
+                    else
+                    {
+                        SkinningKernels::select_linear_blend(kernels, 0)(
+                            reference_job, 0, rest.padded_count());
+                        SkinningKernels::select_linear_blend(kernels, 0, encoding)(
+                            encoded_job, 0, rest.padded_count());
+                    }
+
+                    for (size_t i = 0; i < vertices.size(); i++)
+                    {
+                        if (!TestUtils::approx_equal_vec3(
+                                HMM_V3(expected.x[i], expected.y[i], expected.z[i]),
+                                HMM_V3(actual.x[i], actual.y[i], actual.z[i]), .00001f))
+                        {
+                            mismatches++;
+                        }
+                    }
+                }
+
+                all_match &= mismatches == 0;
+                if (mismatches != 0)
+                {
+                    TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+                    std::cout << SkinningKernels::instruction_set_name(isa) << " encoding "
+                              << static_cast<int>(encoding) << ": " << mismatches
+                              << " mismatching vertices" << std::endl;
+                    TestUtils::reset_console_color();
+                }
+            }
+        }
+
+        // Joint IDs beyond the narrow range are rejected rather than wrapped
+        bool rejected = false;
+        try
+        {
+            InfluenceStreams wide = influences;
+            wide.joint_ids[0] = 300;
+            wide.encode(InfluenceEncoding::Joint8Unorm8);
+        }
+        catch (const std::invalid_argument&)
+        {
+            rejected = true;
+        }
+        all_match &= rejected;
+
+        TestUtils::set_console_color(all_match ?
+            TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+        std::cout << "Quantized influences: " << (all_match ? "Correct" : "Incorrect") << std::endl;
+        TestUtils::reset_console_color();
+
+        return all_match;
+    });
+
+    // The detected variant must be usable, and unsupported ones must be rejected
+    suite.add_test("Instruction Set Dispatch", []()
+    {
+        const SkinningKernels::InstructionSet detected = SkinningKernels::detect_instruction_set();
+
+        bool valid = SkinningKernels::is_supported(detected) &&
+                     SkinningKernels::get_kernels(detected).instruction_set == detected;
+
+        // The skinner can be forced down to scalar and back
+        MeshSkinner skinner;
+        valid &= skinner.set_instruction_set(SkinningKernels::InstructionSet::Scalar);
+        valid &= skinner.get_instruction_set() == SkinningKernels::InstructionSet::Scalar;
+        valid &= skinner.set_instruction_set(detected);
+
+        SkinningKernels::InstructionSet parsed;
+        valid &= SkinningKernels::parse_instruction_set("AVX-512", parsed) &&
+                 parsed == SkinningKernels::InstructionSet::AVX512;
+        valid &= !SkinningKernels::parse_instruction_set("neon", parsed);
+
+        TestUtils::set_console_color(valid ?
+            TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+        std::cout << "Detected instruction set: "
+                  << SkinningKernels::instruction_set_name(detected) << std::endl;
+        TestUtils::reset_console_color();
+
+        return valid;
+    });
+
+    return suite;
+}
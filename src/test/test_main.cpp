@@ -11,6 +11,8 @@
 TestSuite create_mesh_tests();
 TestSuite create_skinning_data_tests();
 TestSuite create_skinner_tests();
+TestSuite create_kernel_tests();
+TestSuite create_thread_pool_tests();
 
 int main() 
 {
@@ -24,7 +26,9 @@ int main()
     std::vector<TestSuite> test_suites = {
         create_mesh_tests(),
         create_skinning_data_tests(),
-        create_skinner_tests()
+        create_skinner_tests(),
+        create_kernel_tests(),
+        create_thread_pool_tests()
     };
     
     int failed_suites = 0;
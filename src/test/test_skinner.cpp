@@ -1,11 +1,23 @@
 // Standard library imports
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <future>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
 
 // Local application imports
+#include "facade/json_facade.h"
+#include "facade/math_facade.h"
 #include "facade/obj_facade.h"
 #include "mesh_skinner.h"
 #include "model/mesh.h"
+#include "model/pose_track.h"
+#include "model/skinning_data.h"
 #include "test/test_framework.h"
 #include "test/test_utils.h"
 
@@ -362,5 +374,1495 @@ TestSuite create_skinner_tests()
         }
     });
     
+    // Batch skinning must reproduce the single-pose path for every pose
+    suite.add_test("Batch Skinning Matches Single Pose", []()
+    {
+        try
+        {
+            MeshSkinner skinner;
+
+            const bool loaded = skinner.load_mesh("asset/input_mesh.obj") &&
+                                skinner.load_weights("asset/bone_weights.json") &&
+                                skinner.load_inverse_bind_matrices("asset/inverse_bind_pose.json") &&
+                                skinner.load_output_pose_matrices("asset/output_pose.json");
+            if (!loaded || !skinner.perform_skinning())
+            {
+                TestUtils::print_colored("Failed to skin the reference pose\n",
+                    TestUtils::ConsoleColor::Red);
+                return false;
+            }
+
+            const std::vector<HMM_Mat4> pose_matrices = SkinningData::parse_matrices_from_json(
+                JsonFacade::load_from_file("asset/output_pose.json"));
+
+            // Pose k is the reference pose rotated about Y; since skinning is linear in the
+            // palette, its result is the reference result under the same rotation. Use more
+            // poses than one pose group to cover the tiling.
+            const size_t pose_count = 20;
+            std::vector<HMM_Mat4> rotations(pose_count);
+            std::vector<std::vector<HMM_Mat4>> pose_palettes(pose_count);
+            for (size_t pose = 0; pose < pose_count; pose++)
+            {
+                rotations[pose] = MathFacade::rotateY(MathFacade::to_radians(10.f * pose));
+                for (const HMM_Mat4& matrix : pose_matrices)
+                {
+                    pose_palettes[pose].push_back(MathFacade::multiply(rotations[pose], matrix));
+                }
+            }
+
+            if (!skinner.perform_batch_skinning(pose_palettes) ||
+                skinner.get_batch_size() != pose_count)
+            {
+                TestUtils::print_colored("Batch skinning failed\n", TestUtils::ConsoleColor::Red);
+                return false;
+            }
+
+            const std::vector<Vertex>& reference = skinner.get_skinned_mesh().vertices;
+            size_t mismatches = 0;
+            std::vector<Vertex> vertices;
+            for (size_t pose = 0; pose < pose_count; pose++)
+            {
+                skinner.get_batch_vertices(pose, vertices);
+                for (size_t i = 0; i < reference.size(); i++)
+                {
+                    const HMM_Vec3 expected = MathFacade::transform_vec3(rotations[pose],
+                        HMM_V3(reference[i].x, reference[i].y, reference[i].z));
+                    const HMM_Vec3 actual = HMM_V3(vertices[i].x, vertices[i].y, vertices[i].z);
+                    if (!TestUtils::approx_equal_vec3(expected, actual, .001f))
+                    {
+                        mismatches++;
+                    }
+                }
+            }
+
+            TestUtils::set_console_color(mismatches == 0 ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << mismatches << " mismatching vertices across " << pose_count
+                      << " poses" << std::endl;
+            TestUtils::reset_console_color();
+
+            return mismatches == 0;
+        }
+        catch (const std::exception& e)
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Batch skinning test failed with exception: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+            return false;
+        }
+    });
+    
+    // Editing one joint must re-skin only its vertices, with the same result as a full pass
+    suite.add_test("Incremental Skinning Matches Full Skinning", []()
+    {
+        try
+        {
+            MeshSkinner incremental;
+            MeshSkinner full;
+
+            const bool loaded = incremental.load_mesh("asset/input_mesh.obj") &&
+                                incremental.load_weights("asset/bone_weights.json") &&
+                                incremental.load_inverse_bind_matrices("asset/inverse_bind_pose.json") &&
+                                incremental.load_output_pose_matrices("asset/output_pose.json") &&
+                                full.load_mesh("asset/input_mesh.obj") &&
+                                full.load_weights("asset/bone_weights.json") &&
+                                full.load_inverse_bind_matrices("asset/inverse_bind_pose.json");
+            if (!loaded || !incremental.perform_skinning())
+            {
+                TestUtils::print_colored("Failed to skin the reference pose\n",
+                    TestUtils::ConsoleColor::Red);
+                return false;
+            }
+
+            // Bend a single joint, as an animator tweaking one finger would
+            std::vector<HMM_Mat4> pose_matrices = SkinningData::parse_matrices_from_json(
+                JsonFacade::load_from_file("asset/output_pose.json"));
+            const size_t edited_joint = pose_matrices.size() / 2;
+            pose_matrices[edited_joint] = MathFacade::multiply(
+                pose_matrices[edited_joint], MathFacade::rotateZ(MathFacade::to_radians(30.f)));
+
+            incremental.set_output_pose_matrices(pose_matrices);
+            full.set_output_pose_matrices(pose_matrices);
+            if (!incremental.perform_skinning() || !full.perform_skinning())
+            {
+                TestUtils::print_colored("Failed to skin the edited pose\n",
+                    TestUtils::ConsoleColor::Red);
+                return false;
+            }
+
+            const std::vector<Vertex>& expected = full.get_skinned_mesh().vertices;
+            const std::vector<Vertex>& actual = incremental.get_skinned_mesh().vertices;
+            size_t mismatches = expected.size() == actual.size() ? 0 : expected.size();
+            for (size_t i = 0; mismatches == 0 && i < expected.size(); i++)
+            {
+                if (!TestUtils::approx_equal_vec3(HMM_V3(expected[i].x, expected[i].y, expected[i].z),
+                                                  HMM_V3(actual[i].x, actual[i].y, actual[i].z)))
+                {
+                    mismatches++;
+                }
+            }
+
+            TestUtils::set_console_color(mismatches == 0 ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << mismatches << " vertices differ from a full re-skin" << std::endl;
+            TestUtils::reset_console_color();
+
+            return mismatches == 0;
+        }
+        catch (const std::exception& e)
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Incremental skinning test failed with exception: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+            return false;
+        }
+    });
+
+    // Skinning into an interleaved caller buffer must match the skinned mesh and skip the gaps
+    suite.add_test("Skinning Into Caller Buffer", []()
+    {
+        try
+        {
+            MeshSkinner skinner;
+            const bool loaded = skinner.load_mesh("asset/input_mesh.obj") &&
+                                skinner.load_weights("asset/bone_weights.json") &&
+                                skinner.load_inverse_bind_matrices("asset/inverse_bind_pose.json") &&
+                                skinner.load_output_pose_matrices("asset/output_pose.json");
+            if (!loaded)
+            {
+                TestUtils::print_colored("Failed to load the skinning data\n",
+                    TestUtils::ConsoleColor::Red);
+                return false;
+            }
+
+            // Position followed by a (sentinel) normal, as in an interleaved vertex buffer
+            constexpr size_t FLOATS_PER_VERTEX = 6;
+            constexpr float SENTINEL = -12345.f;
+            const size_t vertex_count = skinner.get_skinned_mesh().vertices.size();
+            std::vector<float> interleaved(vertex_count * FLOATS_PER_VERTEX, SENTINEL);
+
+            PositionBuffer output;
+            output.data = interleaved.data();
+            output.vertex_count = vertex_count;
+            output.stride = FLOATS_PER_VERTEX * sizeof(float);
+
+            // Too small a buffer is rejected instead of overrun
+            PositionBuffer truncated = output;
+            truncated.vertex_count = vertex_count - 1;
+            bool valid = !skinner.perform_skinning(truncated);
+
+            // The second call re-skins incrementally into the same buffer
+            std::vector<HMM_Mat4> pose_matrices = SkinningData::parse_matrices_from_json(
+                JsonFacade::load_from_file("asset/output_pose.json"));
+            valid &= skinner.perform_skinning(output);
+            pose_matrices[0] = MathFacade::multiply(pose_matrices[0],
+                MathFacade::rotateZ(MathFacade::to_radians(15.f)));
+            skinner.set_output_pose_matrices(pose_matrices);
+            valid &= skinner.perform_skinning(output) && skinner.perform_skinning();
+
+            size_t mismatches = 0;
+            const std::vector<Vertex>& expected = skinner.get_skinned_mesh().vertices;
+            for (size_t i = 0; valid && i < vertex_count; i++)
+            {
+                const float* vertex = &interleaved[i * FLOATS_PER_VERTEX];
+                if (!TestUtils::approx_equal_vec3(HMM_V3(expected[i].x, expected[i].y, expected[i].z),
+                                                  HMM_V3(vertex[0], vertex[1], vertex[2])) ||
+                    vertex[3] != SENTINEL || vertex[4] != SENTINEL || vertex[5] != SENTINEL)
+                {
+                    mismatches++;
+                }
+            }
+            valid &= mismatches == 0;
+
+            TestUtils::set_console_color(valid ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << mismatches << " interleaved vertices differ from the skinned mesh" << std::endl;
+            TestUtils::reset_console_color();
+
+            return valid;
+        }
+        catch (const std::exception& e)
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Caller buffer test failed with exception: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+            return false;
+        }
+    });
+
+    // The fused bounds must match a separate pass over the skinned mesh, across incremental frames
+    suite.add_test("Skinning Reports Fused Bounds", []()
+    {
+        try
+        {
+            MeshSkinner skinner;
+            skinner.set_bounds_tracking(true);
+            const bool loaded = skinner.load_mesh("asset/input_mesh.obj") &&
+                                skinner.load_weights("asset/bone_weights.json") &&
+                                skinner.load_inverse_bind_matrices("asset/inverse_bind_pose.json") &&
+                                skinner.load_output_pose_matrices("asset/output_pose.json");
+            if (!loaded)
+            {
+                TestUtils::print_colored("Failed to load the skinning data\n",
+                    TestUtils::ConsoleColor::Red);
+                return false;
+            }
+
+            std::vector<HMM_Mat4> pose_matrices = SkinningData::parse_matrices_from_json(
+                JsonFacade::load_from_file("asset/output_pose.json"));
+            bool valid = true;
+            float worst_overshoot = 0.f;
+            for (int frame = 0; frame < 2 && valid; frame++)
+            {
+                if (frame > 0)
+                {
+                    pose_matrices[2] = MathFacade::multiply(pose_matrices[2],
+                        MathFacade::rotateZ(MathFacade::to_radians(40.f)));
+                    skinner.set_output_pose_matrices(pose_matrices);
+                }
+                valid &= skinner.perform_skinning();
+
+                std::vector<HMM_Vec3> positions;
+                for (const Vertex& vertex : skinner.get_skinned_mesh().vertices)
+                {
+                    positions.push_back(HMM_V3(vertex.x, vertex.y, vertex.z));
+                }
+                const auto [min_bounds, max_bounds] = TestUtils::calculate_mesh_bounds(positions);
+                const PositionBounds& box = skinner.get_skinned_box();
+                valid &= TestUtils::approx_equal_vec3(min_bounds, HMM_V3(box.min[0], box.min[1], box.min[2])) &&
+                         TestUtils::approx_equal_vec3(max_bounds, HMM_V3(box.max[0], box.max[1], box.max[2]));
+
+                // Every vertex lies in the sphere, which is no looser than the box's own sphere
+                const BoundingSphere& sphere = skinner.get_skinned_sphere();
+                const HMM_Vec3 center = HMM_V3(sphere.center[0], sphere.center[1], sphere.center[2]);
+                for (const HMM_Vec3& position : positions)
+                {
+                    worst_overshoot = std::max(worst_overshoot,
+                                               HMM_LenV3(HMM_SubV3(position, center)) - sphere.radius);
+                }
+                valid &= sphere.radius <= HMM_LenV3(HMM_SubV3(max_bounds, min_bounds)) * .5f + .0001f;
+            }
+            valid &= worst_overshoot <= .0001f;
+
+            TestUtils::set_console_color(valid ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << std::defaultfloat << "Bounds match; sphere of radius "
+                      << skinner.get_skinned_sphere().radius << " holds every vertex" << std::endl;
+            TestUtils::reset_console_color();
+
+            return valid;
+        }
+        catch (const std::exception& e)
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Fused bounds test failed with exception: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+            return false;
+        }
+    });
+
+    // Bounds from the palette alone must contain every skinned vertex, wherever the instance stands
+    suite.add_test("Pose Bounds Contain Skinned Mesh", []()
+    {
+        try
+        {
+            MeshSkinner skinner;
+            const bool loaded = skinner.load_mesh("asset/input_mesh.obj") &&
+                                skinner.load_weights("asset/bone_weights.json") &&
+                                skinner.load_inverse_bind_matrices("asset/inverse_bind_pose.json");
+            if (!loaded)
+            {
+                TestUtils::print_colored("Failed to load the skinning data\n",
+                    TestUtils::ConsoleColor::Red);
+                return false;
+            }
+
+            const std::vector<HMM_Mat4> rest_pose = SkinningData::parse_matrices_from_json(
+                JsonFacade::load_from_file("asset/output_pose.json"));
+
+            bool valid = true;
+            size_t outside = 0;
+            float worst_slack = 0.f;
+            for (int pose_index = 0; pose_index < 4 && valid; pose_index++)
+            {
+                // Bend a few joints and place the instance with a rotation, scale and offset
+                std::vector<HMM_Mat4> pose_matrices = rest_pose;
+                for (size_t joint = 0; joint < pose_matrices.size(); joint += 3)
+                {
+                    pose_matrices[joint] = MathFacade::multiply(pose_matrices[joint],
+                        MathFacade::rotateX(MathFacade::to_radians(25.f * (pose_index + 1))));
+                }
+
+                // The last pose is projective, whose bottom row the kernels ignore
+                if (pose_index == 3)
+                {
+                    for (size_t joint = 1; joint < pose_matrices.size(); joint += 2)
+                    {
+                        pose_matrices[joint].Elements[0][3] = .02f;
+                        pose_matrices[joint].Elements[3][3] = 1.5f;
+                    }
+                }
+                const HMM_Mat4 world_transform = MathFacade::multiply(
+                    HMM_Translate(HMM_V3(4.f * pose_index, -1.f, 2.f)),
+                    MathFacade::multiply(MathFacade::rotateY(MathFacade::to_radians(50.f * pose_index)),
+                                         HMM_Scale(HMM_V3(1.f + pose_index, 1.f, 1.f))));
+
+                PositionBounds bounds;
+                valid &= skinner.compute_pose_bounds(pose_matrices, world_transform, bounds);
+
+                std::vector<HMM_Mat4> placed_pose = pose_matrices;
+                for (HMM_Mat4& matrix : placed_pose)
+                {
+                    matrix = MathFacade::multiply(world_transform, matrix);
+                }
+                skinner.set_output_pose_matrices(placed_pose);
+                valid &= skinner.perform_skinning();
+
+                std::vector<HMM_Vec3> positions;
+                for (const Vertex& vertex : skinner.get_skinned_mesh().vertices)
+                {
+                    positions.push_back(HMM_V3(vertex.x, vertex.y, vertex.z));
+                    const float position[3] = { vertex.x, vertex.y, vertex.z };
+                    for (int axis = 0; axis < 3; axis++)
+                    {
+                        if (position[axis] < bounds.min[axis] - .0001f ||
+                            position[axis] > bounds.max[axis] + .0001f)
+                            outside++;
+                    }
+                }
+
+                // Record how much larger than the real box the estimate is
+                const auto [min_bounds, max_bounds] = TestUtils::calculate_mesh_bounds(positions);
+                worst_slack = std::max({ worst_slack, min_bounds.X - bounds.min[0],
+                                         min_bounds.Y - bounds.min[1], min_bounds.Z - bounds.min[2],
+                                         bounds.max[0] - max_bounds.X, bounds.max[1] - max_bounds.Y,
+                                         bounds.max[2] - max_bounds.Z });
+            }
+            valid &= outside == 0;
+
+            TestUtils::set_console_color(valid ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << std::defaultfloat << outside << " coordinates outside the pose bounds (at most "
+                      << worst_slack << " of slack)" << std::endl;
+            TestUtils::reset_console_color();
+
+            return valid;
+        }
+        catch (const std::exception& e)
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Pose bounds test failed with exception: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+            return false;
+        }
+    });
+
+    // Meshlet tiling must reproduce the untiled positions, in order, for every skinning path
+    suite.add_test("Meshlet Tiling Matches Default Skinning", []()
+    {
+        try
+        {
+            MeshSkinner reference;
+            MeshSkinner tiled;
+            tiled.set_meshlet_tiling(true);
+            for (MeshSkinner* skinner : { &reference, &tiled })
+            {
+                if (!skinner->load_mesh("asset/input_mesh.obj") ||
+                    !skinner->load_weights("asset/bone_weights.json") ||
+                    !skinner->load_inverse_bind_matrices("asset/inverse_bind_pose.json") ||
+                    !skinner->load_output_pose_matrices("asset/output_pose.json"))
+                {
+                    TestUtils::print_colored("Failed to load the skinning data\n",
+                        TestUtils::ConsoleColor::Red);
+                    return false;
+                }
+            }
+
+            // A full frame, an incremental one, then the same two with dual quaternions
+            std::vector<HMM_Mat4> pose_matrices = SkinningData::parse_matrices_from_json(
+                JsonFacade::load_from_file("asset/output_pose.json"));
+            bool valid = tiled.get_meshlet_count() > 0;
+            size_t mismatches = 0;
+            for (int frame = 0; frame < 4 && valid; frame++)
+            {
+                if (frame == 2)
+                {
+                    reference.set_skinning_method(SkinningMethod::DualQuaternion);
+                    tiled.set_skinning_method(SkinningMethod::DualQuaternion);
+                }
+                if (frame % 2 == 1)
+                {
+                    pose_matrices[1] = MathFacade::multiply(pose_matrices[1],
+                        MathFacade::rotateX(MathFacade::to_radians(20.f)));
+                    reference.set_output_pose_matrices(pose_matrices);
+                    tiled.set_output_pose_matrices(pose_matrices);
+                }
+                valid &= reference.perform_skinning() && tiled.perform_skinning();
+
+                const std::vector<Vertex>& expected = reference.get_skinned_mesh().vertices;
+                const std::vector<Vertex>& actual = tiled.get_skinned_mesh().vertices;
+                valid &= expected.size() == actual.size();
+                for (size_t i = 0; valid && i < expected.size(); i++)
+                {
+                    if (!TestUtils::approx_equal_vec3(HMM_V3(expected[i].x, expected[i].y, expected[i].z),
+                                                      HMM_V3(actual[i].x, actual[i].y, actual[i].z)))
+                        mismatches++;
+                }
+            }
+
+            // Batches bind one sub-palette per pose and meshlet
+            valid &= reference.perform_batch_skinning({ pose_matrices, pose_matrices }) &&
+                     tiled.perform_batch_skinning({ pose_matrices, pose_matrices });
+            std::vector<Vertex> expected_batch;
+            std::vector<Vertex> actual_batch;
+            reference.get_batch_vertices(1, expected_batch);
+            tiled.get_batch_vertices(1, actual_batch);
+            for (size_t i = 0; valid && i < expected_batch.size(); i++)
+            {
+                if (!TestUtils::approx_equal_vec3(
+                        HMM_V3(expected_batch[i].x, expected_batch[i].y, expected_batch[i].z),
+                        HMM_V3(actual_batch[i].x, actual_batch[i].y, actual_batch[i].z)))
+                    mismatches++;
+            }
+            valid &= mismatches == 0;
+
+            TestUtils::set_console_color(valid ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << mismatches << " vertices differ across " << tiled.get_meshlet_count()
+                      << " meshlets" << std::endl;
+            TestUtils::reset_console_color();
+
+            return valid;
+        }
+        catch (const std::exception& e)
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Meshlet tiling test failed with exception: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+            return false;
+        }
+    });
+
+    // 16-bit buffers must decode to the skinned mesh within their precision, across incremental frames
+    suite.add_test("Skinning Into Half and Normalized Buffers", []()
+    {
+        try
+        {
+            MeshSkinner skinner;
+            const bool loaded = skinner.load_mesh("asset/input_mesh.obj") &&
+                                skinner.load_weights("asset/bone_weights.json") &&
+                                skinner.load_inverse_bind_matrices("asset/inverse_bind_pose.json") &&
+                                skinner.load_output_pose_matrices("asset/output_pose.json");
+            if (!loaded)
+            {
+                TestUtils::print_colored("Failed to load the skinning data\n",
+                    TestUtils::ConsoleColor::Red);
+                return false;
+            }
+
+            // Ties round to even, subnormals survive, and out-of-range values become infinite
+            bool valid = PositionBuffer::from_half(PositionBuffer::to_half(1.f)) == 1.f &&
+                         PositionBuffer::from_half(PositionBuffer::to_half(-2.5f)) == -2.5f &&
+                         PositionBuffer::to_half(1.f + 1.f / 2048.f) == 0x3C00 &&
+                         PositionBuffer::to_half(1.f + 3.f / 2048.f) == 0x3C02 &&
+                         PositionBuffer::to_half(std::ldexp(1.f, -24)) == 0x0001 &&
+                         PositionBuffer::to_half(70000.f) == 0x7C00;
+
+            const size_t vertex_count = skinner.get_skinned_mesh().vertices.size();
+            std::vector<uint16_t> half_positions(vertex_count * 3);
+            std::vector<uint16_t> normalized_positions(vertex_count * 3);
+            PositionBounds bounds;
+            const PositionBuffer half_output =
+                PositionBuffer::packed(half_positions.data(), vertex_count, PositionFormat::Float16);
+            PositionBuffer normalized_output = PositionBuffer::packed(
+                normalized_positions.data(), vertex_count, PositionFormat::Unorm16);
+
+            // Normalized buffers without a place for the bounds are rejected
+            valid &= !skinner.perform_skinning(normalized_output);
+            normalized_output.bounds = &bounds;
+
+            // The second frame re-skins incrementally and moves the box
+            std::vector<HMM_Mat4> pose_matrices = SkinningData::parse_matrices_from_json(
+                JsonFacade::load_from_file("asset/output_pose.json"));
+            float worst_half = 0.f;
+            float worst_normalized = 0.f;
+            for (int frame = 0; frame < 2 && valid; frame++)
+            {
+                if (frame > 0)
+                {
+                    pose_matrices[0] = MathFacade::multiply(pose_matrices[0],
+                        MathFacade::rotateZ(MathFacade::to_radians(15.f)));
+                    skinner.set_output_pose_matrices(pose_matrices);
+                }
+                valid &= skinner.perform_skinning(half_output) &&
+                         skinner.perform_skinning(normalized_output) &&
+                         skinner.perform_skinning();
+
+                const std::vector<Vertex>& expected = skinner.get_skinned_mesh().vertices;
+                for (size_t i = 0; valid && i < vertex_count; i++)
+                {
+                    const float position[3] = { expected[i].x, expected[i].y, expected[i].z };
+                    for (int axis = 0; axis < 3; axis++)
+                    {
+                        // Halves keep 11 significant bits; unorm16 steps are 1/65535 of the box
+                        const float half = PositionBuffer::from_half(half_positions[i * 3 + axis]);
+                        worst_half = std::max(worst_half, std::abs(half - position[axis]) /
+                                              std::max(std::abs(position[axis]), 1e-3f));
+
+                        const float extent = bounds.max[axis] - bounds.min[axis];
+                        const float normalized = bounds.min[axis] +
+                            normalized_positions[i * 3 + axis] / 65535.f * extent;
+                        worst_normalized = std::max(worst_normalized,
+                                                    std::abs(normalized - position[axis]) / extent);
+                        valid &= position[axis] >= bounds.min[axis] &&
+                                 position[axis] <= bounds.max[axis];
+                    }
+                }
+            }
+            valid &= worst_half <= 1.f / 2048.f && worst_normalized <= .6f / 65535.f;
+
+            TestUtils::set_console_color(valid ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << std::defaultfloat << "Relative error " << worst_half << " in half, "
+                      << worst_normalized * 65535.f << " steps in unorm16" << std::endl;
+            TestUtils::reset_console_color();
+
+            return valid;
+        }
+        catch (const std::exception& e)
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "16-bit buffer test failed with exception: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+            return false;
+        }
+    });
+
+    // Each crowd instance must match skinning its pose, moved by its world transform, on its own
+    suite.add_test("Crowd Skinning Matches Per-Instance Skinning", []()
+    {
+        try
+        {
+            MeshSkinner skinner;
+            const bool loaded = skinner.load_mesh("asset/input_mesh.obj") &&
+                                skinner.load_weights("asset/bone_weights.json") &&
+                                skinner.load_inverse_bind_matrices("asset/inverse_bind_pose.json");
+            if (!loaded)
+            {
+                TestUtils::print_colored("Failed to load the skinning data\n",
+                    TestUtils::ConsoleColor::Red);
+                return false;
+            }
+
+            // Agents bending the root by different angles, spread out along x
+            constexpr size_t INSTANCE_COUNT = 7;
+            const std::vector<HMM_Mat4> rest_pose = SkinningData::parse_matrices_from_json(
+                JsonFacade::load_from_file("asset/output_pose.json"));
+            std::vector<std::vector<HMM_Mat4>> poses(INSTANCE_COUNT, rest_pose);
+            std::vector<HMM_Mat4> world_transforms(INSTANCE_COUNT);
+            for (size_t instance = 0; instance < INSTANCE_COUNT; instance++)
+            {
+                poses[instance][0] = MathFacade::multiply(rest_pose[0],
+                    MathFacade::rotateZ(MathFacade::to_radians(7.f * instance)));
+                world_transforms[instance] = MathFacade::multiply(
+                    HMM_Translate(HMM_V3(3.f * instance, 0.f, -1.f)),
+                    MathFacade::rotateY(MathFacade::to_radians(30.f * instance)));
+            }
+
+            // One slice of a shared position array per instance
+            const size_t vertex_count = skinner.get_skinned_mesh().vertices.size();
+            std::vector<float> crowd_positions(INSTANCE_COUNT * vertex_count * 3);
+            std::vector<PositionBuffer> outputs;
+            for (size_t instance = 0; instance < INSTANCE_COUNT; instance++)
+            {
+                outputs.push_back(PositionBuffer::packed(
+                    &crowd_positions[instance * vertex_count * 3], vertex_count));
+            }
+
+            // Mismatched inputs are rejected
+            bool valid = !skinner.perform_crowd_skinning(poses, { world_transforms.front() }, outputs) &&
+                         skinner.perform_crowd_skinning(poses, world_transforms, outputs);
+
+            size_t mismatches = 0;
+            for (size_t instance = 0; valid && instance < INSTANCE_COUNT; instance++)
+            {
+                std::vector<HMM_Mat4> placed_pose = poses[instance];
+                for (HMM_Mat4& matrix : placed_pose)
+                {
+                    matrix = MathFacade::multiply(world_transforms[instance], matrix);
+                }
+                skinner.set_output_pose_matrices(placed_pose);
+                valid &= skinner.perform_skinning();
+
+                const std::vector<Vertex>& expected = skinner.get_skinned_mesh().vertices;
+                const float* actual = &crowd_positions[instance * vertex_count * 3];
+                for (size_t i = 0; valid && i < vertex_count; i++)
+                {
+                    if (!TestUtils::approx_equal_vec3(HMM_V3(expected[i].x, expected[i].y, expected[i].z),
+                                                      HMM_V3(actual[i * 3], actual[i * 3 + 1], actual[i * 3 + 2])))
+                        mismatches++;
+                }
+            }
+            valid &= mismatches == 0;
+
+            TestUtils::set_console_color(valid ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << mismatches << " vertices differ over " << INSTANCE_COUNT << " instances" << std::endl;
+            TestUtils::reset_console_color();
+
+            return valid;
+        }
+        catch (const std::exception& e)
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Crowd skinning test failed with exception: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+            return false;
+        }
+    });
+
+    // Dual quaternions can't hold a placement's scale, so it must be applied after skinning
+    suite.add_test("Dual Quaternion Crowd Keeps World Scale", []()
+    {
+        try
+        {
+            MeshSkinner skinner;
+            const bool loaded = skinner.load_mesh("asset/input_mesh.obj") &&
+                                skinner.load_weights("asset/bone_weights.json") &&
+                                skinner.load_inverse_bind_matrices("asset/inverse_bind_pose.json");
+            if (!loaded)
+            {
+                TestUtils::print_colored("Failed to load the skinning data\n",
+                    TestUtils::ConsoleColor::Red);
+                return false;
+            }
+            skinner.set_skinning_method(SkinningMethod::DualQuaternion);
+
+            // Non-uniformly scaled agents, each bending the root by a different angle
+            constexpr size_t INSTANCE_COUNT = 3;
+            const std::vector<HMM_Mat4> rest_pose = SkinningData::parse_matrices_from_json(
+                JsonFacade::load_from_file("asset/output_pose.json"));
+            std::vector<std::vector<HMM_Mat4>> poses(INSTANCE_COUNT, rest_pose);
+            std::vector<HMM_Mat4> world_transforms(INSTANCE_COUNT);
+            for (size_t instance = 0; instance < INSTANCE_COUNT; instance++)
+            {
+                poses[instance][0] = MathFacade::multiply(rest_pose[0],
+                    MathFacade::rotateZ(MathFacade::to_radians(10.f * instance)));
+                world_transforms[instance] = MathFacade::multiply(
+                    MathFacade::translate(2.f * instance, 0.f, 0.f),
+                    MathFacade::scale(1.f + instance, .5f, 2.f));
+            }
+
+            const size_t vertex_count = skinner.get_skinned_mesh().vertices.size();
+            std::vector<float> crowd_positions(INSTANCE_COUNT * vertex_count * 3);
+            std::vector<PositionBuffer> outputs;
+            for (size_t instance = 0; instance < INSTANCE_COUNT; instance++)
+            {
+                outputs.push_back(PositionBuffer::packed(
+                    &crowd_positions[instance * vertex_count * 3], vertex_count));
+            }
+            bool valid = skinner.perform_crowd_skinning(poses, world_transforms, outputs);
+
+            // Reference: skin the pose alone, then move the result by the world transform
+            size_t mismatches = 0;
+            for (size_t instance = 0; valid && instance < INSTANCE_COUNT; instance++)
+            {
+                skinner.set_output_pose_matrices(poses[instance]);
+                valid &= skinner.perform_skinning();
+
+                const std::vector<Vertex>& skinned = skinner.get_skinned_mesh().vertices;
+                const float* actual = &crowd_positions[instance * vertex_count * 3];
+                for (size_t i = 0; valid && i < vertex_count; i++)
+                {
+                    const HMM_Vec3 expected = MathFacade::transform_vec3(world_transforms[instance],
+                        HMM_V3(skinned[i].x, skinned[i].y, skinned[i].z));
+                    if (!TestUtils::approx_equal_vec3(expected,
+                                                      HMM_V3(actual[i * 3], actual[i * 3 + 1], actual[i * 3 + 2])))
+                        mismatches++;
+                }
+            }
+            valid &= mismatches == 0;
+
+            TestUtils::set_console_color(valid ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << mismatches << " vertices differ over " << INSTANCE_COUNT << " scaled instances" << std::endl;
+            TestUtils::reset_console_color();
+
+            return valid;
+        }
+        catch (const std::exception& e)
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Dual quaternion crowd test failed with exception: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+            return false;
+        }
+    });
+
+    // Morph targets fused into the skinning pass must match skinning a pre-morphed OBJ
+    suite.add_test("Morph Targets Match Pre-Morphed Mesh", []()
+    {
+        const std::string targets_path = "asset/temp_morph_targets.json";
+        const std::string morphed_mesh_path = "asset/temp_morphed_mesh.obj";
+
+        bool valid = false;
+        try
+        {
+            // Two overlapping sparse targets, each moving a fraction of the vertices
+            Mesh morphed_mesh = ObjFacade::load_obj_mesh("asset/input_mesh.obj");
+            const std::vector<float> weights = { .75f, -1.5f };
+            std::ofstream targets_file(targets_path);
+            targets_file << "[";
+            for (size_t target = 0; target < weights.size(); target++)
+            {
+                std::vector<size_t> indices;
+                std::vector<HMM_Vec3> deltas;
+                for (size_t vertex = target * 3; vertex < morphed_mesh.vertices.size(); vertex += 5 + target * 2)
+                {
+                    indices.push_back(vertex);
+                    deltas.push_back(HMM_V3(.05f * (vertex % 3), .08f - .04f * target, -.06f));
+
+                    morphed_mesh.vertices[vertex].x += weights[target] * deltas.back().X;
+                    morphed_mesh.vertices[vertex].y += weights[target] * deltas.back().Y;
+                    morphed_mesh.vertices[vertex].z += weights[target] * deltas.back().Z;
+                }
+
+                targets_file << (target == 0 ? "{\"weight\": 0, \"indices\": [" : ", {\"indices\": [");
+                for (size_t i = 0; i < indices.size(); i++)
+                {
+                    targets_file << (i == 0 ? "" : ", ") << indices[i];
+                }
+                targets_file << "], \"deltas\": [";
+                for (size_t i = 0; i < deltas.size(); i++)
+                {
+                    targets_file << (i == 0 ? "[" : ", [") << deltas[i].X << ", " << deltas[i].Y
+                                 << ", " << deltas[i].Z << "]";
+                }
+                targets_file << "]}";
+            }
+            targets_file << "]";
+            targets_file.close();
+            ObjFacade::save_obj_mesh(morphed_mesh_path, morphed_mesh);
+
+            MeshSkinner morphed;
+            MeshSkinner reference;
+            const bool loaded = morphed.load_mesh("asset/input_mesh.obj") &&
+                                morphed.load_weights("asset/bone_weights.json") &&
+                                morphed.load_inverse_bind_matrices("asset/inverse_bind_pose.json") &&
+                                morphed.load_output_pose_matrices("asset/output_pose.json") &&
+                                morphed.load_morph_targets(targets_path) &&
+                                reference.load_mesh(morphed_mesh_path) &&
+                                reference.load_weights("asset/bone_weights.json") &&
+                                reference.load_inverse_bind_matrices("asset/inverse_bind_pose.json") &&
+                                reference.load_output_pose_matrices("asset/output_pose.json");
+
+            // Skin at zero weights first, so the weighted frame only re-skins the morphed chunks
+            const bool skinned = loaded && morphed.get_morph_target_count() == 2 &&
+                                 morphed.perform_skinning() && morphed.set_morph_weights(weights) &&
+                                 morphed.perform_skinning() && reference.perform_skinning() &&
+                                 !morphed.set_morph_weights({ 1.f });
+
+            // The batch path morphs the rest pose once up front instead
+            const std::vector<HMM_Mat4> pose_matrices = SkinningData::parse_matrices_from_json(
+                JsonFacade::load_from_file("asset/output_pose.json"));
+            std::vector<Vertex> batch_vertices;
+            const bool batched = skinned && morphed.perform_batch_skinning({ pose_matrices });
+            if (batched)
+                morphed.get_batch_vertices(0, batch_vertices);
+
+            // The reference went through a text OBJ, so allow for its rounding
+            const std::vector<Vertex>& expected = reference.get_skinned_mesh().vertices;
+            const auto count_mismatches = [&expected](const std::vector<Vertex>& actual)
+            {
+                size_t mismatches = actual.size() == expected.size() ? 0 : expected.size();
+                for (size_t i = 0; i < std::min(actual.size(), expected.size()); i++)
+                {
+                    if (!TestUtils::approx_equal_vec3(HMM_V3(expected[i].x, expected[i].y, expected[i].z),
+                                                      HMM_V3(actual[i].x, actual[i].y, actual[i].z), .001f))
+                    {
+                        mismatches++;
+                    }
+                }
+                return mismatches;
+            };
+            const size_t mismatches = count_mismatches(morphed.get_skinned_mesh().vertices) +
+                                      count_mismatches(batch_vertices);
+            valid = skinned && batched && mismatches == 0;
+
+            TestUtils::set_console_color(valid ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << mismatches << " vertices differ from skinning the pre-morphed mesh" << std::endl;
+            TestUtils::reset_console_color();
+        }
+        catch (const std::exception& e)
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Morph target test failed with exception: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+        }
+
+        for (const std::string& path : { targets_path, morphed_mesh_path })
+        {
+            std::filesystem::remove(path);
+        }
+        return valid;
+    });
+
+    // Submitted frames land in rotating slots and stay intact while later frames are skinned
+    suite.add_test("Asynchronous Skinning Double Buffers Frames", []()
+    {
+        try
+        {
+            MeshSkinner skinner;
+            const bool loaded = skinner.load_mesh("asset/input_mesh.obj") &&
+                                skinner.load_weights("asset/bone_weights.json") &&
+                                skinner.load_inverse_bind_matrices("asset/inverse_bind_pose.json");
+            if (!loaded)
+            {
+                TestUtils::print_colored("Failed to load the skinning data\n",
+                    TestUtils::ConsoleColor::Red);
+                return false;
+            }
+
+            // Three poses bending the root a little further each frame
+            const std::vector<HMM_Mat4> rest_pose = SkinningData::parse_matrices_from_json(
+                JsonFacade::load_from_file("asset/output_pose.json"));
+            std::vector<std::vector<HMM_Mat4>> poses(3, rest_pose);
+            for (size_t frame = 0; frame < poses.size(); frame++)
+            {
+                poses[frame][0] = MathFacade::multiply(rest_pose[0],
+                    MathFacade::rotateZ(MathFacade::to_radians(10.f * frame)));
+            }
+
+            // Reference results, skinned synchronously
+            std::vector<std::vector<Vertex>> expected;
+            for (const std::vector<HMM_Mat4>& pose : poses)
+            {
+                skinner.set_output_pose_matrices(pose);
+                if (!skinner.perform_skinning())
+                    return false;
+                expected.push_back(skinner.get_skinned_mesh().vertices);
+            }
+
+            auto matches = [](const std::vector<Vertex>& actual, const std::vector<Vertex>& reference)
+            {
+                bool equal = actual.size() == reference.size();
+                for (size_t i = 0; equal && i < actual.size(); i++)
+                {
+                    equal = TestUtils::approx_equal_vec3(
+                        HMM_V3(actual[i].x, actual[i].y, actual[i].z),
+                        HMM_V3(reference[i].x, reference[i].y, reference[i].z));
+                }
+                return equal;
+            };
+
+            // Hold frame 0 while frame 1 is skinned into the other slot
+            std::future<MeshSkinner::SkinnedFrame> first = skinner.submit_skinning(poses[0]);
+            std::future<MeshSkinner::SkinnedFrame> second = skinner.submit_skinning(poses[1]);
+            MeshSkinner::SkinnedFrame frame0 = first.get();
+            MeshSkinner::SkinnedFrame frame1 = second.get();
+            bool valid = frame0 != frame1 && matches(*frame0, expected[0]) && matches(*frame1, expected[1]);
+
+            // Frame 2 can only reuse frame 0's slot once it is released
+            std::future<MeshSkinner::SkinnedFrame> third = skinner.submit_skinning(poses[2]);
+            valid &= third.wait_for(std::chrono::milliseconds(50)) == std::future_status::timeout;
+            const std::vector<Vertex>* frame0_slot = frame0.get();
+            frame0.reset();
+            MeshSkinner::SkinnedFrame frame2 = third.get();
+            valid &= frame2.get() == frame0_slot && matches(*frame2, expected[2]) &&
+                     matches(*frame1, expected[1]);
+
+            // Failures surface through the future instead of a bool
+            frame1.reset();
+            frame2.reset();
+            bool rethrown = false;
+            try
+            {
+                skinner.submit_skinning({}).get();
+            }
+            catch (const std::runtime_error&)
+            {
+                rethrown = true;
+            }
+            valid &= rethrown;
+
+            TestUtils::set_console_color(valid ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << "Frames skinned through " << skinner.get_output_slot_count()
+                      << " output slots " << (valid ? "match" : "do not match")
+                      << " synchronous skinning" << std::endl;
+            TestUtils::reset_console_color();
+
+            return valid;
+        }
+        catch (const std::exception& e)
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Asynchronous skinning test failed with exception: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+            return false;
+        }
+    });
+
+    // Posing a skeleton with local transforms must match skinning with chained world matrices
+    suite.add_test("Forward Kinematics Matches Chained Matrices", []()
+    {
+        try
+        {
+            MeshSkinner skeletal;
+            MeshSkinner baked;
+            const bool loaded = skeletal.load_mesh("asset/input_mesh.obj") &&
+                                skeletal.load_weights("asset/bone_weights.json") &&
+                                skeletal.load_inverse_bind_matrices("asset/inverse_bind_pose.json") &&
+                                baked.load_mesh("asset/input_mesh.obj") &&
+                                baked.load_weights("asset/bone_weights.json") &&
+                                baked.load_inverse_bind_matrices("asset/inverse_bind_pose.json");
+            const size_t joint_count = SkinningData::parse_matrices_from_json(
+                JsonFacade::load_from_file("asset/inverse_bind_pose.json")).size();
+
+            // A binary tree whose parents are listed after some of their children
+            std::vector<int32_t> parents(joint_count, -1);
+            std::vector<JointTransform> local_transforms(joint_count);
+            for (size_t joint = 0; joint < joint_count; joint++)
+            {
+                const size_t tree_index = joint_count - 1 - joint;
+                if (tree_index > 0)
+                    parents[joint] = static_cast<int32_t>(joint_count - 1 - (tree_index - 1) / 2);
+
+                const float angle = MathFacade::to_radians(7.f * joint);
+                local_transforms[joint].translation = HMM_V3(.1f * joint, .5f, -.2f);
+                local_transforms[joint].rotation = HMM_Q(0.f, std::sin(angle / 2), 0.f, std::cos(angle / 2));
+                local_transforms[joint].scale = HMM_V3(1.f, 1.f + .01f * joint, 1.f);
+            }
+
+            // Reference: world = parent world * T * R * S, resolved root first
+            std::vector<HMM_Mat4> world(joint_count);
+            for (size_t tree_index = 0; tree_index < joint_count; tree_index++)
+            {
+                const size_t joint = joint_count - 1 - tree_index;
+                const JointTransform& local = local_transforms[joint];
+                const HMM_Mat4 local_matrix = MathFacade::multiply(
+                    MathFacade::translate(local.translation.X, local.translation.Y, local.translation.Z),
+                    MathFacade::multiply(HMM_QToM4(local.rotation),
+                                         MathFacade::scale(local.scale.X, local.scale.Y, local.scale.Z)));
+                world[joint] = parents[joint] < 0 ? local_matrix :
+                    MathFacade::multiply(world[static_cast<size_t>(parents[joint])], local_matrix);
+            }
+            baked.set_output_pose_matrices(world);
+
+            const bool skinned = loaded && skeletal.set_skeleton(parents) &&
+                                 skeletal.set_local_pose(local_transforms) &&
+                                 skeletal.perform_skinning() && baked.perform_skinning();
+
+            const std::vector<Vertex>& expected = baked.get_skinned_mesh().vertices;
+            const std::vector<Vertex>& actual = skeletal.get_skinned_mesh().vertices;
+            size_t mismatches = skinned && expected.size() == actual.size() ? 0 : expected.size() + 1;
+            for (size_t i = 0; mismatches == 0 && i < expected.size(); i++)
+            {
+                if (!TestUtils::approx_equal_vec3(HMM_V3(expected[i].x, expected[i].y, expected[i].z),
+                                                  HMM_V3(actual[i].x, actual[i].y, actual[i].z)))
+                {
+                    mismatches++;
+                }
+            }
+
+            // A pose for a different joint count is rejected
+            const bool rejected = !skeletal.set_local_pose(std::vector<JointTransform>(joint_count + 1));
+
+            TestUtils::set_console_color(mismatches == 0 && rejected ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << mismatches << " vertices differ from skinning with chained world matrices"
+                      << std::endl;
+            TestUtils::reset_console_color();
+
+            return mismatches == 0 && rejected;
+        }
+        catch (const std::exception& e)
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Forward kinematics test failed with exception: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+            return false;
+        }
+    });
+
+    // Sampling a clip in-process matches skinning the interpolated palette it stands for
+    suite.add_test("Animation Clip Sampling Matches Interpolated Poses", []()
+    {
+        try
+        {
+            MeshSkinner sampled;
+            MeshSkinner baked;
+            const bool loaded = sampled.load_mesh("asset/input_mesh.obj") &&
+                                sampled.load_weights("asset/bone_weights.json") &&
+                                sampled.load_inverse_bind_matrices("asset/inverse_bind_pose.json") &&
+                                baked.load_mesh("asset/input_mesh.obj") &&
+                                baked.load_weights("asset/bone_weights.json") &&
+                                baked.load_inverse_bind_matrices("asset/inverse_bind_pose.json");
+            const size_t joint_count = SkinningData::parse_matrices_from_json(
+                JsonFacade::load_from_file("asset/inverse_bind_pose.json")).size();
+
+            // Two keys a second apart turning about Y; every third joint holds a single key
+            AnimationClip clip;
+            clip.key_offsets.push_back(0);
+            std::vector<HMM_Mat4> midpoint(joint_count);
+            for (size_t joint = 0; joint < joint_count; joint++)
+            {
+                const float start_angle = MathFacade::to_radians(5.f * joint);
+                const float end_angle = MathFacade::to_radians(5.f * joint + 40.f);
+                JointTransform start;
+                start.translation = HMM_V3(.1f * joint, 0.f, 0.f);
+                start.rotation = HMM_Q(0.f, std::sin(start_angle / 2), 0.f, std::cos(start_angle / 2));
+                JointTransform end = start;
+                end.translation = HMM_V3(.1f * joint, .4f, 0.f);
+                end.rotation = HMM_Q(0.f, std::sin(end_angle / 2), 0.f, std::cos(end_angle / 2));
+                end.scale = HMM_V3(1.f, 1.2f, 1.f);
+
+                clip.key_times.push_back(0.f);
+                clip.key_transforms.push_back(start);
+                if (joint % 3 != 0)
+                {
+                    clip.key_times.push_back(1.f);
+                    clip.key_transforms.push_back(end);
+                }
+                clip.key_offsets.push_back(static_cast<uint32_t>(clip.key_times.size()));
+
+                // Halfway, the joint has turned halfway and moved halfway
+                const float half_angle = (start_angle + end_angle) / 2;
+                midpoint[joint] = joint % 3 == 0 ?
+                    MathFacade::compose(start.translation, start.rotation, start.scale) :
+                    MathFacade::compose(HMM_V3(.1f * joint, .2f, 0.f),
+                                        HMM_Q(0.f, std::sin(half_angle / 2), 0.f, std::cos(half_angle / 2)),
+                                        HMM_V3(1.f, 1.1f, 1.f));
+            }
+            sampled.set_animation_clip(clip);
+            baked.set_output_pose_matrices(midpoint);
+
+            const bool skinned = loaded && sampled.sample_animation_clip(.5f) &&
+                                 sampled.perform_skinning() && baked.perform_skinning();
+
+            const std::vector<Vertex>& expected = baked.get_skinned_mesh().vertices;
+            const std::vector<Vertex>& actual = sampled.get_skinned_mesh().vertices;
+            size_t mismatches = skinned && expected.size() == actual.size() ? 0 : expected.size() + 1;
+            for (size_t i = 0; mismatches == 0 && i < expected.size(); i++)
+            {
+                if (!TestUtils::approx_equal_vec3(HMM_V3(expected[i].x, expected[i].y, expected[i].z),
+                                                  HMM_V3(actual[i].x, actual[i].y, actual[i].z), .001f))
+                {
+                    mismatches++;
+                }
+            }
+
+            // One second at 4 fps is five frames, both ends included
+            const bool sequenced = sampled.get_animation_duration() == 1.f &&
+                                   sampled.sample_animation_sequence(4.f) &&
+                                   sampled.get_pose_sequence_length() == 5 &&
+                                   !sampled.sample_animation_sequence(0.f);
+
+            TestUtils::set_console_color(mismatches == 0 && sequenced ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << mismatches << " vertices differ from skinning the interpolated palette"
+                      << std::endl;
+            TestUtils::reset_console_color();
+
+            return mismatches == 0 && sequenced;
+        }
+        catch (const std::exception& e)
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Animation clip test failed with exception: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+            return false;
+        }
+    });
+
+    // A packed pose track decodes any frame, in any order, close to the palette it came from
+    suite.add_test("Pose Track Round-Trips Palettes", []()
+    {
+        const std::string track_path = "asset/temp_pose_track.mska";
+        const std::string truncated_path = "asset/temp_truncated_track.mska";
+        try
+        {
+            MeshSkinner packed;
+            MeshSkinner baked;
+            const bool loaded = packed.load_mesh("asset/input_mesh.obj") &&
+                                packed.load_weights("asset/bone_weights.json") &&
+                                packed.load_inverse_bind_matrices("asset/inverse_bind_pose.json") &&
+                                baked.load_mesh("asset/input_mesh.obj") &&
+                                baked.load_weights("asset/bone_weights.json") &&
+                                baked.load_inverse_bind_matrices("asset/inverse_bind_pose.json");
+            const std::vector<HMM_Mat4> rest_pose = SkinningData::parse_matrices_from_json(
+                JsonFacade::load_from_file("asset/output_pose.json"));
+
+            // Odd joints hold still, so only the even ones should be keyed per frame
+            const size_t frame_count = 24;
+            std::vector<std::vector<HMM_Mat4>> frames(frame_count, rest_pose);
+            for (size_t frame = 0; frame < frame_count; frame++)
+            {
+                const HMM_Mat4 motion = MathFacade::multiply(MathFacade::translate(.01f * frame, 0.f, 0.f),
+                                                             MathFacade::rotateY(.05f * frame));
+                for (size_t joint = 0; joint < rest_pose.size(); joint += 2)
+                    frames[frame][joint] = MathFacade::multiply(motion, rest_pose[joint]);
+            }
+            const size_t track_size = PoseTrack::save(track_path, frames);
+            const size_t keyed_size = frame_count * rest_pose.size() * 3 * 3 * sizeof(uint16_t);
+
+            // Frames are posed out of order straight from the mapped file
+            size_t mismatches = loaded && packed.load_pose_track(track_path) &&
+                                packed.get_pose_track_length() == frame_count ? 0 : 1;
+            for (const size_t frame : { size_t(17), size_t(0), size_t(23), size_t(5) })
+            {
+                baked.set_output_pose_matrices(frames[frame]);
+                if (mismatches != 0 || !packed.set_pose_track_frame(frame) ||
+                    !packed.perform_skinning() || !baked.perform_skinning())
+                {
+                    mismatches++;
+                    break;
+                }
+
+                const std::vector<Vertex>& expected = baked.get_skinned_mesh().vertices;
+                const std::vector<Vertex>& actual = packed.get_skinned_mesh().vertices;
+                for (size_t i = 0; i < expected.size(); i++)
+                {
+                    if (!TestUtils::approx_equal_vec3(HMM_V3(expected[i].x, expected[i].y, expected[i].z),
+                                                      HMM_V3(actual[i].x, actual[i].y, actual[i].z), .001f))
+                    {
+                        mismatches++;
+                    }
+                }
+            }
+
+            // The sequence loader decodes every frame; bad frames and truncated files are rejected
+            {
+                std::ifstream source(track_path, std::ios::binary);
+                std::ofstream truncated(truncated_path, std::ios::binary);
+                std::vector<char> header(40);
+                source.read(header.data(), static_cast<std::streamsize>(header.size()));
+                truncated.write(header.data(), static_cast<std::streamsize>(header.size()));
+            }
+            const bool checked = packed.load_pose_sequence(track_path) &&
+                                 packed.get_pose_sequence_length() == frame_count &&
+                                 !packed.set_pose_track_frame(frame_count) &&
+                                 !packed.load_pose_track(truncated_path);
+
+            // Shear can't be stored as translation, rotation and scale, so it isn't packed
+            bool shear_rejected = false;
+            std::vector<std::vector<HMM_Mat4>> sheared(1, rest_pose);
+            sheared[0][0].Elements[1][0] += .5f;
+            try
+            {
+                PoseTrack::save(track_path, sheared);
+            }
+            catch (const std::invalid_argument&)
+            {
+                shear_rejected = true;
+            }
+
+            std::filesystem::remove(track_path);
+            std::filesystem::remove(truncated_path);
+
+            const bool compressed = track_size < keyed_size;
+            const bool passed = mismatches == 0 && checked && shear_rejected && compressed;
+            TestUtils::set_console_color(passed ? TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << mismatches << " vertices differ from the source palettes; track is "
+                      << track_size << " bytes" << std::endl;
+            TestUtils::reset_console_color();
+
+            return passed;
+        }
+        catch (const std::exception& e)
+        {
+            std::filesystem::remove(track_path);
+            std::filesystem::remove(truncated_path);
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Pose track test failed with exception: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+            return false;
+        }
+    });
+
+    // Weights are pruned, renormalized and range-checked once, when they are loaded
+    suite.add_test("Weights Are Baked at Load Time", []()
+    {
+        const std::string mesh_path = "asset/temp_baking_mesh.obj";
+        const std::string weights_path = "asset/temp_baking_weights.json";
+        const std::string bad_weights_path = "asset/temp_baking_bad_weights.json";
+        const std::string matrices_path = "asset/temp_baking_matrices.json";
+
+        bool valid = false;
+        try
+        {
+            std::ofstream(mesh_path) << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+            std::ofstream(matrices_path) << "[[1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1],"
+                                            " [1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1]]";
+
+            // Unnormalized weights, a negligible weight, a negative joint and (in the bad
+            // file) a joint the two-joint palette does not have
+            const std::string vertex0 = "{\"index\": [0, 1], \"weight\": [2, 2]}";
+            const std::string vertex1 = "{\"index\": [1, 0, -1], \"weight\": [1, 0.00001, 0.5]}";
+            std::ofstream(weights_path) << "[" << vertex0 << ", " << vertex1
+                                        << ", {\"index\": [1], \"weight\": [0.5]}]";
+            std::ofstream(bad_weights_path) << "[" << vertex0 << ", " << vertex1
+                                            << ", {\"index\": [5], \"weight\": [1]}]";
+
+            // Joint 1 moves up by 1, joint 0 stays
+            MeshSkinner skinner;
+            const bool loaded = skinner.load_mesh(mesh_path) &&
+                                skinner.load_weights(bad_weights_path) &&
+                                skinner.load_inverse_bind_matrices(matrices_path);
+            std::vector<HMM_Mat4> pose(2, MathFacade::create_identity());
+            pose[1] = MathFacade::translate(0.f, 1.f, 0.f);
+            skinner.set_output_pose_matrices(pose);
+
+            const bool rejected = loaded && !skinner.perform_skinning();
+            const bool skinned = skinner.load_weights(weights_path) && skinner.perform_skinning();
+
+            const std::vector<Vertex>& vertices = skinner.get_skinned_mesh().vertices;
+            valid = rejected && skinned && vertices.size() == 3 &&
+                    TestUtils::approx_equal_vec3(HMM_V3(vertices[0].x, vertices[0].y, vertices[0].z),
+                                                 HMM_V3(0.f, .5f, 0.f)) &&
+                    TestUtils::approx_equal_vec3(HMM_V3(vertices[1].x, vertices[1].y, vertices[1].z),
+                                                 HMM_V3(1.f, 1.f, 0.f)) &&
+                    TestUtils::approx_equal_vec3(HMM_V3(vertices[2].x, vertices[2].y, vertices[2].z),
+                                                 HMM_V3(0.f, 2.f, 0.f));
+
+            TestUtils::set_console_color(valid ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << "Out-of-range joint " << (rejected ? "rejected" : "accepted")
+                      << ", baked weights " << (skinned ? "skinned" : "failed to skin") << std::endl;
+            TestUtils::reset_console_color();
+        }
+        catch (const std::exception& e)
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Weight baking test failed with exception: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+        }
+
+        for (const std::string& path : { mesh_path, weights_path, bad_weights_path, matrices_path })
+        {
+            std::filesystem::remove(path);
+        }
+        return valid;
+    });
+
+    // Re-placing the streams for NUMA nodes must not change what gets skinned
+    suite.add_test("NUMA Placement Matches Default Skinning", []()
+    {
+        try
+        {
+            MeshSkinner numa;
+            MeshSkinner standard;
+            numa.set_numa_aware(true);
+            numa.set_thread_count(2);
+
+            const bool skinned = numa.load_mesh("asset/input_mesh.obj") &&
+                                 numa.load_weights("asset/bone_weights.json") &&
+                                 numa.load_inverse_bind_matrices("asset/inverse_bind_pose.json") &&
+                                 numa.load_output_pose_matrices("asset/output_pose.json") &&
+                                 standard.load_mesh("asset/input_mesh.obj") &&
+                                 standard.load_weights("asset/bone_weights.json") &&
+                                 standard.load_inverse_bind_matrices("asset/inverse_bind_pose.json") &&
+                                 standard.load_output_pose_matrices("asset/output_pose.json") &&
+                                 numa.perform_skinning() && standard.perform_skinning();
+
+            // Changing the block shape re-places the streams once more
+            numa.set_grain_size(48);
+            const bool reskinned = skinned && numa.perform_skinning();
+
+            const std::vector<Vertex>& expected = standard.get_skinned_mesh().vertices;
+            const std::vector<Vertex>& actual = numa.get_skinned_mesh().vertices;
+            size_t mismatches = reskinned && expected.size() == actual.size() ? 0 : expected.size() + 1;
+            for (size_t i = 0; mismatches == 0 && i < expected.size(); i++)
+            {
+                if (!TestUtils::approx_equal_vec3(HMM_V3(expected[i].x, expected[i].y, expected[i].z),
+                                                  HMM_V3(actual[i].x, actual[i].y, actual[i].z)))
+                {
+                    mismatches++;
+                }
+            }
+
+            TestUtils::set_console_color(mismatches == 0 ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << mismatches << " vertices differ from default skinning" << std::endl;
+            TestUtils::reset_console_color();
+
+            return mismatches == 0;
+        }
+        catch (const std::exception& e)
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "NUMA skinning test failed with exception: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+            return false;
+        }
+    });
+
+    // Compact weights move each vertex by no more than the reported quantization error
+    suite.add_test("Compact Weights Stay Within Reported Error", []()
+    {
+        try
+        {
+            MeshSkinner compact;
+            MeshSkinner standard;
+            compact.set_weight_precision(WeightPrecision::Unorm8);
+
+            bool valid = compact.load_mesh("asset/input_mesh.obj") &&
+                         compact.load_weights("asset/bone_weights.json") &&
+                         compact.load_inverse_bind_matrices("asset/inverse_bind_pose.json") &&
+                         compact.load_output_pose_matrices("asset/output_pose.json") &&
+                         standard.load_mesh("asset/input_mesh.obj") &&
+                         standard.load_weights("asset/bone_weights.json") &&
+                         standard.load_inverse_bind_matrices("asset/inverse_bind_pose.json") &&
+                         standard.load_output_pose_matrices("asset/output_pose.json") &&
+                         compact.perform_skinning() && standard.perform_skinning();
+            valid &= compact.get_influence_encoding() == InfluenceEncoding::Joint8Unorm8 &&
+                     standard.measure_quantization_error() == 0.f;
+
+            // Compares the compact skinner's output against the float one
+            const auto max_difference = [&]()
+            {
+                const std::vector<Vertex>& expected = standard.get_skinned_mesh().vertices;
+                const std::vector<Vertex>& actual = compact.get_skinned_mesh().vertices;
+                float difference = expected.size() == actual.size() ? 0.f : 1e30f;
+                for (size_t i = 0; i < expected.size() && i < actual.size(); i++)
+                {
+                    difference = std::max(difference, HMM_LenV3(HMM_SubV3(
+                        HMM_V3(expected[i].x, expected[i].y, expected[i].z),
+                        HMM_V3(actual[i].x, actual[i].y, actual[i].z))));
+                }
+                return difference;
+            };
+
+            const float unorm8_error = compact.measure_quantization_error();
+            const float unorm8_difference = max_difference();
+            valid &= unorm8_difference <= unorm8_error + .0001f;
+
+            // Switching precision after loading rebuilds the streams
+            valid &= compact.set_weight_precision(WeightPrecision::Unorm16) &&
+                     compact.get_influence_encoding() == InfluenceEncoding::Joint8Unorm16 &&
+                     compact.perform_skinning();
+            const float unorm16_error = compact.measure_quantization_error();
+            const float unorm16_difference = max_difference();
+            valid &= unorm16_difference <= unorm16_error + .0001f;
+
+            TestUtils::set_console_color(valid ?
+                TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << "unorm8: moved " << unorm8_difference << " (reported " << unorm8_error
+                      << "), unorm16: moved " << unorm16_difference << " (reported "
+                      << unorm16_error << ")" << std::endl;
+            TestUtils::reset_console_color();
+
+            return valid;
+        }
+        catch (const std::exception& e)
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Compact weights test failed with exception: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+            return false;
+        }
+    });
+
+    // Sequence mode loads a directory of poses and writes one numbered OBJ per frame
+    suite.add_test("Sequence Skinning Writes Numbered Frames", []()
+    {
+        const std::string pose_directory = "asset/temp_pose_sequence";
+        const std::string output_directory = "asset/temp_skinned_sequence";
+
+        bool success = false;
+        try
+        {
+            std::filesystem::create_directories(pose_directory);
+            std::filesystem::create_directories(output_directory);
+
+            // Two single-palette files plus one file holding two palettes -> 4 frames
+            for (const char* name : { "frame_a.json", "frame_b.json" })
+            {
+                std::filesystem::copy_file("asset/output_pose.json",
+                    pose_directory + "/" + name,
+                    std::filesystem::copy_options::overwrite_existing);
+            }
+            {
+                std::ifstream pose_file("asset/output_pose.json");
+                const std::string palette((std::istreambuf_iterator<char>(pose_file)),
+                                          std::istreambuf_iterator<char>());
+                std::ofstream sequence_file(pose_directory + "/frame_c.json");
+                sequence_file << "[" << palette << "," << palette << "]";
+            }
+
+            MeshSkinner skinner;
+            const bool loaded = skinner.load_mesh("asset/input_mesh.obj") &&
+                                skinner.load_weights("asset/bone_weights.json") &&
+                                skinner.load_inverse_bind_matrices("asset/inverse_bind_pose.json") &&
+                                skinner.load_pose_sequence(pose_directory);
+
+            const std::string output_path = output_directory + "/frame.obj";
+            success = loaded &&
+                      skinner.get_pose_sequence_length() == 4 &&
+                      skinner.perform_sequence_skinning() &&
+                      skinner.save_skinned_sequence(output_path);
+
+            for (size_t frame = 0; success && frame < 4; frame++)
+            {
+                success &= std::filesystem::exists(MeshSkinner::get_frame_path(output_path, frame));
+            }
+
+            // A wildcard pattern selects a subset of the files
+            success &= skinner.load_pose_sequence(pose_directory + "/frame_?.json") &&
+                       skinner.get_pose_sequence_length() == 4 &&
+                       skinner.load_pose_sequence(pose_directory + "/*_b.json") &&
+                       skinner.get_pose_sequence_length() == 1;
+
+            // Unpadded numbers sort by value: pose_2 (shifted along x) is frame 0, pose_10 frame 1
+            const std::vector<HMM_Mat4> rest_pose = SkinningData::parse_matrices_from_json(
+                JsonFacade::load_from_file("asset/output_pose.json"));
+            for (const auto& [name, shift] : { std::make_pair("pose_2.json", 100.f),
+                                               std::make_pair("pose_10.json", 0.f) })
+            {
+                std::ofstream pose_file(pose_directory + "/" + name);
+                pose_file << "[";
+                for (size_t joint = 0; joint < rest_pose.size(); joint++)
+                {
+                    HMM_Mat4 matrix = rest_pose[joint];
+                    matrix.Elements[3][0] += shift;
+                    pose_file << (joint > 0 ? ",[" : "[");
+                    for (int element = 0; element < 16; element++)
+                        pose_file << (element > 0 ? "," : "") << matrix.Elements[element / 4][element % 4];
+                    pose_file << "]";
+                }
+                pose_file << "]";
+            }
+            success &= skinner.load_pose_sequence(pose_directory + "/pose_*.json") &&
+                       skinner.get_pose_sequence_length() == 2 &&
+                       skinner.perform_sequence_skinning() &&
+                       skinner.save_skinned_sequence(output_path);
+            if (success)
+            {
+                const Mesh first = ObjFacade::load_obj_mesh(MeshSkinner::get_frame_path(output_path, 0));
+                const Mesh second = ObjFacade::load_obj_mesh(MeshSkinner::get_frame_path(output_path, 1));
+                success &= first.vertices.size() == second.vertices.size() && !first.vertices.empty() &&
+                           TestUtils::approx_equal(first.vertices[0].x - second.vertices[0].x, 100.f, .01f);
+            }
+
+            TestUtils::print_colored(success ? "Sequence frames written: Success\n" :
+                                               "Sequence frames written: Failed\n",
+                success ? TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+        }
+        catch (const std::exception& e)
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Sequence skinning test failed with exception: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+            success = false;
+        }
+
+        // Clean up
+        std::filesystem::remove_all(pose_directory);
+        std::filesystem::remove_all(output_directory);
+
+        return success;
+    });
+    
     return suite;
 }
@@ -2,6 +2,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
 #include <vector>
 
 // Local application imports
@@ -76,6 +77,145 @@ TestSuite create_skinning_data_tests()
         }
     });
     
+    // Test that sparse parsing keeps every influence, beyond MAX_INFLUENCES
+    suite.add_test("Parse Sparse Weights from JSON", []() 
+    {
+        try 
+        {
+            const Json json_data = JsonFacade::parse(
+                "[{\"index\": [0, 1, 2, 3, 4, 5, 6, 7],"
+                "  \"weight\": [0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.2, 0.2]},"
+                " {\"index\": [3], \"weight\": [1.0]}]");
+
+            const SparseWeights weights = SkinningData::parse_sparse_weights_from_json(json_data);
+
+            const bool valid = weights.vertex_count() == 2 &&
+                               weights.max_influences() == 8 &&
+                               weights.offsets[1] == 8 && weights.offsets[2] == 9 &&
+                               weights.joint_ids[7] == 7 && weights.joint_ids[8] == 3 &&
+                               TestUtils::approx_equal(weights.weights[7], .2f);
+
+            TestUtils::set_console_color(
+                valid ? TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << "Parsed " << weights.joint_ids.size() << " influences for "
+                      << weights.vertex_count() << " vertices (max "
+                      << weights.max_influences() << " per vertex)\n";
+            TestUtils::reset_console_color();
+
+            return valid;
+        } 
+        catch (const std::exception& e) 
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Parsing sparse weights failed: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+
+            return false;
+        }
+    });
+    
+    // Test parsing a single palette and an array of palettes as pose sequences
+    suite.add_test("Parse Pose Sequence from JSON", []() 
+    {
+        try 
+        {
+            const Json palette = JsonFacade::parse(
+                "[[1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1],"
+                " [1,0,0,2, 0,1,0,0, 0,0,1,0, 0,0,0,1]]");
+            const Json sequence = JsonFacade::parse(
+                "[[[1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1]],"
+                " [[1,0,0,1, 0,1,0,0, 0,0,1,0, 0,0,0,1]],"
+                " [[1,0,0,2, 0,1,0,0, 0,0,1,0, 0,0,0,1]]]");
+
+            const std::vector<std::vector<HMM_Mat4>> single_pose =
+                SkinningData::parse_pose_sequence_from_json(palette);
+            const std::vector<std::vector<HMM_Mat4>> poses =
+                SkinningData::parse_pose_sequence_from_json(sequence);
+
+            const bool valid = single_pose.size() == 1 && single_pose[0].size() == 2 &&
+                               poses.size() == 3 && poses[2].size() == 1 &&
+                               TestUtils::approx_equal(poses[2][0].Elements[0][3], 2.f);
+
+            TestUtils::set_console_color(
+                valid ? TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << "Parsed " << single_pose.size() << " pose from a palette and "
+                      << poses.size() << " poses from a sequence\n";
+            TestUtils::reset_console_color();
+
+            return valid;
+        } 
+        catch (const std::exception& e) 
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Parsing pose sequence failed: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+
+            return false;
+        }
+    });
+    
+    // Test grouping a joint hierarchy by depth, and parsing local joint transforms
+    suite.add_test("Parse Skeleton and Joint Transforms from JSON", []() 
+    {
+        try 
+        {
+            // Two roots (0 and 4); joint 1 is listed before its parent 3
+            const Skeleton skeleton = SkinningData::parse_skeleton_from_json(
+                JsonFacade::parse("[-1, 3, 0, 0, -1, 1]"));
+            const std::vector<uint32_t> expected_order = { 0, 4, 2, 3, 1, 5 };
+            const std::vector<uint32_t> expected_offsets = { 0, 2, 4, 5, 6 };
+
+            bool valid = skeleton.level_order == expected_order &&
+                         skeleton.level_offsets == expected_offsets &&
+                         skeleton.level_count() == 4;
+            for (size_t position = 0; position < skeleton.joint_count(); position++)
+            {
+                const int32_t parent = skeleton.parents[skeleton.level_order[position]];
+                valid &= parent < 0 ||
+                         skeleton.level_order[skeleton.level_parents[position]] == uint32_t(parent);
+            }
+
+            // Cycles and dangling parents are rejected
+            for (const char* malformed : { "[1, 2, 0]", "[-1, 7]" })
+            {
+                try
+                {
+                    SkinningData::parse_skeleton_from_json(JsonFacade::parse(malformed));
+                    valid = false;
+                }
+                catch (const std::runtime_error&)
+                {
+                }
+            }
+
+            const std::vector<JointTransform> transforms = SkinningData::parse_joint_transforms_from_json(
+                JsonFacade::parse("[{\"translation\": [1, 2, 3], \"rotation\": [0, 0, 1, 0]},"
+                                  " {\"scale\": [2, 2, 2]}]"));
+            valid &= transforms.size() == 2 &&
+                     TestUtils::approx_equal(transforms[0].translation.Z, 3.f) &&
+                     TestUtils::approx_equal(transforms[0].rotation.Z, 1.f) &&
+                     TestUtils::approx_equal(transforms[0].scale.X, 1.f) &&
+                     TestUtils::approx_equal(transforms[1].rotation.W, 1.f) &&
+                     TestUtils::approx_equal(transforms[1].scale.Y, 2.f);
+
+            TestUtils::set_console_color(
+                valid ? TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+            std::cout << "Grouped " << skeleton.joint_count() << " joints into "
+                      << skeleton.level_count() << " levels\n";
+            TestUtils::reset_console_color();
+
+            return valid;
+        } 
+        catch (const std::exception& e) 
+        {
+            TestUtils::set_console_color(TestUtils::ConsoleColor::Red);
+            std::cout << "Parsing skeleton failed: " << e.what() << std::endl;
+            TestUtils::reset_console_color();
+
+            return false;
+        }
+    });
+    
     // Edge case: Nonexistent file
     suite.add_test("Handle Nonexistent File", []() 
     {
@@ -0,0 +1,156 @@
+// Standard library imports
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Local application imports
+#include "parallel/thread_pool.h"
+#include "test/test_framework.h"
+#include "test/test_utils.h"
+
+
+TestSuite create_thread_pool_tests()
+{
+    TestSuite suite("Thread Pool");
+
+    // Every index must be visited exactly once, in tasks no larger than the grain size
+    suite.add_test("Parallel For Covers Range Once", []()
+    {
+        ThreadPool pool(4);
+        bool valid = pool.get_thread_count() == 4;
+
+        for (const size_t grain_size : { 1, 7, 64, 5000 })
+        {
+            std::vector<std::atomic<int>> visits(1003);
+            std::atomic<bool> oversized(false);
+
+            pool.parallel_for(10, visits.size(), grain_size, [&](size_t begin, size_t end)
+            {
+                if (end - begin > grain_size)
+                    oversized = true;
+                for (size_t i = begin; i < end; i++)
+                {
+                    visits[i]++;
+                }
+            });
+
+            for (size_t i = 0; i < visits.size(); i++)
+            {
+                valid &= visits[i] == (i < 10 ? 0 : 1);
+            }
+            valid &= !oversized;
+        }
+
+        // Empty ranges must return without calling the body
+        pool.parallel_for(5, 5, 1, [&](size_t, size_t) { valid = false; });
+
+        TestUtils::set_console_color(valid ?
+            TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+        std::cout << "Ranges covered exactly once on " << pool.get_thread_count()
+                  << " threads" << std::endl;
+        TestUtils::reset_console_color();
+
+        return valid;
+    });
+
+    // Idle threads must steal from a participant stuck on slow tasks
+    suite.add_test("Work Stealing Balances Uneven Tasks", []()
+    {
+        ThreadPool pool(4);
+
+        // The first quarter of the tasks (dealt to the calling thread) are slow
+        std::mutex thread_mutex;
+        std::set<std::thread::id> slow_task_threads;
+        pool.parallel_for(0, 64, 1, [&](size_t begin, size_t)
+        {
+            if (begin < 16)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                std::lock_guard<std::mutex> lock(thread_mutex);
+                slow_task_threads.insert(std::this_thread::get_id());
+            }
+        });
+
+        const bool stolen = slow_task_threads.size() > 1;
+
+        TestUtils::set_console_color(stolen ?
+            TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+        std::cout << "Slow tasks ran on " << slow_task_threads.size() << " threads" << std::endl;
+        TestUtils::reset_console_color();
+
+        return stolen;
+    });
+
+    // Exceptions surface in the caller, and the pool stays usable afterwards
+    suite.add_test("Parallel For Propagates Exceptions", []()
+    {
+        ThreadPool pool(3);
+
+        bool caught = false;
+        try
+        {
+            pool.parallel_for(0, 100, 1, [](size_t begin, size_t)
+            {
+                if (begin == 42)
+                    throw std::runtime_error("task failed");
+            });
+        }
+        catch (const std::runtime_error&)
+        {
+            caught = true;
+        }
+
+        // Loops nested in a task run inline instead of deadlocking
+        std::atomic<size_t> total(0);
+        pool.parallel_for(0, 8, 1, [&](size_t, size_t)
+        {
+            pool.parallel_for(0, 10, 1, [&](size_t begin, size_t end) { total += end - begin; });
+        });
+
+        const bool valid = caught && total == 80;
+
+        TestUtils::set_console_color(valid ?
+            TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+        std::cout << "Exception " << (caught ? "rethrown" : "lost") << ", nested loops covered "
+                  << total << " of 80 indices" << std::endl;
+        TestUtils::reset_console_color();
+
+        return valid;
+    });
+
+    // NUMA-aware pools leave the caller idle but must still cover every index
+    suite.add_test("NUMA Mode Covers Range Once", []()
+    {
+        ThreadPool pool(3, true);
+        bool valid = pool.get_thread_count() == 3 && pool.get_node_count() >= 1;
+
+        std::vector<std::atomic<int>> visits(256);
+        pool.parallel_for(0, visits.size(), 16, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                visits[i]++;
+            }
+        });
+
+        for (size_t i = 0; i < visits.size(); i++)
+        {
+            valid &= visits[i] == 1;
+        }
+
+        TestUtils::set_console_color(valid ?
+            TestUtils::ConsoleColor::Green : TestUtils::ConsoleColor::Red);
+        std::cout << "Ranges covered exactly once on " << pool.get_thread_count()
+                  << " threads over " << pool.get_node_count() << " node(s)" << std::endl;
+        TestUtils::reset_console_color();
+
+        return valid;
+    });
+
+    return suite;
+}